@@ -0,0 +1,89 @@
+#include "ArkanoidEnv.h"
+#include "GameSettings.h"
+#include "VectorEnv.h"
+#include <memory>
+
+using namespace ArkanoidGame;
+
+// Opaque handle behind the C interface; owns the level pack the games read from
+struct ArkanoidEnv
+{
+	LevelPack levels;
+	std::unique_ptr<VectorEnv> env;
+};
+
+void ArkanoidEnvGetDefaultConfig(ArkanoidEnvConfig* config)
+{
+	if (!config)
+		return;
+
+	const VectorEnv::Settings defaults;
+	config->envCount = static_cast<uint32_t>(defaults.envCount);
+	config->threadCount = static_cast<uint32_t>(defaults.threadCount);
+	config->seed = defaults.seed;
+	config->ticksPerStep = defaults.ticksPerStep;
+	config->maxEpisodeSteps = PHYSICS_TICKS_PER_SECOND * 60 * 5 / defaults.ticksPerStep;
+	config->pointsReward = defaults.pointsReward;
+	config->lifeLostReward = defaults.lifeLostReward;
+	config->levelPackPath = nullptr;
+	config->levelIndex = -1;
+}
+
+ArkanoidEnv* ArkanoidEnvCreate(const ArkanoidEnvConfig* config)
+{
+	if (!config || config->envCount == 0)
+		return nullptr;
+
+	std::unique_ptr<ArkanoidEnv> handle = std::make_unique<ArkanoidEnv>();
+	VectorEnv::Settings settings;
+	if (config->levelPackPath)
+	{
+		if (!handle->levels.open(config->levelPackPath))
+			return nullptr;
+		if (config->levelIndex >= 0 && static_cast<size_t>(config->levelIndex) >= handle->levels.getLevelCount())
+			return nullptr;
+		settings.levels = &handle->levels;
+		settings.levelIndex = config->levelIndex;
+	}
+
+	settings.envCount = config->envCount;
+	settings.threadCount = config->threadCount;
+	settings.seed = config->seed;
+	settings.ticksPerStep = config->ticksPerStep;
+	settings.maxEpisodeSteps = config->maxEpisodeSteps;
+	settings.pointsReward = config->pointsReward;
+	settings.lifeLostReward = config->lifeLostReward;
+	handle->env = std::make_unique<VectorEnv>(settings);
+	return handle.release();
+}
+
+void ArkanoidEnvDestroy(ArkanoidEnv* env)
+{
+	delete env;
+}
+
+uint32_t ArkanoidEnvGetEnvCount(const ArkanoidEnv* env)
+{
+	return env ? static_cast<uint32_t>(env->env->getEnvCount()) : 0;
+}
+
+uint32_t ArkanoidEnvGetBrickWordCount(const ArkanoidEnv* env)
+{
+	return env ? static_cast<uint32_t>(env->env->getBrickWordCount()) : 0;
+}
+
+void ArkanoidEnvReset(ArkanoidEnv* env, float* observations, uint64_t* brickBits)
+{
+	if (env && observations)
+	{
+		env->env->reset(observations, brickBits);
+	}
+}
+
+void ArkanoidEnvStep(ArkanoidEnv* env, const uint8_t* actions, float* observations, uint64_t* brickBits, float* rewards, uint8_t* dones)
+{
+	if (env && actions && observations && rewards && dones)
+	{
+		env->env->step(actions, observations, brickBits, rewards, dones);
+	}
+}
@@ -0,0 +1,95 @@
+/*
+ * C interface to a vector of headless Arkanoid games for reinforcement learning
+ *
+ * One handle steps envCount independent games in lockstep on a thread pool.
+ * Every call writes into buffers the caller owns, laid out env after env:
+ *   observations  envCount * ARKANOID_ENV_OBSERVATION_SIZE floats
+ *   brickBits     envCount * ArkanoidEnvGetBrickWordCount() words, bit i set while brick i is alive
+ *   rewards       envCount floats
+ *   dones         envCount bytes, ARKANOID_ENV_RUNNING / TERMINATED / TRUNCATED
+ * so the buffers can be numpy arrays passed through ctypes and nothing is
+ * copied or allocated per step. An env whose episode ended starts the next
+ * one inside the same step; its observation is already the new episode's.
+ * Episode k of env i is seeded with seed + i + k * envCount, so a run is
+ * reproducible regardless of the thread count.
+ */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(ARKANOID_ENV_EXPORTS)
+#define ARKANOID_ENV_API __declspec(dllexport)
+#else
+#define ARKANOID_ENV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ArkanoidEnv ArkanoidEnv;
+
+/* Observation of one env; positions are divided by the screen size, velocities by the maximum ball speed */
+enum ArkanoidEnvObservation
+{
+	ARKANOID_OBS_BALL_X = 0,
+	ARKANOID_OBS_BALL_Y,
+	ARKANOID_OBS_BALL_VELOCITY_X,
+	ARKANOID_OBS_BALL_VELOCITY_Y,
+	ARKANOID_OBS_BALL_LAUNCHED,  /* 1 once the ball left the platform */
+	ARKANOID_OBS_PLATFORM_X,     /* Center */
+	ARKANOID_OBS_PLATFORM_WIDTH,
+	ARKANOID_OBS_LIVES,          /* Lives left, not normalized */
+	ARKANOID_ENV_OBSERVATION_SIZE
+};
+
+enum ArkanoidEnvAction
+{
+	ARKANOID_ACTION_STAY = 0,
+	ARKANOID_ACTION_LEFT,
+	ARKANOID_ACTION_RIGHT,
+	ARKANOID_ACTION_LAUNCH,
+	ARKANOID_ACTION_COUNT
+};
+
+enum ArkanoidEnvDone
+{
+	ARKANOID_ENV_RUNNING = 0,
+	ARKANOID_ENV_TERMINATED = 1, /* Won or lost */
+	ARKANOID_ENV_TRUNCATED = 2   /* Hit maxEpisodeSteps */
+};
+
+typedef struct ArkanoidEnvConfig
+{
+	uint32_t envCount;
+	uint32_t threadCount;      /* Pool workers; 0 uses one per hardware thread */
+	uint32_t seed;
+	uint32_t ticksPerStep;     /* Simulation ticks per step at 240 ticks per second; the action is held for all of them */
+	uint32_t maxEpisodeSteps;  /* 0 for no limit */
+	float pointsReward;        /* Reward per point of every destroyed brick */
+	float lifeLostReward;      /* Reward for every life lost, usually negative */
+	const char* levelPackPath; /* Compiled level pack, or NULL for the generated layout */
+	int32_t levelIndex;        /* Level of the pack, or -1 to pick one per episode from its seed */
+} ArkanoidEnvConfig;
+
+/* Fills config with the defaults: 1 env, all cores, 4 ticks per step, 5 minute episodes, generated layout */
+ARKANOID_ENV_API void ArkanoidEnvGetDefaultConfig(ArkanoidEnvConfig* config);
+
+/* Returns NULL when the config is invalid or the level pack cannot be opened */
+ARKANOID_ENV_API ArkanoidEnv* ArkanoidEnvCreate(const ArkanoidEnvConfig* config);
+ARKANOID_ENV_API void ArkanoidEnvDestroy(ArkanoidEnv* env);
+
+ARKANOID_ENV_API uint32_t ArkanoidEnvGetEnvCount(const ArkanoidEnv* env);
+
+/* 64-bit words of brick bits per env; the largest layout the env can load decides it */
+ARKANOID_ENV_API uint32_t ArkanoidEnvGetBrickWordCount(const ArkanoidEnv* env);
+
+/* Starts episode 0 of every env; brickBits may be NULL */
+ARKANOID_ENV_API void ArkanoidEnvReset(ArkanoidEnv* env, float* observations, uint64_t* brickBits);
+
+/* Applies one ArkanoidEnvAction per env; brickBits may be NULL */
+ARKANOID_ENV_API void ArkanoidEnvStep(ArkanoidEnv* env, const uint8_t* actions, float* observations, uint64_t* brickBits, float* rewards, uint8_t* dones);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,174 @@
+#include "VectorEnv.h"
+#include "GameSettings.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ArkanoidGame
+{
+	VectorEnv::VectorEnv(const Settings& envSettings)
+		: settings(envSettings), pool(envSettings.threadCount)
+	{
+		settings.ticksPerStep = std::max<uint32_t>(1, settings.ticksPerStep);
+		if (settings.levels && settings.levels->getLevelCount() == 0)
+		{
+			settings.levels = nullptr;
+		}
+
+		// Bit buffers are sized for the largest layout any episode can get
+		size_t maxBricks = static_cast<size_t>(BLOCK_ROWS * BLOCKS_PER_ROW);
+		if (settings.levels)
+		{
+			maxBricks = 0;
+			for (size_t level = 0; level < settings.levels->getLevelCount(); ++level)
+			{
+				if (settings.levelIndex < 0 || level == static_cast<size_t>(settings.levelIndex))
+				{
+					maxBricks = std::max(maxBricks, settings.levels->getLevel(level).bricks.count);
+				}
+			}
+		}
+		brickWordCount = (maxBricks + 63) / 64;
+
+		sims.reserve(settings.envCount);
+		for (size_t i = 0; i < settings.envCount; ++i)
+		{
+			sims.push_back(std::make_unique<ArkanoidSim>(settings.seed));
+		}
+		episodeCounts.assign(settings.envCount, 0);
+		episodeSteps.assign(settings.envCount, 0);
+	}
+
+	void VectorEnv::reset(float* observations, uint64_t* brickBits)
+	{
+		std::fill(episodeCounts.begin(), episodeCounts.end(), 0);
+		pool.parallelFor(sims.size(), getGrainSize(), [this, observations, brickBits](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				startEpisode(i);
+				writeObservation(i, observations, brickBits);
+			}
+		});
+	}
+
+	void VectorEnv::step(const uint8_t* actions, float* observations, uint64_t* brickBits, float* rewards, uint8_t* dones)
+	{
+		buffers.actions = actions;
+		buffers.observations = observations;
+		buffers.brickBits = brickBits;
+		buffers.rewards = rewards;
+		buffers.dones = dones;
+		pool.parallelFor(sims.size(), getGrainSize(), [this](size_t begin, size_t end) { stepRange(begin, end); });
+	}
+
+	void VectorEnv::startEpisode(size_t index)
+	{
+		// Seeds depend only on the env and episode, never on which thread ran them
+		const unsigned int seed = settings.seed + static_cast<unsigned int>(index + episodeCounts[index] * sims.size());
+		++episodeCounts[index];
+		episodeSteps[index] = 0;
+
+		if (settings.levels)
+		{
+			const size_t level = settings.levelIndex >= 0 ? static_cast<size_t>(settings.levelIndex) : seed % settings.levels->getLevelCount();
+			sims[index]->reset(seed, settings.levels->getLevel(level));
+		}
+		else
+		{
+			sims[index]->reset(seed);
+		}
+	}
+
+	void VectorEnv::stepRange(size_t begin, size_t end)
+	{
+		const float timeDelta = 1.0f / PHYSICS_TICKS_PER_SECOND;
+		for (size_t i = begin; i < end; ++i)
+		{
+			ArkanoidSim& sim = *sims[i];
+			SimInput input;
+			switch (buffers.actions[i])
+			{
+			case ARKANOID_ACTION_LEFT:
+				input.moveLeft = true;
+				break;
+			case ARKANOID_ACTION_RIGHT:
+				input.moveRight = true;
+				break;
+			case ARKANOID_ACTION_LAUNCH:
+				input.launch = true;
+				break;
+			default:
+				break;
+			}
+
+			// Rewards come from the events of every tick the action is held for
+			float reward = 0.0f;
+			for (uint32_t tick = 0; tick < settings.ticksPerStep && sim.getStatus() == SimStatus::Running; ++tick)
+			{
+				sim.step(input, timeDelta);
+				for (const SimEvent& event : sim.getEvents())
+				{
+					if (event.type == SimEventType::BrickDestroyed)
+					{
+						reward += static_cast<float>(event.value) * settings.pointsReward;
+					}
+					else if (event.type == SimEventType::LifeLost)
+					{
+						reward += settings.lifeLostReward;
+					}
+				}
+			}
+			buffers.rewards[i] = reward;
+
+			uint8_t done = ARKANOID_ENV_RUNNING;
+			if (sim.getStatus() != SimStatus::Running)
+			{
+				done = ARKANOID_ENV_TERMINATED;
+			}
+			else if (settings.maxEpisodeSteps > 0 && ++episodeSteps[i] >= settings.maxEpisodeSteps)
+			{
+				done = ARKANOID_ENV_TRUNCATED;
+			}
+			buffers.dones[i] = done;
+
+			if (done != ARKANOID_ENV_RUNNING)
+			{
+				startEpisode(i);
+			}
+			writeObservation(i, buffers.observations, buffers.brickBits);
+		}
+	}
+
+	void VectorEnv::writeObservation(size_t index, float* observations, uint64_t* brickBits) const
+	{
+		const ArkanoidSim& sim = *sims[index];
+		const Ball& ball = sim.getBall();
+		const Platform& platform = sim.getPlatform();
+
+		float* observation = observations + index * ARKANOID_ENV_OBSERVATION_SIZE;
+		observation[ARKANOID_OBS_BALL_X] = ball.getPosition().x / SCREEN_WIDTH;
+		observation[ARKANOID_OBS_BALL_Y] = ball.getPosition().y / SCREEN_HEIGHT;
+		observation[ARKANOID_OBS_BALL_VELOCITY_X] = ball.getVelocity().x / BALL_MAX_SPEED;
+		observation[ARKANOID_OBS_BALL_VELOCITY_Y] = ball.getVelocity().y / BALL_MAX_SPEED;
+		observation[ARKANOID_OBS_BALL_LAUNCHED] = ball.getIsLaunched() ? 1.0f : 0.0f;
+		observation[ARKANOID_OBS_PLATFORM_X] = platform.getPosition().x / SCREEN_WIDTH;
+		observation[ARKANOID_OBS_PLATFORM_WIDTH] = platform.getWidth() / SCREEN_WIDTH;
+		observation[ARKANOID_OBS_LIVES] = static_cast<float>(sim.getLives());
+
+		if (brickBits)
+		{
+			// The alive bitset already has the output layout; copy it and clear the unused tail
+			uint64_t* words = brickBits + index * brickWordCount;
+			const BrickField& bricks = sim.getBricks();
+			const size_t wordCount = std::min(brickWordCount, bricks.getAliveWordCount());
+			std::memcpy(words, bricks.getAliveBitsData(), wordCount * sizeof(uint64_t));
+			std::fill(words + wordCount, words + brickWordCount, 0);
+		}
+	}
+
+	size_t VectorEnv::getGrainSize() const
+	{
+		// A few chunks per thread, so work stealing can even out games of different cost
+		const size_t chunkCount = (pool.getThreadCount() + 1) * 4;
+		return std::max<size_t>(1, (sims.size() + chunkCount - 1) / chunkCount);
+	}
+}
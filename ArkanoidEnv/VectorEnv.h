@@ -0,0 +1,69 @@
+#pragma once
+#include "ArkanoidEnv.h"
+#include "ArkanoidSim.h"
+#include "LevelPack.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Many ArkanoidSim games stepped in lockstep for reinforcement learning
+	 * 
+	 * Backs the C interface in ArkanoidEnv.h, which documents the buffer layout.
+	 * Each step splits the games into chunks for the thread pool; a chunk steps its
+	 * games and writes their observations, rewards and done flags straight into
+	 * the caller's buffers. The games reuse their own storage across episodes.
+	 */
+	class VectorEnv
+	{
+	public:
+		struct Settings
+		{
+			size_t envCount = 1;
+			size_t threadCount = 0;
+			unsigned int seed = 1;
+			uint32_t ticksPerStep = 4;
+			uint32_t maxEpisodeSteps = 0;
+			float pointsReward = 0.01f;
+			float lifeLostReward = -1.0f;
+			const LevelPack* levels = nullptr; // Not owned; nullptr or empty for the generated layout
+			int levelIndex = -1;
+		};
+
+		explicit VectorEnv(const Settings& envSettings);
+
+		size_t getEnvCount() const { return sims.size(); }
+		size_t getBrickWordCount() const { return brickWordCount; }
+		const ArkanoidSim& getSim(size_t index) const { return *sims[index]; }
+
+		void reset(float* observations, uint64_t* brickBits);
+		void step(const uint8_t* actions, float* observations, uint64_t* brickBits, float* rewards, uint8_t* dones);
+
+	private:
+		// Caller buffers of the running step, so the pool tasks capture only this
+		struct StepBuffers
+		{
+			const uint8_t* actions = nullptr;
+			float* observations = nullptr;
+			uint64_t* brickBits = nullptr;
+			float* rewards = nullptr;
+			uint8_t* dones = nullptr;
+		};
+
+		void startEpisode(size_t index);
+		void stepRange(size_t begin, size_t end);
+		void writeObservation(size_t index, float* observations, uint64_t* brickBits) const;
+		size_t getGrainSize() const;
+
+		Settings settings;
+		ThreadPool pool;
+		std::vector<std::unique_ptr<ArkanoidSim>> sims;
+		std::vector<uint32_t> episodeCounts;
+		std::vector<uint32_t> episodeSteps;
+		size_t brickWordCount = 0;
+		StepBuffers buffers;
+	};
+}
@@ -1,6 +1,7 @@
 #include "Application.h"
 #include "GameSettings.h"
-#include <cstdlib>
+#include "Profiler.h"
+#include <algorithm>
 
 namespace ArkanoidGame
 {
@@ -13,20 +14,37 @@ namespace ArkanoidGame
 	Application::Application() :
 		window(sf::VideoMode(static_cast<unsigned int>(SCREEN_WIDTH), static_cast<unsigned int>(SCREEN_HEIGHT)), GAME_NAME)
 	{
-		// Init random number generator
-		unsigned int seed = (unsigned int)time(nullptr); // Get current time as seed. You can also use any other number to fix randomization
-		srand(seed);
+		// Pace frames with the display instead of sleeping
+		if (IS_VSYNC_ENABLED)
+		{
+			window.setVerticalSyncEnabled(true);
+		}
+		else
+		{
+			window.setFramerateLimit(static_cast<unsigned int>(1.0f / TIME_PER_FRAME));
+		}
+	}
+
+	void Application::SetPhysicsRate(int ticksPerSecond)
+	{
+		const int rate = std::max(1, ticksPerSecond);
+		physicsTimeStep = 1.0f / static_cast<float>(rate);
+		game.SetPhysicsRate(rate); // States size their per-tick buffers from it
 	}
 
 	void Application::Run()
 	{
 		// Init game clock
-		sf::Clock gameClock;
+		sf::Clock frameClock;
+		float accumulator = 0.0f;
 
 		// Game loop
 		while (window.isOpen()) {
 
-			float startTime = gameClock.getElapsedTime().asSeconds();
+			Profiler::Instance().BeginFrame();
+
+			// Wall time since the last frame feeds fixed-size simulation ticks
+			accumulator += std::min(frameClock.restart().asSeconds(), MAX_FRAME_TIME);
 
 			game.HandleWindowEvents(window);
 
@@ -34,27 +52,31 @@ namespace ArkanoidGame
 				break;
 			}
 
-			if (game.Update(TIME_PER_FRAME))
+			// Run as many ticks as fit; the remainder carries over to the next frame
+			bool isRunning = true;
+			while (accumulator >= physicsTimeStep && isRunning)
 			{
-				// Draw everything here
-				// Clear the window first
-				window.clear();
-
-				game.Draw(window);
-
-				// End the current frame, display window contents on screen
-				window.display();
+				isRunning = game.Update(physicsTimeStep);
+				accumulator -= physicsTimeStep;
 			}
-			else
+
+			if (!isRunning)
 			{
 				window.close();
+				break;
 			}
 
-			float endTime = gameClock.getElapsedTime().asSeconds();
-			float deltaTime = endTime - startTime;
-			if (deltaTime < TIME_PER_FRAME) {
-				// Reduce framerate to not spam CPU and GPU
-				sf::sleep(sf::seconds(TIME_PER_FRAME - deltaTime));
+			// Draw everything here
+			// Clear the window first
+			window.clear();
+
+			// Moving objects are drawn between the last two ticks, by the fraction of a tick still pending
+			game.Draw(window, accumulator / physicsTimeStep);
+
+			// End the current frame, display window contents on screen
+			{
+				PROFILE_ZONE("Application::Display"); // Includes the vsync wait
+				window.display();
 			}
 		}
 	}
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "Game.h"
+#include "GameSettings.h"
 
 namespace ArkanoidGame {
 	
@@ -14,6 +15,9 @@ namespace ArkanoidGame {
 
 		void Run();
 
+		// Simulation ticks per second; rendering runs at the display rate and interpolates between ticks
+		void SetPhysicsRate(int ticksPerSecond);
+
 		Game& GetGame() { return game; }
 
 	private:
@@ -23,6 +27,7 @@ namespace ArkanoidGame {
 	private:
 		Game game;
 		sf::RenderWindow window;
+		float physicsTimeStep = 1.0f / PHYSICS_TICKS_PER_SECOND;
 	};
 
 }
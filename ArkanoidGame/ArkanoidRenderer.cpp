@@ -0,0 +1,122 @@
+#include "ArkanoidRenderer.h"
+#include "GameSettings.h"
+#include <cmath>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		sf::Vector2f Lerp(const sf::Vector2f& from, const sf::Vector2f& to, float t)
+		{
+			return from + (to - from) * t;
+		}
+	}
+
+	ArkanoidRenderer::ArkanoidRenderer()
+	{
+		platformShape.setSize(sf::Vector2f(PLATFORM_WIDTH, PLATFORM_HEIGHT));
+		platformShape.setOrigin(PLATFORM_WIDTH / 2, PLATFORM_HEIGHT / 2);
+
+		ballShape.setRadius(BALL_RADIUS);
+		ballShape.setOrigin(BALL_RADIUS, BALL_RADIUS);
+
+		bonusVertices.setPrimitiveType(sf::Triangles);
+		extraBallVertices.setPrimitiveType(sf::Triangles);
+
+		// Unit circle shared by all bonuses
+		for (int segment = 0; segment < BONUS_SEGMENTS; ++segment)
+		{
+			const float angle = 2.0f * 3.14159265f * segment / BONUS_SEGMENTS;
+			bonusCircle[segment] = sf::Vector2f(std::cos(angle), std::sin(angle));
+		}
+		for (int segment = 0; segment < EXTRA_BALL_SEGMENTS; ++segment)
+		{
+			const float angle = 2.0f * 3.14159265f * segment / EXTRA_BALL_SEGMENTS;
+			extraBallCircle[segment] = sf::Vector2f(std::cos(angle), std::sin(angle));
+		}
+	}
+
+	void ArkanoidRenderer::draw(sf::RenderWindow& window, const ArkanoidSim& sim, float interpolation)
+	{
+		brickRenderer.draw(window, sim.getBricks());
+
+		// Draw platform
+		const Platform& platform = sim.getPlatform();
+		platformShape.setSize(sf::Vector2f(platform.getWidth(), platform.getHeight()));
+		platformShape.setOrigin(platform.getWidth() / 2, platform.getHeight() / 2);
+		platformShape.setPosition(Lerp(sim.getPreviousPlatformPosition(), platform.getPosition(), interpolation));
+		platformShape.setFillColor(platform.getHasVisualEffect() ? sf::Color::Magenta : sf::Color::Blue);
+		window.draw(platformShape);
+
+		// Draw ball
+		const Ball& ball = sim.getBall();
+		ballShape.setPosition(Lerp(sim.getPreviousBallPosition(), ball.getPosition(), interpolation));
+		const sf::Color ballColor = ball.getHasVisualEffect() ? sf::Color::Yellow : sf::Color::White;
+		ballShape.setFillColor(ballColor);
+		window.draw(ballShape);
+
+		if (!sim.getExtraBalls().empty())
+		{
+			drawExtraBalls(window, sim.getExtraBalls(), ball.getRadius(), interpolation, ballColor);
+		}
+
+		// Draw bonuses
+		drawBonuses(window, sim.getBonusManager());
+	}
+
+	void ArkanoidRenderer::drawBonuses(sf::RenderWindow& window, const BonusManager& bonusManager)
+	{
+		// Each bonus is a white ring around a yellow disc, as triangles
+		bonusVertices.clear();
+		for (const Bonus& bonus : bonusManager.getActiveBonuses())
+		{
+			if (!bonus.getIsActive() || bonus.getIsCollected())
+				continue;
+
+			const sf::Vector2f center = bonus.getPosition();
+			for (int segment = 0; segment < BONUS_SEGMENTS; ++segment)
+			{
+				const sf::Vector2f& from = bonusCircle[segment];
+				const sf::Vector2f& to = bonusCircle[(segment + 1) % BONUS_SEGMENTS];
+
+				const sf::Vector2f innerFrom = center + from * BONUS_RADIUS;
+				const sf::Vector2f innerTo = center + to * BONUS_RADIUS;
+				const sf::Vector2f outerFrom = center + from * (BONUS_RADIUS + BONUS_OUTLINE_THICKNESS);
+				const sf::Vector2f outerTo = center + to * (BONUS_RADIUS + BONUS_OUTLINE_THICKNESS);
+
+				bonusVertices.append(sf::Vertex(center, sf::Color::Yellow));
+				bonusVertices.append(sf::Vertex(innerFrom, sf::Color::Yellow));
+				bonusVertices.append(sf::Vertex(innerTo, sf::Color::Yellow));
+
+				bonusVertices.append(sf::Vertex(innerFrom, sf::Color::White));
+				bonusVertices.append(sf::Vertex(outerFrom, sf::Color::White));
+				bonusVertices.append(sf::Vertex(outerTo, sf::Color::White));
+				bonusVertices.append(sf::Vertex(innerFrom, sf::Color::White));
+				bonusVertices.append(sf::Vertex(outerTo, sf::Color::White));
+				bonusVertices.append(sf::Vertex(innerTo, sf::Color::White));
+			}
+		}
+
+		if (bonusVertices.getVertexCount() > 0)
+		{
+			window.draw(bonusVertices);
+		}
+	}
+
+	void ArkanoidRenderer::drawExtraBalls(sf::RenderWindow& window, const BallArray& balls, float radius, float interpolation, const sf::Color& color)
+	{
+		// One triangle fan per ball, all in a single draw call
+		extraBallVertices.clear();
+		for (size_t i = 0; i < balls.size(); ++i)
+		{
+			const sf::Vector2f center = Lerp(balls.getPreviousPosition(i), balls.getPosition(i), interpolation);
+			for (int segment = 0; segment < EXTRA_BALL_SEGMENTS; ++segment)
+			{
+				extraBallVertices.append(sf::Vertex(center, color));
+				extraBallVertices.append(sf::Vertex(center + extraBallCircle[segment] * radius, color));
+				extraBallVertices.append(sf::Vertex(center + extraBallCircle[(segment + 1) % EXTRA_BALL_SEGMENTS] * radius, color));
+			}
+		}
+		window.draw(extraBallVertices);
+	}
+}
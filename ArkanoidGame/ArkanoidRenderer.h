@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "ArkanoidSim.h"
+#include "BrickBatchRenderer.h"
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Draws an ArkanoidSim with SFML
+	 * 
+	 * Keeps all shapes and colors of the playing field, so the simulation
+	 * objects themselves stay free of rendering state. Bricks and bonuses are
+	 * batched into one vertex array each, so the number of draw calls does not
+	 * grow with the level. Multiball balls are batched the same way.
+	 */
+	class ArkanoidRenderer
+	{
+	private:
+		sf::RectangleShape platformShape;
+		sf::CircleShape ballShape;
+		BrickBatchRenderer brickRenderer;
+		sf::VertexArray bonusVertices; // All falling bonuses, rebuilt every frame
+		sf::VertexArray extraBallVertices; // All multiball balls, rebuilt every frame
+
+		static const int BONUS_SEGMENTS = 24;
+		static constexpr float BONUS_OUTLINE_THICKNESS = 2.0f;
+		sf::Vector2f bonusCircle[BONUS_SEGMENTS];
+
+		static const int EXTRA_BALL_SEGMENTS = 12; // Coarser than the main ball, there can be thousands
+		sf::Vector2f extraBallCircle[EXTRA_BALL_SEGMENTS];
+
+	public:
+		ArkanoidRenderer();
+
+		// interpolation blends the platform and ball from their previous to current step position (0..1)
+		void draw(sf::RenderWindow& window, const ArkanoidSim& sim, float interpolation = 1.0f);
+
+	private:
+		void drawBonuses(sf::RenderWindow& window, const BonusManager& bonusManager);
+		void drawExtraBalls(sf::RenderWindow& window, const BallArray& balls, float radius, float interpolation, const sf::Color& color);
+	};
+}
@@ -0,0 +1,576 @@
+#include "ArkanoidSim.h"
+#include "GameSettings.h"
+#include "Profiler.h"
+#include "SweptCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	ArkanoidSim::ArkanoidSim(unsigned int seed)
+		: platform(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 50, PLATFORM_WIDTH, PLATFORM_HEIGHT, PLATFORM_SPEED),
+		  ball(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 80, BALL_RADIUS, BALL_SPEED),
+		  extraBalls(MAX_EXTRA_BALLS)
+	{
+		reset(seed);
+	}
+
+	void ArkanoidSim::reset(unsigned int newSeed, const LevelView& level)
+	{
+		// Drop effects first so they restore the objects they modified
+		bonusManager.reset();
+		seed = newSeed;
+		random.setSeed(seed);
+
+		platform = Platform(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 50, PLATFORM_WIDTH, PLATFORM_HEIGHT, PLATFORM_SPEED);
+		ball = Ball(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 80, BALL_RADIUS, BALL_SPEED);
+		extraBalls.clear();
+		extraBallSpeed = BALL_SPEED;
+		score = 0;
+		lives = 3;
+		status = SimStatus::Running;
+		events.clear();
+
+		initializeBlocks(level);
+
+		previousPlatformPosition = platform.getPosition();
+		previousBallPosition = ball.getPosition();
+	}
+
+	void ArkanoidSim::initializeBlocks(const LevelView& level)
+	{
+		if (level.isValid())
+		{
+			// Designed level: the columns are copied as they are in the pack
+			bricks.assign(level.bricks);
+			bricks.buildIndex(level.cellWidth, level.cellHeight);
+			return;
+		}
+
+		bricks.clear();
+		
+		// Grid setup - keep the grid structure but randomize within each cell
+		const float startX = 50.0f;
+		const float startY = 100.0f;
+		const float cellWidth = BLOCK_WIDTH + BLOCK_SPACING;
+		const float cellHeight = BLOCK_HEIGHT + BLOCK_SPACING;
+		
+		// Smaller random offset for more even grid
+		const float maxOffsetX = BLOCK_SPACING * 0.15f; // 15% of spacing for more even look
+		const float maxOffsetY = BLOCK_SPACING * 0.15f;
+		
+		const int totalBlocks = BLOCK_ROWS * BLOCKS_PER_ROW;
+		bricks.reserve(totalBlocks);
+
+		struct BrickLayout
+		{
+			float x;
+			float y;
+			int colorIndex;
+			int points;
+		};
+		std::vector<BrickLayout> layout(totalBlocks);
+		
+		// Lay out all blocks with perfect grid positions
+		for (int i = 0; i < totalBlocks; ++i)
+		{
+			int row = i / BLOCKS_PER_ROW;
+			int col = i % BLOCKS_PER_ROW;
+			
+			// Perfect grid position
+			float x = startX + col * cellWidth;
+			float y = startY + row * cellHeight;
+			
+			// Add small random offset
+			x += random.uniformFloat(-maxOffsetX, maxOffsetX);
+			y += random.uniformFloat(-maxOffsetY, maxOffsetY);
+			
+			// Ensure blocks stay within screen bounds
+			x = std::max(0.0f, std::min(x, SCREEN_WIDTH - BLOCK_WIDTH));
+			y = std::max(0.0f, std::min(y, SCREEN_HEIGHT - 200.0f - BLOCK_HEIGHT));
+			
+			// Random color for each block
+			int colorIndex = random.uniformInt(0, BLOCK_COLOR_COUNT - 1);
+			
+			// Random points (10-30)
+			int points = random.uniformInt(10, 30);
+			
+			layout[i] = { x, y, colorIndex, points };
+		}
+		
+		// Now randomize block types - convert some to special types
+		for (const BrickLayout& brick : layout)
+		{
+			int blockType = random.uniformInt(0, 9);
+			
+			if (blockType < 2) // 20% chance for DurableBricks
+			{
+				bricks.add(brick.x, brick.y, BLOCK_WIDTH, BLOCK_HEIGHT, BlockType::Durable, brick.points, brick.colorIndex, 3);
+			}
+			else if (blockType < 4) // 20% chance for GlassBricks
+			{
+				bricks.add(brick.x, brick.y, BLOCK_WIDTH, BLOCK_HEIGHT, BlockType::Glass, brick.points, brick.colorIndex);
+			}
+			else // 60% remain as regular blocks with their random colors
+			{
+				bricks.add(brick.x, brick.y, BLOCK_WIDTH, BLOCK_HEIGHT, BlockType::Regular, brick.points, brick.colorIndex);
+			}
+		}
+
+		bricks.buildIndex(BLOCK_WIDTH, BLOCK_HEIGHT);
+	}
+
+	void ArkanoidSim::step(const SimInput& input, float timeDelta)
+	{
+		PROFILE_ZONE("Sim::step");
+
+		events.clear();
+
+		if (status != SimStatus::Running)
+			return;
+
+		previousPlatformPosition = platform.getPosition();
+		previousBallPosition = ball.getPosition();
+		extraBalls.savePreviousPositions();
+
+		applyInput(input);
+		
+		// Update game objects
+		platform.update(timeDelta);
+		
+		// Make ball follow platform when not launched
+		if (!ball.getIsLaunched())
+		{
+			ball.followPlatform(platform.getPosition(), platform.getWidth());
+		}
+		
+		moveBall(timeDelta);
+		
+		// Update bonuses
+		{
+			PROFILE_ZONE("Sim::updateBonuses");
+			const size_t firstBonusEvent = events.size();
+			bonusManager.updateBonuses(timeDelta, platform, ball, events);
+			applyBonusEvents(firstBonusEvent);
+			syncExtraBallSpeed();
+		}
+		
+		// Check collisions
+		checkCollisions();
+	}
+
+	void ArkanoidSim::applyInput(const SimInput& input)
+	{
+		// Platform movement
+		platform.setMovingLeft(input.moveLeft);
+		platform.setMovingRight(input.moveRight);
+
+		// Ball aiming and launch
+		if (!ball.getIsLaunched())
+		{
+			if (input.aimLeft)
+			{
+				ball.setAimDirection(-1.0f); // Aim left
+			}
+			else if (input.aimRight)
+			{
+				ball.setAimDirection(1.0f); // Aim right
+			}
+			else
+			{
+				ball.setAimDirection(0.0f); // Aim straight
+			}
+
+			if (input.launch)
+			{
+				ball.launch();
+			}
+		}
+	}
+
+	void ArkanoidSim::moveBall(float timeDelta)
+	{
+		PROFILE_ZONE("Sim::moveBall"); // Physics, including the swept collision queries
+		if (ball.getIsLaunched())
+		{
+			sf::Vector2f position = ball.getPosition();
+			sf::Vector2f velocity = ball.getVelocity();
+			sweepBall(position, velocity, timeDelta);
+			ball.setPosition(position.x, position.y);
+			ball.setVelocity(velocity.x, velocity.y);
+			ball.limitSpeed();
+		}
+
+		if (!extraBalls.empty())
+		{
+			moveExtraBalls(timeDelta);
+		}
+	}
+
+	void ArkanoidSim::moveExtraBalls(float timeDelta)
+	{
+		PROFILE_ZONE("Sim::moveExtraBalls");
+		const float radius = ball.getRadius();
+		const sf::FloatRect platformBounds = platform.getBounds();
+		contactBalls.reserve(MAX_EXTRA_BALLS); // Only allocates the first time
+
+		// Most balls touch nothing this step and are moved four at a time
+		extraBalls.moveFreeBalls(timeDelta, radius, SCREEN_WIDTH, platformBounds, bricks.getLayoutBounds(), contactBalls);
+
+		// The rest take the same exact sweep as the main ball
+		for (uint32_t index : contactBalls)
+		{
+			sf::Vector2f position = extraBalls.getPosition(index);
+			sf::Vector2f velocity = extraBalls.getVelocity(index);
+			sweepBall(position, velocity, timeDelta);
+
+			// Catch the platform moving sideways into the ball, like checkCollisions does for the main ball
+			PushOffPlatform(position, velocity, radius, ball.getSpeed(), platformBounds);
+
+			if (!ball.getIsBonusSpeedActive())
+			{
+				velocity = ClampSpeed(velocity, BALL_MAX_SPEED);
+			}
+			extraBalls.setPosition(index, position);
+			extraBalls.setVelocity(index, velocity);
+		}
+	}
+
+	void ArkanoidSim::sweepBall(sf::Vector2f& position, sf::Vector2f& velocity, float timeDelta)
+	{
+		enum class Surface { None, Wall, Platform, Brick };
+
+		const float radius = ball.getRadius();
+		const sf::FloatRect platformBounds = platform.getBounds();
+		float remainingTime = timeDelta;
+
+		// Move impact by impact, so fast balls and long steps cannot tunnel through anything
+		for (int impact = 0; impact < BALL_MAX_IMPACTS_PER_STEP && remainingTime > 0.0f; ++impact)
+		{
+			const sf::Vector2f start = position;
+			const sf::Vector2f displacement = velocity * remainingTime;
+
+			Surface surface = Surface::None;
+			float time = 1.0f;
+			sf::Vector2f normal;
+			int brickIndex = -1;
+
+			// Side and top walls are planes one radius in from the screen edge
+			auto considerWall = [&](float startCoord, float delta, float plane, const sf::Vector2f& wallNormal) {
+				const float wallTime = std::max(0.0f, (plane - startCoord) / delta);
+				if (wallTime <= time)
+				{
+					surface = Surface::Wall;
+					time = wallTime;
+					normal = wallNormal;
+				}
+			};
+			if (displacement.x < 0.0f) considerWall(start.x, displacement.x, radius, sf::Vector2f(1.0f, 0.0f));
+			if (displacement.x > 0.0f) considerWall(start.x, displacement.x, SCREEN_WIDTH - radius, sf::Vector2f(-1.0f, 0.0f));
+			if (displacement.y < 0.0f) considerWall(start.y, displacement.y, radius, sf::Vector2f(0.0f, 1.0f));
+
+			float candidateTime;
+			sf::Vector2f candidateNormal;
+			if (SweepCircleRect(start, radius, displacement, platformBounds, candidateTime, candidateNormal) && candidateTime < time)
+			{
+				surface = Surface::Platform;
+				time = candidateTime;
+				normal = candidateNormal;
+			}
+
+			const int candidateBrick = bricks.findFirstImpact(start, radius, displacement, candidateTime, candidateNormal);
+			if (candidateBrick >= 0 && candidateTime < time)
+			{
+				surface = Surface::Brick;
+				time = candidateTime;
+				normal = candidateNormal;
+				brickIndex = candidateBrick;
+			}
+
+			if (surface == Surface::None)
+			{
+				position += velocity * remainingTime;
+				break;
+			}
+
+			position += velocity * (remainingTime * time);
+			remainingTime -= remainingTime * time;
+
+			switch (surface)
+			{
+			case Surface::Wall:
+				velocity = Reflect(velocity, normal);
+				break;
+			case Surface::Platform:
+				// The top face and upper corners steer the ball, the sides just deflect it
+				if (normal.y < 0.0f)
+					velocity = GetPlatformBounceVelocity(position, velocity, ball.getSpeed(), platformBounds);
+				else
+					velocity = Reflect(velocity, normal);
+				break;
+			case Surface::Brick:
+				// Glass bricks break without deflecting the ball, which carries on through
+				if (onBrickImpact(brickIndex))
+					velocity = Reflect(velocity, normal);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	bool ArkanoidSim::onBrickImpact(int index)
+	{
+		sf::FloatRect blockBounds = bricks.getBounds(index);
+		BrickHitResult hit = bricks.hit(index);
+		
+		events.push(SimEventType::BrickHit, index);
+
+		// Add points if block was destroyed
+		if (hit.isDestroyed)
+		{
+			const int points = bricks.getPoints(index);
+			score += points;
+			events.push(SimEventType::BrickDestroyed, index, points);
+			events.push(SimEventType::ScoreChanged, 0, score);
+			
+			// Create bonus at block position (10% chance)
+			bonusManager.createBonusFromBlock(blockBounds.left + blockBounds.width / 2, blockBounds.top + blockBounds.height / 2, random, events);
+		}
+		
+		return hit.shouldBounce;
+	}
+
+	void ArkanoidSim::applyBonusEvents(size_t firstEvent)
+	{
+		// Bonuses that change the game rather than the platform or ball, in collection order.
+		// Indices, not iterators: the events pushed here may grow the queue.
+		const size_t lastEvent = events.size();
+		for (size_t i = firstEvent; i < lastEvent; ++i)
+		{
+			const SimEvent event = events[i];
+			if (event.type != SimEventType::BonusCollected)
+				continue;
+
+			switch (static_cast<BonusEffectType>(event.index))
+			{
+			case BonusEffectType::ExtraLife:
+				lives += event.value;
+				events.push(SimEventType::LifeGained, 0, lives);
+				break;
+			case BonusEffectType::Points:
+				score += event.value;
+				events.push(SimEventType::ScoreChanged, 0, score);
+				break;
+			case BonusEffectType::SplitBall:
+				splitBalls(event.value);
+				events.push(SimEventType::BallsSplit, 0, static_cast<int32_t>(getBallCount()));
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void ArkanoidSim::splitBalls(int newBallsPerBall)
+	{
+		// A ball still waiting on the platform splits as if launched straight up
+		const sf::Vector2f mainVelocity = ball.getIsLaunched() ? ball.getVelocity() : sf::Vector2f(0.0f, -ball.getSpeed());
+		const size_t existingCount = extraBalls.size();
+
+		spawnSplitBalls(ball.getPosition(), mainVelocity, newBallsPerBall);
+		for (size_t i = 0; i < existingCount; ++i)
+		{
+			spawnSplitBalls(extraBalls.getPosition(i), extraBalls.getVelocity(i), newBallsPerBall);
+		}
+	}
+
+	void ArkanoidSim::spawnSplitBalls(const sf::Vector2f& position, const sf::Vector2f& velocity, int newBallsPerBall)
+	{
+		// Alternate sides: +1, -1, +2, -2 ... split angles away from the parent direction
+		for (int i = 0; i < newBallsPerBall; ++i)
+		{
+			const float angle = BALL_SPLIT_ANGLE * static_cast<float>(i / 2 + 1) * (i % 2 == 0 ? 1.0f : -1.0f);
+			const float cosAngle = std::cos(angle);
+			const float sinAngle = std::sin(angle);
+			const sf::Vector2f rotated(velocity.x * cosAngle - velocity.y * sinAngle, velocity.x * sinAngle + velocity.y * cosAngle);
+			if (!extraBalls.add(position, rotated))
+			{
+				return; // Full: the split stops here
+			}
+		}
+	}
+
+	void ArkanoidSim::syncExtraBallSpeed()
+	{
+		// Speed effects change the main ball; the extra balls follow in proportion
+		if (ball.getSpeed() != extraBallSpeed)
+		{
+			extraBalls.scaleVelocities(ball.getSpeed() / extraBallSpeed);
+			extraBallSpeed = ball.getSpeed();
+		}
+	}
+
+	void ArkanoidSim::removeLostExtraBalls()
+	{
+		// Walk backwards, since removing moves the last ball into the freed slot
+		for (size_t i = extraBalls.size(); i-- > 0;)
+		{
+			if (extraBalls.getPosition(i).y > SCREEN_HEIGHT)
+			{
+				extraBalls.remove(i);
+			}
+		}
+	}
+
+	void ArkanoidSim::checkCollisions()
+	{
+		PROFILE_ZONE("Sim::checkCollisions");
+		// Catch the platform moving sideways into the ball, which the sweep does not see. Extra balls get the
+		// same push in moveExtraBalls: every ball that can touch the platform takes the exact pass there, and a
+		// ball moveFreeBalls moved cleared the platform box expanded by its radius, so it cannot overlap it
+		if (ball.getIsLaunched())
+		{
+			ball.handlePlatformCollision(platform.getBounds());
+		}
+
+		removeLostExtraBalls();
+
+		// Check if ball fell below screen (lose life)
+		if (ball.getPosition().y > SCREEN_HEIGHT && !extraBalls.empty())
+		{
+			// Another ball takes over as the main ball, and no life is lost
+			const size_t last = extraBalls.size() - 1;
+			ball.setPosition(extraBalls.getPosition(last).x, extraBalls.getPosition(last).y);
+			ball.setVelocity(extraBalls.getVelocity(last).x, extraBalls.getVelocity(last).y);
+			previousBallPosition = extraBalls.getPreviousPosition(last);
+			extraBalls.remove(last);
+		}
+		else if (ball.getPosition().y > SCREEN_HEIGHT)
+		{
+			lives--;
+			events.push(SimEventType::LifeLost, 0, lives);
+			if (lives > 0)
+			{
+				resetBall();
+			}
+			else
+			{
+				status = SimStatus::Lost;
+				events.push(SimEventType::GameLost);
+				return;
+			}
+		}
+
+		// Check win condition
+		if (checkWinCondition())
+		{
+			status = SimStatus::Won;
+			events.push(SimEventType::GameWon);
+		}
+	}
+
+	uint64_t ArkanoidSim::computeStateHash() const
+	{
+		StateHasher hasher;
+		hasher.add(score);
+		hasher.add(lives);
+		hasher.add(status);
+		hasher.addBytes(random.getState(), sizeof(uint32_t) * 4);
+
+		hasher.add(platform.getPosition());
+		hasher.add(platform.getWidth());
+
+		hasher.add(ball.getPosition());
+		hasher.add(ball.getVelocity());
+		hasher.add(ball.getSpeed());
+		hasher.add(ball.getIsLaunched());
+		hasher.add(ball.getIsBonusSpeedActive());
+
+		extraBalls.addToHash(hasher);
+		bricks.addToHash(hasher);
+		bonusManager.addToHash(hasher);
+		return hasher.getValue();
+	}
+
+	void ArkanoidSim::saveSnapshot(SimSnapshot& snapshot, bool withBricks) const
+	{
+		SimCoreState& core = snapshot.core;
+		core.platform = platform.getState();
+		core.ball = ball.getState();
+		std::copy(random.getState(), random.getState() + 4, core.random);
+		core.seed = seed;
+		core.score = score;
+		core.lives = lives;
+		core.status = status;
+		core.extraBallSpeed = extraBallSpeed;
+		core.previousPlatformPosition = previousPlatformPosition;
+		core.previousBallPosition = previousBallPosition;
+		core.brickCount = static_cast<uint32_t>(bricks.size());
+
+		bonusManager.saveState(core.bonusManager, snapshot.bonuses, snapshot.effects);
+		extraBalls.saveState(snapshot.extraBalls);
+
+		if (withBricks)
+		{
+			snapshot.brickHits.assign(bricks.getHitsData(), bricks.getHitsData() + bricks.size());
+			snapshot.brickAliveBits.assign(bricks.getAliveBitsData(), bricks.getAliveBitsData() + bricks.getAliveWordCount());
+		}
+		else
+		{
+			snapshot.brickHits.clear();
+			snapshot.brickAliveBits.clear();
+		}
+	}
+
+	bool ArkanoidSim::restoreSnapshot(const SimSnapshot& snapshot)
+	{
+		const SimCoreState& core = snapshot.core;
+		const bool hasBricks = !snapshot.brickHits.empty();
+		if (core.brickCount != bricks.size() ||
+			(hasBricks && (snapshot.brickHits.size() != bricks.size() || snapshot.brickAliveBits.size() != bricks.getAliveWordCount())))
+		{
+			return false;
+		}
+
+		// Effects are copied, not applied: the platform and ball below already carry them
+		bonusManager.restoreState(core.bonusManager, snapshot.bonuses.data(), snapshot.bonuses.size(),
+			snapshot.effects.data(), snapshot.effects.size(), platform, ball);
+		platform.setState(core.platform);
+		ball.setState(core.ball);
+		extraBalls.restoreState(snapshot.extraBalls.data(), snapshot.extraBalls.size() / BallArray::STATE_VALUES_PER_BALL);
+		random.setState(core.random);
+		seed = core.seed;
+		score = core.score;
+		lives = core.lives;
+		status = core.status;
+		extraBallSpeed = core.extraBallSpeed;
+		previousPlatformPosition = core.previousPlatformPosition;
+		previousBallPosition = core.previousBallPosition;
+		events.clear();
+
+		if (hasBricks)
+		{
+			bricks.restoreState(snapshot.brickHits.data(), snapshot.brickAliveBits.data());
+		}
+		return true;
+	}
+
+	void ArkanoidSim::resetBall()
+	{
+		// Reset ball to platform position
+		float platformX = platform.getPosition().x;
+		float platformY = platform.getPosition().y - platform.getHeight() / 2 - ball.getRadius();
+		ball.reset(platformX, platformY);
+
+		// Respawn is a jump, not a motion to interpolate across
+		previousBallPosition = ball.getPosition();
+	}
+
+	bool ArkanoidSim::checkWinCondition() const
+	{
+		// Won once every block is destroyed
+		return !bricks.hasAliveBricks();
+	}
+}
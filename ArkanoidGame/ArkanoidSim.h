@@ -0,0 +1,171 @@
+#pragma once
+#include "Platform.h"
+#include "Ball.h"
+#include "BallArray.h"
+#include "BrickField.h"
+#include "LevelPack.h"
+#include "BonusManager.h"
+#include "SimRandom.h"
+#include "SimEvents.h"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Player commands for one simulation step
+	 * 
+	 * Filled from the keyboard by GameStatePlaying, or by a bot/replay when running headless.
+	 */
+	struct SimInput
+	{
+		bool moveLeft = false;
+		bool moveRight = false;
+		bool aimLeft = false;   // Aim launch direction to the left (UP key)
+		bool aimRight = false;  // Aim launch direction to the right (DOWN key)
+		bool launch = false;
+	};
+
+	enum class SimStatus
+	{
+		Running,
+		Won,
+		Lost
+	};
+
+	/**
+	 * @brief Fixed-size part of a SimSnapshot
+	 */
+	struct SimCoreState
+	{
+		Platform::State platform;
+		Ball::State ball;
+		BonusManager::State bonusManager;
+		uint32_t random[4];
+		unsigned int seed;
+		int score;
+		int lives;
+		SimStatus status;
+		float extraBallSpeed;
+		sf::Vector2f previousPlatformPosition;
+		sf::Vector2f previousBallPosition;
+		uint32_t brickCount;       // Bricks of the level the snapshot belongs to
+	};
+
+	/**
+	 * @brief Complete state of an ArkanoidSim between two steps
+	 *
+	 * Every part is plain data in flat arrays, so a snapshot can be copied,
+	 * stored or written out byte for byte. The level layout is not included:
+	 * a snapshot restores into a sim reset on the same level. The arrays keep
+	 * their capacity, so saving into the same snapshot again does not allocate.
+	 */
+	struct SimSnapshot
+	{
+		SimCoreState core;
+		std::vector<Bonus::State> bonuses;
+		std::vector<EffectManager::ActiveEffect> effects;
+		std::vector<float> extraBalls;       // See BallArray::saveState
+		std::vector<uint8_t> brickHits;      // Both empty for snapshots saved without bricks
+		std::vector<uint64_t> brickAliveBits;
+	};
+
+	static_assert(std::is_trivially_copyable<SimCoreState>::value && std::is_trivially_copyable<Bonus::State>::value &&
+		std::is_trivially_copyable<EffectManager::ActiveEffect>::value, "Snapshot parts must be plain data");
+
+	/**
+	 * @brief Headless Arkanoid simulation core
+	 * 
+	 * Owns the platform, the main and extra balls, blocks, bonuses, score and lives and advances them
+	 * with step(). Nothing here touches windows, audio or text, so the core can be
+	 * stepped without a display. The same seed and inputs always give the same game,
+	 * bit for bit, which computeStateHash() can verify.
+	 * 
+	 * What happened during a step is reported through getEvents(): audio, HUD
+	 * and statistics read that queue after each step instead of being called
+	 * back from inside the simulation.
+	 */
+	class ArkanoidSim
+	{
+	private:
+		Platform platform;
+		Ball ball;                 // Main ball: aimed, launched and carrying the speed effects
+		BallArray extraBalls;      // Multiball; follows the main ball's speed
+		float extraBallSpeed = BALL_SPEED;      // Main ball speed the extra velocities were last scaled to
+		std::vector<uint32_t> contactBalls;     // Extra balls the free-flight pass left for the exact sweep
+		BrickField bricks;
+		BonusManager bonusManager;
+		SimRandom random;          // The only source of randomness in a session
+		unsigned int seed = 0;
+		int score = 0;
+		int lives = 3;
+		SimStatus status = SimStatus::Running;
+
+		// Positions before the last step, for render interpolation
+		sf::Vector2f previousPlatformPosition;
+		sf::Vector2f previousBallPosition;
+
+		// Events of the last step, valid until the next step()
+		SimEventQueue events;
+
+	public:
+		explicit ArkanoidSim(unsigned int seed);
+		~ArkanoidSim() = default;
+
+		// Active effects point at the platform and ball, so the sim must stay in place
+		ArkanoidSim(const ArkanoidSim&) = delete;
+		ArkanoidSim& operator=(const ArkanoidSim&) = delete;
+
+		// Start a new game on a designed level, or on a layout generated from the seed when level is not valid
+		void reset(unsigned int seed, const LevelView& level = LevelView());
+
+		// Advance the game by timeDelta seconds
+		void step(const SimInput& input, float timeDelta);
+
+		// Getters
+		const Platform& getPlatform() const { return platform; }
+		const Ball& getBall() const { return ball; }
+		const BallArray& getExtraBalls() const { return extraBalls; }
+		size_t getBallCount() const { return 1 + extraBalls.size(); }
+		sf::Vector2f getPreviousPlatformPosition() const { return previousPlatformPosition; }
+		sf::Vector2f getPreviousBallPosition() const { return previousBallPosition; }
+		const BrickField& getBricks() const { return bricks; }
+		const BonusManager& getBonusManager() const { return bonusManager; }
+		int getScore() const { return score; }
+		int getLives() const { return lives; }
+		SimStatus getStatus() const { return status; }
+		const SimEventQueue& getEvents() const { return events; }
+		unsigned int getSeed() const { return seed; }
+
+		// Hash of everything that evolves during play; equal hashes mean bit-identical games
+		uint64_t computeStateHash() const;
+
+		// Multiball: every ball in play spawns newBallsPerBall more, fanned out around its direction
+		void splitBalls(int newBallsPerBall);
+
+		// Copy the whole state out; without bricks, for callers that track brick changes themselves
+		void saveSnapshot(SimSnapshot& snapshot, bool withBricks = true) const;
+
+		// Return to a saved state of the current level, with its bricks if it has them; false if it belongs to another level
+		bool restoreSnapshot(const SimSnapshot& snapshot);
+
+		// Put bricks back into an earlier state, as recorded by RewindBuffer
+		void restoreBricks(const BrickChange* changes, size_t count) { bricks.restoreBricks(changes, count); }
+
+	private:
+		void initializeBlocks(const LevelView& level);
+		void applyInput(const SimInput& input);
+		void moveBall(float timeDelta);
+		void moveExtraBalls(float timeDelta);
+		void sweepBall(sf::Vector2f& position, sf::Vector2f& velocity, float timeDelta);
+		void spawnSplitBalls(const sf::Vector2f& position, const sf::Vector2f& velocity, int newBallsPerBall);
+		void syncExtraBallSpeed();
+		void removeLostExtraBalls();
+		bool onBrickImpact(int index);
+		void applyBonusEvents(size_t firstEvent);
+		void checkCollisions();
+		void resetBall();
+		bool checkWinCondition() const;
+	};
+}
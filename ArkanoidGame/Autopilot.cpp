@@ -0,0 +1,100 @@
+#include "Autopilot.h"
+#include "GameSettings.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const float STEER_DEAD_ZONE = 2.0f;   // Pixels; about two ticks of platform movement, so the bot does not jitter
+		const float MAX_CATCH_OFFSET = 0.6f;  // Largest catch point off center, as a fraction of the platform half width
+
+		float GetLandingLine(const ArkanoidSim& sim)
+		{
+			return sim.getPlatform().getBounds().top - sim.getBall().getRadius();
+		}
+	}
+
+	LandingPrediction PredictNextLanding(const ArkanoidSim& sim)
+	{
+		const BrickField& bricks = sim.getBricks();
+		const float radius = sim.getBall().getRadius();
+		const float lineY = GetLandingLine(sim);
+
+		LandingPrediction earliest;
+		auto consider = [&](sf::Vector2f position, sf::Vector2f velocity) {
+			if (velocity.y <= 0.0f || position.y > lineY)
+				return;
+
+			const LandingPrediction prediction = PredictLanding(bricks, position, velocity, radius, lineY);
+			if (prediction.isValid && (!earliest.isValid || prediction.time < earliest.time))
+			{
+				earliest = prediction;
+			}
+		};
+
+		consider(sim.getBall().getPosition(), sim.getBall().getVelocity());
+		const BallArray& extraBalls = sim.getExtraBalls();
+		for (size_t i = 0; i < extraBalls.size(); ++i)
+		{
+			consider(extraBalls.getPosition(i), extraBalls.getVelocity(i));
+		}
+
+		if (!earliest.isValid)
+		{
+			earliest = PredictLanding(bricks, sim.getBall().getPosition(), sim.getBall().getVelocity(), radius, lineY);
+		}
+		return earliest;
+	}
+
+	SimInput SteerToLanding(const ArkanoidSim& sim, const LandingPrediction& landing)
+	{
+		SimInput input;
+		input.launch = true;
+
+		const Platform& platform = sim.getPlatform();
+		const float halfWidth = platform.getWidth() / 2;
+		float targetX = sim.getBall().getPosition().x;
+		if (sim.getBall().getIsLaunched() && landing.isValid)
+		{
+			// Golden-ratio hash of the landing point: stable while the ball flies, different for every approach
+			const float hash = landing.x * 0.618034f;
+			const float catchOffset = ((hash - std::floor(hash)) * 2.0f - 1.0f) * MAX_CATCH_OFFSET;
+			targetX = landing.x - catchOffset * halfWidth;
+		}
+		targetX = std::max(halfWidth, std::min(targetX, SCREEN_WIDTH - halfWidth));
+
+		const float platformX = platform.getPosition().x;
+		input.moveLeft = targetX < platformX - STEER_DEAD_ZONE;
+		input.moveRight = targetX > platformX + STEER_DEAD_ZONE;
+		return input;
+	}
+
+	SimInput AutopilotController(const ArkanoidSim& sim)
+	{
+		return SteerToLanding(sim, PredictNextLanding(sim));
+	}
+
+	SimInput Autopilot::poll(const ArkanoidSim& sim)
+	{
+		const Ball& ball = sim.getBall();
+		const BrickField& bricks = sim.getBricks();
+
+		// Extra balls move independently, so only a lone ball is worth caching
+		const bool isCacheHit = isCacheValid && sim.getBallCount() == 1 &&
+			ball.getVelocity() == cachedVelocity && ball.getIsLaunched() == cachedIsLaunched &&
+			bricks.getLayoutVersion() == cachedLayoutVersion && bricks.getChangeCount() == cachedChangeCount;
+		if (!isCacheHit)
+		{
+			landing = PredictNextLanding(sim);
+			cachedVelocity = ball.getVelocity();
+			cachedIsLaunched = ball.getIsLaunched();
+			cachedLayoutVersion = bricks.getLayoutVersion();
+			cachedChangeCount = bricks.getChangeCount();
+			isCacheValid = true;
+			++predictionCount;
+		}
+		return SteerToLanding(sim, landing);
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "BallPredictor.h"
+#include "InputProvider.h"
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Predicts where the ball that comes down first meets the platform
+	 * 
+	 * Considers the main ball and every extra ball moving down and returns the
+	 * earliest landing; with none moving down the main ball is traced through its
+	 * next bounces instead.
+	 */
+	LandingPrediction PredictNextLanding(const ArkanoidSim& sim);
+
+	// Input that moves the platform to catch a predicted landing and launches the ball
+	SimInput SteerToLanding(const ArkanoidSim& sim, const LandingPrediction& landing);
+
+	// Stateless autopilot for batch runs, where one controller serves many sessions on many threads
+	SimInput AutopilotController(const ArkanoidSim& sim);
+
+	/**
+	 * @brief Bot player that moves the platform to where the ball will come down
+	 * 
+	 * The landing prediction only changes when a ball bounces, a brick breaks or
+	 * the ball speed changes, so it is cached and recomputed only then; most
+	 * ticks cost a comparison. The platform is offset from the landing point by
+	 * an amount derived from the landing x, which varies the bounce angles so the
+	 * ball cannot settle into a loop that never reaches the bricks.
+	 */
+	class Autopilot : public InputProvider
+	{
+	private:
+		LandingPrediction landing;
+		sf::Vector2f cachedVelocity;
+		uint32_t cachedLayoutVersion = 0;
+		size_t cachedChangeCount = 0;
+		bool cachedIsLaunched = false;
+		bool isCacheValid = false;
+		uint64_t predictionCount = 0;
+
+	public:
+		SimInput poll(const ArkanoidSim& sim) override;
+
+		// Forget the cached prediction, for example after the sim was reset or restored
+		void reset() { isCacheValid = false; }
+
+		const LandingPrediction& getLanding() const { return landing; }
+		uint64_t getPredictionCount() const { return predictionCount; }
+	};
+}
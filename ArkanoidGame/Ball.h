@@ -1,5 +1,4 @@
 #pragma once
-#include <SFML/Graphics.hpp>
 #include "GameSettings.h"
 #include "GameObject.h"
 
@@ -10,21 +9,39 @@ namespace ArkanoidGame
 	 * 
 	 * The ball moves around the screen and bounces off walls and the platform.
 	 * It can be launched by the player and has realistic physics for bouncing.
+	 * Sweeping and contact resolution are driven by ArkanoidSim, which moves the
+	 * ball impact by impact within a step.
+	 * Holds no SFML drawables so it can be simulated without a window.
 	 */
 	class Ball : public GameObject
 	{
 	private:
-		sf::CircleShape shape;       // Visual representation of the ball
 		float radius;                // Ball radius
 		float velocityX;             // Horizontal velocity
 		float velocityY;             // Vertical velocity
 		float speed;                 // Ball speed (magnitude of velocity)
 		bool isLaunched;             // Whether ball is in motion
 		float aimDirection;          // Aim direction (-1.0 to 1.0)
-		float lastCollisionTime;     // Time of last collision to prevent multiple hits
 		bool isBonusSpeedActive;     // Whether bonus speed is currently active
+		bool hasVisualEffect;        // Whether a bonus highlight should be drawn
 
 	public:
+		// Everything that changes during play, as plain data for snapshots
+		struct State
+		{
+			sf::Vector2f position;
+			sf::Vector2f size;
+			float radius;
+			float velocityX;
+			float velocityY;
+			float speed;
+			float aimDirection;
+			bool isLaunched;
+			bool isBonusSpeedActive;
+			bool hasVisualEffect;
+			bool isActive;
+		};
+
 		Ball(float x, float y, float r, float s);
 		~Ball() = default;
 
@@ -32,18 +49,16 @@ namespace ArkanoidGame
 		sf::FloatRect getBounds() const override;
 		float getRadius() const;
 		bool getIsLaunched() const;
+		sf::Vector2f getVelocity() const { return sf::Vector2f(velocityX, velocityY); }
 
 		// Game mechanics
 		void launch();
-		void update(float timeDelta);
-		void draw(sf::RenderWindow& window) const;
+		void limitSpeed();             // Clamp runaway speed unless a speed bonus is active
 		void followPlatform(const sf::Vector2f& platformPosition, float platformWidth);
 		void setAimDirection(float direction); // -1.0 to 1.0, where -1 is left, 1 is right
 
 		// Collision handling
-		void handleWallCollision();
 		void handlePlatformCollision(const sf::FloatRect& platformBounds);
-		void handleBlockCollision(const sf::FloatRect& blockBounds);
 
 		// State control
 		void reset(float x, float y);
@@ -54,6 +69,20 @@ namespace ArkanoidGame
 		void setSpeed(float newSpeed);
 		float getSpeed() const { return speed; }
 		float getCurrentSpeed() const; // Get actual current speed magnitude
+		bool getIsBonusSpeedActive() const { return isBonusSpeedActive; }
 		void setVisualEffect(bool hasEffect);
+		bool getHasVisualEffect() const { return hasVisualEffect; }
+
+		State getState() const;
+		void setState(const State& state);
 	};
+
+	// Velocity after bouncing off the top of the platform: upwards, steered by where the ball hit
+	sf::Vector2f GetPlatformBounceVelocity(const sf::Vector2f& position, const sf::Vector2f& velocity, float speed, const sf::FloatRect& platformBounds);
+
+	// Bounce a descending ball the platform has moved into and lift it onto the platform top; false if they do not touch
+	bool PushOffPlatform(sf::Vector2f& position, sf::Vector2f& velocity, float radius, float speed, const sf::FloatRect& platformBounds);
+
+	// Velocity scaled down to maxSpeed if it is faster
+	sf::Vector2f ClampSpeed(const sf::Vector2f& velocity, float maxSpeed);
 }
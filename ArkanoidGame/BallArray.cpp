@@ -0,0 +1,221 @@
+#include "BallArray.h"
+#include <algorithm>
+#include <initializer_list>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARKANOID_BALLS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		// Box of center positions from which a ball of the given radius touches bounds
+		struct CenterBox
+		{
+			float left;
+			float top;
+			float right;
+			float bottom;
+		};
+
+		CenterBox ExpandBox(const sf::FloatRect& bounds, float radius)
+		{
+			return { bounds.left - radius, bounds.top - radius, bounds.left + bounds.width + radius, bounds.top + bounds.height + radius };
+		}
+	}
+
+	BallArray::BallArray(size_t ballCapacity)
+		: capacity(ballCapacity)
+	{
+	}
+
+	bool BallArray::add(const sf::Vector2f& position, const sf::Vector2f& velocity)
+	{
+		if (count >= capacity)
+		{
+			return false;
+		}
+
+		if (x.empty())
+		{
+			allocate();
+		}
+
+		x[count] = position.x;
+		y[count] = position.y;
+		velocityX[count] = velocity.x;
+		velocityY[count] = velocity.y;
+		previousX[count] = position.x; // A new ball starts where it is, not interpolated from elsewhere
+		previousY[count] = position.y;
+		++count;
+		return true;
+	}
+
+	void BallArray::allocate()
+	{
+		// Whole capacity at once, padded to whole SIMD groups so the kernel never reads past the end
+		const size_t paddedCapacity = (capacity + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+		x.resize(paddedCapacity);
+		y.resize(paddedCapacity);
+		velocityX.resize(paddedCapacity);
+		velocityY.resize(paddedCapacity);
+		previousX.resize(paddedCapacity);
+		previousY.resize(paddedCapacity);
+	}
+
+	void BallArray::remove(size_t index)
+	{
+		const size_t last = count - 1;
+		x[index] = x[last];
+		y[index] = y[last];
+		velocityX[index] = velocityX[last];
+		velocityY[index] = velocityY[last];
+		previousX[index] = previousX[last];
+		previousY[index] = previousY[last];
+		--count;
+	}
+
+	size_t BallArray::moveFreeBalls(float timeDelta, float radius, float screenWidth, const sf::FloatRect& platformBounds, const sf::FloatRect& brickBounds, std::vector<uint32_t>& contactIndices)
+	{
+		contactIndices.clear();
+
+		// The ball center may not pass these planes without hitting a wall (the bottom is open)
+		const float wallLeft = radius;
+		const float wallRight = screenWidth - radius;
+		const float wallTop = radius;
+		const CenterBox platformBox = ExpandBox(platformBounds, radius);
+		const CenterBox brickBox = ExpandBox(brickBounds, radius);
+
+		size_t first = 0;
+
+#ifdef ARKANOID_BALLS_SSE2
+		const __m128 dt = _mm_set1_ps(timeDelta);
+		const __m128 leftPlane = _mm_set1_ps(wallLeft);
+		const __m128 rightPlane = _mm_set1_ps(wallRight);
+		const __m128 topPlane = _mm_set1_ps(wallTop);
+		const __m128 platformLeft = _mm_set1_ps(platformBox.left);
+		const __m128 platformTop = _mm_set1_ps(platformBox.top);
+		const __m128 platformRight = _mm_set1_ps(platformBox.right);
+		const __m128 platformBottom = _mm_set1_ps(platformBox.bottom);
+		const __m128 brickLeft = _mm_set1_ps(brickBox.left);
+		const __m128 brickTop = _mm_set1_ps(brickBox.top);
+		const __m128 brickRight = _mm_set1_ps(brickBox.right);
+		const __m128 brickBottom = _mm_set1_ps(brickBox.bottom);
+
+		for (; first < count; first += LANE_COUNT)
+		{
+			const __m128 startX = _mm_loadu_ps(&x[first]);
+			const __m128 startY = _mm_loadu_ps(&y[first]);
+			const __m128 endX = _mm_add_ps(startX, _mm_mul_ps(_mm_loadu_ps(&velocityX[first]), dt));
+			const __m128 endY = _mm_add_ps(startY, _mm_mul_ps(_mm_loadu_ps(&velocityY[first]), dt));
+
+			// Box swept by the center during the step
+			const __m128 minX = _mm_min_ps(startX, endX);
+			const __m128 maxX = _mm_max_ps(startX, endX);
+			const __m128 minY = _mm_min_ps(startY, endY);
+			const __m128 maxY = _mm_max_ps(startY, endY);
+
+			const __m128 wall = _mm_or_ps(_mm_or_ps(_mm_cmple_ps(minX, leftPlane), _mm_cmpge_ps(maxX, rightPlane)), _mm_cmple_ps(minY, topPlane));
+			const __m128 platform = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(minX, platformRight), _mm_cmpge_ps(maxX, platformLeft)),
+				_mm_and_ps(_mm_cmple_ps(minY, platformBottom), _mm_cmpge_ps(maxY, platformTop)));
+			const __m128 bricks = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(minX, brickRight), _mm_cmpge_ps(maxX, brickLeft)),
+				_mm_and_ps(_mm_cmple_ps(minY, brickBottom), _mm_cmpge_ps(maxY, brickTop)));
+			const __m128 contact = _mm_or_ps(wall, _mm_or_ps(platform, bricks));
+
+			// Free lanes take their end position, contact lanes keep the start for the exact pass
+			_mm_storeu_ps(&x[first], _mm_or_ps(_mm_and_ps(contact, startX), _mm_andnot_ps(contact, endX)));
+			_mm_storeu_ps(&y[first], _mm_or_ps(_mm_and_ps(contact, startY), _mm_andnot_ps(contact, endY)));
+
+			int mask = _mm_movemask_ps(contact);
+			while (mask != 0)
+			{
+				const size_t lane = mask & 1 ? 0 : mask & 2 ? 1 : mask & 4 ? 2 : 3;
+				mask &= mask - 1;
+				if (first + lane < count) // Padding lanes past the last ball are ignored
+				{
+					contactIndices.push_back(static_cast<uint32_t>(first + lane));
+				}
+			}
+		}
+#else
+		for (; first < count; ++first)
+		{
+			const float endX = x[first] + velocityX[first] * timeDelta;
+			const float endY = y[first] + velocityY[first] * timeDelta;
+			const float minX = std::min(x[first], endX);
+			const float maxX = std::max(x[first], endX);
+			const float minY = std::min(y[first], endY);
+			const float maxY = std::max(y[first], endY);
+
+			const bool wall = minX <= wallLeft || maxX >= wallRight || minY <= wallTop;
+			const bool platform = minX <= platformBox.right && maxX >= platformBox.left && minY <= platformBox.bottom && maxY >= platformBox.top;
+			const bool bricks = minX <= brickBox.right && maxX >= brickBox.left && minY <= brickBox.bottom && maxY >= brickBox.top;
+			if (wall || platform || bricks)
+			{
+				contactIndices.push_back(static_cast<uint32_t>(first));
+			}
+			else
+			{
+				x[first] = endX;
+				y[first] = endY;
+			}
+		}
+#endif
+
+		return contactIndices.size();
+	}
+
+	void BallArray::scaleVelocities(float factor)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			velocityX[i] *= factor;
+			velocityY[i] *= factor;
+		}
+	}
+
+	void BallArray::savePreviousPositions()
+	{
+		std::copy(x.begin(), x.begin() + count, previousX.begin());
+		std::copy(y.begin(), y.begin() + count, previousY.begin());
+	}
+
+	void BallArray::addToHash(StateHasher& hasher) const
+	{
+		hasher.add(static_cast<uint32_t>(count));
+		hasher.addBytes(x.data(), count * sizeof(float));
+		hasher.addBytes(y.data(), count * sizeof(float));
+		hasher.addBytes(velocityX.data(), count * sizeof(float));
+		hasher.addBytes(velocityY.data(), count * sizeof(float));
+	}
+
+	void BallArray::saveState(std::vector<float>& values) const
+	{
+		values.resize(count * STATE_VALUES_PER_BALL);
+		float* value = values.data();
+		for (const std::vector<float>* column : { &x, &y, &velocityX, &velocityY, &previousX, &previousY })
+		{
+			std::copy(column->begin(), column->begin() + count, value);
+			value += count;
+		}
+	}
+
+	void BallArray::restoreState(const float* values, size_t ballCount)
+	{
+		count = std::min(ballCount, capacity);
+		if (count == 0)
+			return;
+
+		if (x.empty())
+		{
+			allocate();
+		}
+		for (std::vector<float>* column : { &x, &y, &velocityX, &velocityY, &previousX, &previousY })
+		{
+			std::copy(values, values + count, column->begin());
+			values += ballCount;
+		}
+	}
+}
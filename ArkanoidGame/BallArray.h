@@ -0,0 +1,81 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "StateHash.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Structure-of-arrays storage for the extra balls of multiball
+	 *
+	 * Positions and velocities each live in their own contiguous column, padded
+	 * to a multiple of the SIMD width, so the free-flight kernel can move four
+	 * balls per instruction. Storage for the full capacity is allocated with the
+	 * first ball, so sessions without multiball pay nothing and adding and
+	 * removing balls afterwards never allocates. All balls share one radius.
+	 */
+	class BallArray
+	{
+	public:
+		static const size_t LANE_COUNT = 4; // Balls per SIMD register
+
+	private:
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> previousX; // Positions before the last step, for render interpolation
+		std::vector<float> previousY;
+		size_t count = 0;
+		size_t capacity;
+
+	public:
+		explicit BallArray(size_t ballCapacity);
+
+		// Add a ball and return false if the array is full
+		bool add(const sf::Vector2f& position, const sf::Vector2f& velocity);
+
+		// Remove a ball by moving the last ball into its slot
+		void remove(size_t index);
+		void clear() { count = 0; }
+
+		/**
+		 * @brief Moves every ball whose swept path touches no wall, no platform and no brick
+		 *
+		 * Processes LANE_COUNT balls at a time with SSE2 where available. Balls
+		 * that might touch something are left in place and their indices written
+		 * to contactIndices for the exact swept collision pass.
+		 *
+		 * @param platformBounds Platform box, after its move this step
+		 * @param brickBounds Box around every brick that may still be alive
+		 * @return Number of indices written to contactIndices
+		 */
+		size_t moveFreeBalls(float timeDelta, float radius, float screenWidth, const sf::FloatRect& platformBounds, const sf::FloatRect& brickBounds, std::vector<uint32_t>& contactIndices);
+
+		// Scale every velocity, used to follow speed bonuses on the main ball
+		void scaleVelocities(float factor);
+		void savePreviousPositions();
+		void addToHash(StateHasher& hasher) const;
+
+		// Snapshot support: the columns x, y, velocity x and y, previous x and y, one after another
+		static const size_t STATE_VALUES_PER_BALL = 6;
+		void saveState(std::vector<float>& values) const;
+		void restoreState(const float* values, size_t ballCount);
+
+		// Getters and setters
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		bool isFull() const { return count >= capacity; }
+		sf::Vector2f getPosition(size_t index) const { return sf::Vector2f(x[index], y[index]); }
+		sf::Vector2f getVelocity(size_t index) const { return sf::Vector2f(velocityX[index], velocityY[index]); }
+		sf::Vector2f getPreviousPosition(size_t index) const { return sf::Vector2f(previousX[index], previousY[index]); }
+		void setPosition(size_t index, const sf::Vector2f& position) { x[index] = position.x; y[index] = position.y; }
+		void setVelocity(size_t index, const sf::Vector2f& velocity) { velocityX[index] = velocity.x; velocityY[index] = velocity.y; }
+
+	private:
+		void allocate();
+	};
+}
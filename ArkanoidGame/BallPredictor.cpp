@@ -0,0 +1,133 @@
+#include "BallPredictor.h"
+#include "GameSettings.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const int MAX_BROKEN_BRICKS = 16; // Bricks one prediction remembers breaking
+	}
+
+	float FoldBetweenWalls(float coordinate, float minCoordinate, float maxCoordinate)
+	{
+		const float span = maxCoordinate - minCoordinate;
+		if (span <= 0.0f)
+			return minCoordinate;
+
+		// Bounces mirror the path, so the position repeats every two spans
+		float offset = std::fmod(coordinate - minCoordinate, span * 2);
+		if (offset < 0.0f)
+		{
+			offset += span * 2;
+		}
+		return minCoordinate + (offset <= span ? offset : span * 2 - offset);
+	}
+
+	LandingPrediction PredictLanding(const BrickField& bricks, sf::Vector2f position, sf::Vector2f velocity, float radius, float lineY, int maxBounces)
+	{
+		LandingPrediction prediction;
+		const float leftWall = radius;
+		const float rightWall = SCREEN_WIDTH - radius;
+		const float topWall = radius;
+
+		const sf::FloatRect layout = bricks.getLayoutBounds();
+		const bool hasBricks = bricks.hasAliveBricks();
+		const float belowBricks = layout.top + layout.height + radius;
+
+		uint32_t brokenBricks[MAX_BROKEN_BRICKS];
+		int brokenCount = 0;
+		auto isBroken = [&](uint32_t index) {
+			return std::find(brokenBricks, brokenBricks + brokenCount, index) != brokenBricks + brokenCount;
+		};
+
+		// Glass hits are not bounces, so the segments are limited too in case the broken list fills up
+		const int maxSegments = maxBounces * 2 + MAX_BROKEN_BRICKS;
+		float elapsed = 0.0f;
+		for (int segment = 0; segment < maxSegments && prediction.bounces <= maxBounces; ++segment)
+		{
+			// A ball moving only sideways never comes down
+			if (velocity.y == 0.0f)
+				break;
+
+			// Below every brick and falling: only the side walls are left
+			if (velocity.y > 0.0f && (!hasBricks || position.y >= belowBricks))
+			{
+				const float time = std::max(0.0f, (lineY - position.y) / velocity.y);
+				const float freeX = position.x + velocity.x * time;
+				prediction.x = FoldBetweenWalls(freeX, leftWall, rightWall);
+				prediction.time = elapsed + time;
+				prediction.bounces += static_cast<int>(std::abs(std::floor((freeX - leftWall) / (rightWall - leftWall))));
+				prediction.isValid = true;
+				return prediction;
+			}
+
+			// Nearest of the side walls, the top wall and the line, in closed form
+			float time = velocity.y > 0.0f ? (lineY - position.y) / velocity.y : (topWall - position.y) / velocity.y;
+			bool isSideWall = false;
+			if (velocity.x != 0.0f)
+			{
+				const float wallTime = ((velocity.x < 0.0f ? leftWall : rightWall) - position.x) / velocity.x;
+				if (wallTime < time)
+				{
+					time = wallTime;
+					isSideWall = true;
+				}
+			}
+			time = std::max(0.0f, time);
+
+			// Bricks in between, found by walking the brick grid along the segment
+			const sf::Vector2f displacement = velocity * time;
+			if (hasBricks)
+			{
+				float impactTime;
+				sf::Vector2f normal;
+				const int brick = bricks.traceImpact(position, radius, displacement, impactTime, normal, isBroken);
+				if (brick >= 0)
+				{
+					position += displacement * impactTime;
+					elapsed += time * impactTime;
+
+					const BlockType type = bricks.getType(brick);
+					const bool isDestroyed = type != BlockType::Durable || bricks.getHits(brick) + 1 >= bricks.getMaxHits(brick);
+					if (isDestroyed && brokenCount < MAX_BROKEN_BRICKS)
+					{
+						brokenBricks[brokenCount++] = static_cast<uint32_t>(brick);
+					}
+					if (type != BlockType::Glass)
+					{
+						velocity = Reflect(velocity, normal);
+						++prediction.bounces;
+					}
+					continue;
+				}
+			}
+
+			position += displacement;
+			elapsed += time;
+			if (!isSideWall && velocity.y > 0.0f)
+			{
+				prediction.x = position.x;
+				prediction.time = elapsed;
+				prediction.isValid = true;
+				return prediction;
+			}
+
+			if (isSideWall)
+			{
+				velocity.x = -velocity.x;
+			}
+			else
+			{
+				velocity.y = -velocity.y;
+			}
+			++prediction.bounces;
+		}
+
+		// Best guess for a path that did not come down in time
+		prediction.x = position.x;
+		prediction.time = elapsed;
+		return prediction;
+	}
+}
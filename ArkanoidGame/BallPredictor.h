@@ -0,0 +1,36 @@
+#pragma once
+#include "BrickField.h"
+#include <SFML/System/Vector2.hpp>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Where a ball next comes down to a given height
+	 */
+	struct LandingPrediction
+	{
+		float x = 0.0f;       // Ball center at the crossing
+		float time = 0.0f;    // Seconds from now
+		int bounces = 0;      // Walls and bricks on the way
+		bool isValid = false; // False if the ball did not come down within the bounce limit
+	};
+
+	/**
+	 * @brief Traces a ball to where it crosses lineY moving down, without stepping the simulation
+	 * 
+	 * The path is followed segment by segment with the same rules as
+	 * ArkanoidSim::sweepBall: side and top walls are planes one radius in from
+	 * the screen edges, bricks bounce the ball except glass, which it passes
+	 * through. Each segment is one closed-form wall time plus one
+	 * BrickField::traceImpact walk through the brick grid. Bricks the
+	 * prediction breaks are passed through afterwards. Once the ball is below
+	 * every brick and falling, the remaining wall bounces are folded in closed
+	 * form, so that common case costs a few operations.
+	 * The result is exact for the current speed; speed bonuses that run out on
+	 * the way and bonuses that change the bricks are not foreseen.
+	 */
+	LandingPrediction PredictLanding(const BrickField& bricks, sf::Vector2f position, sf::Vector2f velocity, float radius, float lineY, int maxBounces = 32);
+
+	// Folds a coordinate that moved freely into the range between two walls, as if it had bounced off them
+	float FoldBetweenWalls(float coordinate, float minCoordinate, float maxCoordinate);
+}
@@ -5,21 +5,21 @@
 
 namespace ArkanoidGame
 {
-	Bonus::Bonus(float x, float y, std::unique_ptr<IBonusEffect> bonusEffect, float speed)
-		: GameObject(x, y, BONUS_SIZE, BONUS_SIZE), effect(std::move(bonusEffect)), fallSpeed(speed), isCollected(false), timeToLive(10.0f)
+	Bonus::Bonus(float x, float y, const BonusEffect& bonusEffect, float speed)
+		: GameObject(x, y, BONUS_SIZE, BONUS_SIZE), effect(bonusEffect), fallSpeed(speed), isCollected(false), timeToLive(10.0f)
 	{
-		// Create circular shape for bonus
-		shape.setRadius(BONUS_RADIUS);
-		shape.setPosition(x, y);
-		shape.setFillColor(sf::Color::Yellow);
-		shape.setOutlineColor(sf::Color::White);
-		shape.setOutlineThickness(2.0f);
-		shape.setOrigin(BONUS_RADIUS, BONUS_RADIUS); // Center the origin
+	}
+
+	Bonus::Bonus(const State& state)
+		: GameObject(state.position.x, state.position.y, BONUS_SIZE, BONUS_SIZE), effect(state.effect), fallSpeed(state.fallSpeed), isCollected(state.isCollected), timeToLive(state.timeToLive)
+	{
+		isActive = state.isActive;
 	}
 
 	sf::FloatRect Bonus::getBounds() const
 	{
-		return shape.getGlobalBounds();
+		// Position is the bonus center
+		return sf::FloatRect(position.x - BONUS_RADIUS, position.y - BONUS_RADIUS, BONUS_RADIUS * 2, BONUS_RADIUS * 2);
 	}
 
 	void Bonus::update(float timeDelta)
@@ -28,7 +28,6 @@ namespace ArkanoidGame
 
 		// Fall down
 		position.y += fallSpeed * timeDelta;
-		shape.setPosition(position);
 
 		// Decrease time to live
 		timeToLive -= timeDelta;
@@ -40,32 +39,22 @@ namespace ArkanoidGame
 		}
 	}
 
-	void Bonus::draw(sf::RenderWindow& window) const
-	{
-		if (isActive && !isCollected)
-		{
-			window.draw(shape);
-		}
-	}
-
 	void Bonus::collect()
 	{
 		if (!isCollected)
 		{
 			isCollected = true;
 			isActive = false;
-			
-			// Notify observer
-			if (onCollected)
-			{
-				onCollected(this);
-			}
 		}
 	}
 
 	void Bonus::setPosition(float x, float y)
 	{
 		GameObject::setPosition(x, y);
-		shape.setPosition(x, y);
+	}
+
+	Bonus::State Bonus::getState() const
+	{
+		return { position, effect, fallSpeed, timeToLive, isCollected, isActive };
 	}
 }
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Every kind of bonus effect
+	 *
+	 * The order matches the alternatives of BonusEffect (checked at compile
+	 * time in BonusEffects.h), so a variant index converts straight to a type.
+	 */
+	enum class BonusEffectType : uint8_t
+	{
+		PlatformSize,
+		BallSpeed,
+		ExtraLife,
+		BallSlow,
+		Points,
+		SplitBall,
+		Count
+	};
+
+	constexpr size_t BONUS_EFFECT_TYPE_COUNT = static_cast<size_t>(BonusEffectType::Count);
+
+	/**
+	 * @brief Static description of one effect type
+	 */
+	struct BonusEffectInfo
+	{
+		BonusEffectType type;
+		const char* name;   // Shown in the HUD
+		float duration;     // Seconds; 0 for instant effects
+		float magnitude;    // Size or speed multiplier, points awarded, or new balls per ball
+	};
+
+	// One row per BonusEffectType, in enum order
+	constexpr BonusEffectInfo BONUS_EFFECT_INFOS[] =
+	{
+		{ BonusEffectType::PlatformSize, "Platform Size+", 8.0f, 1.5f },
+		{ BonusEffectType::BallSpeed, "Ball Speed+", 6.0f, 1.3f },
+		{ BonusEffectType::ExtraLife, "+1 Life", 0.0f, 1.0f },
+		{ BonusEffectType::BallSlow, "Ball Slow", 7.0f, 0.7f },
+		{ BonusEffectType::Points, "Bonus Points", 0.0f, 100.0f },
+		{ BonusEffectType::SplitBall, "Multiball", 0.0f, 2.0f },
+	};
+
+	static_assert(sizeof(BONUS_EFFECT_INFOS) / sizeof(BONUS_EFFECT_INFOS[0]) == BONUS_EFFECT_TYPE_COUNT, "Every bonus effect type needs a BONUS_EFFECT_INFOS row");
+
+	constexpr bool AreBonusEffectInfosOrdered()
+	{
+		for (size_t i = 0; i < BONUS_EFFECT_TYPE_COUNT; ++i)
+		{
+			if (static_cast<size_t>(BONUS_EFFECT_INFOS[i].type) != i)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static_assert(AreBonusEffectInfosOrdered(), "BONUS_EFFECT_INFOS rows must follow BonusEffectType order");
+
+	constexpr const BonusEffectInfo& GetBonusEffectInfo(BonusEffectType type)
+	{
+		return BONUS_EFFECT_INFOS[static_cast<size_t>(type)];
+	}
+
+	constexpr const char* GetBonusEffectName(BonusEffectType type) { return GetBonusEffectInfo(type).name; }
+	constexpr float GetBonusEffectDefaultDuration(BonusEffectType type) { return GetBonusEffectInfo(type).duration; }
+	constexpr float GetBonusEffectMagnitude(BonusEffectType type) { return GetBonusEffectInfo(type).magnitude; }
+	constexpr bool IsInstantBonusEffect(BonusEffectType type) { return GetBonusEffectInfo(type).duration == 0.0f; }
+}
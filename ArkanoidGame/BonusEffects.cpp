@@ -23,11 +23,6 @@ namespace ArkanoidGame
 		platform.setVisualEffect(false);
 	}
 
-	std::unique_ptr<IBonusEffect> PlatformSizeBonus::clone() const
-	{
-		return std::make_unique<PlatformSizeBonus>(bonusWidth / PLATFORM_WIDTH, duration);
-	}
-
 	// BallSpeedBonus implementation
 	BallSpeedBonus::BallSpeedBonus(float speedMultiplier, float effectDuration)
 		: originalSpeed(0), bonusMultiplier(speedMultiplier), duration(effectDuration)
@@ -48,11 +43,6 @@ namespace ArkanoidGame
 		// Note: isBonusSpeedActive flag will be reset when speed is restored to original
 	}
 
-	std::unique_ptr<IBonusEffect> BallSpeedBonus::clone() const
-	{
-		return std::make_unique<BallSpeedBonus>(bonusMultiplier, duration);
-	}
-
 	// ExtraLifeBonus implementation
 	ExtraLifeBonus::ExtraLifeBonus(float effectDuration)
 		: duration(effectDuration)
@@ -70,11 +60,6 @@ namespace ArkanoidGame
 		// No cleanup needed for instant effect
 	}
 
-	std::unique_ptr<IBonusEffect> ExtraLifeBonus::clone() const
-	{
-		return std::make_unique<ExtraLifeBonus>(duration);
-	}
-
 	// BallSlowBonus implementation
 	BallSlowBonus::BallSlowBonus(float speedMultiplier, float effectDuration)
 		: originalSpeed(0), slowMultiplier(speedMultiplier), duration(effectDuration)
@@ -95,11 +80,6 @@ namespace ArkanoidGame
 		// Note: isBonusSpeedActive flag will be reset when speed is restored to original
 	}
 
-	std::unique_ptr<IBonusEffect> BallSlowBonus::clone() const
-	{
-		return std::make_unique<BallSlowBonus>(slowMultiplier, duration);
-	}
-
 	// PointsBonus implementation
 	PointsBonus::PointsBonus(int points, float effectDuration)
 		: bonusPoints(points), duration(effectDuration)
@@ -117,8 +97,35 @@ namespace ArkanoidGame
 		// No cleanup needed for instant effect
 	}
 
-	std::unique_ptr<IBonusEffect> PointsBonus::clone() const
+	// SplitBallBonus implementation
+	SplitBallBonus::SplitBallBonus(int newBallsPerBall, float effectDuration)
+		: ballsPerBall(newBallsPerBall), duration(effectDuration)
+	{
+	}
+
+	void SplitBallBonus::applyEffect(Platform& platform, Ball& ball)
+	{
+		// New balls are spawned by the simulation, which owns them
+	}
+
+	void SplitBallBonus::removeEffect(Platform& platform, Ball& ball)
+	{
+		// No cleanup needed for instant effect
+	}
+
+	// BonusEffect dispatch
+	void ApplyBonusEffect(BonusEffect& effect, Platform& platform, Ball& ball)
+	{
+		std::visit([&](auto& typedEffect) { typedEffect.applyEffect(platform, ball); }, effect);
+	}
+
+	void RemoveBonusEffect(BonusEffect& effect, Platform& platform, Ball& ball)
+	{
+		std::visit([&](auto& typedEffect) { typedEffect.removeEffect(platform, ball); }, effect);
+	}
+
+	float GetBonusEffectDuration(const BonusEffect& effect)
 	{
-		return std::make_unique<PointsBonus>(bonusPoints, duration);
+		return std::visit([](const auto& typedEffect) { return typedEffect.getDuration(); }, effect);
 	}
 }
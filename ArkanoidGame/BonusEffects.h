@@ -1,99 +1,157 @@
 #pragma once
-#include "Bonus.h"
 #include "Platform.h"
 #include "Ball.h"
+#include "BonusEffectTypes.h"
+#include <utility>
+#include <variant>
 
 namespace ArkanoidGame
 {
 	/**
 	 * @brief Bonus effect that increases platform size
 	 */
-	class PlatformSizeBonus : public IBonusEffect
+	class PlatformSizeBonus
 	{
+	public:
+		static constexpr BonusEffectType TYPE = BonusEffectType::PlatformSize;
+
 	private:
 		float originalWidth;
 		float bonusWidth;
 		float duration;
 
 	public:
-		PlatformSizeBonus(float bonusMultiplier = 1.5f, float effectDuration = 8.0f);
-		void applyEffect(Platform& platform, Ball& ball) override;
-		void removeEffect(Platform& platform, Ball& ball) override;
-		std::string getEffectName() const override { return "Platform Size+"; }
-		float getDuration() const override { return duration; }
-		std::unique_ptr<IBonusEffect> clone() const override;
+		PlatformSizeBonus(float bonusMultiplier = GetBonusEffectMagnitude(TYPE), float effectDuration = GetBonusEffectDefaultDuration(TYPE));
+		void applyEffect(Platform& platform, Ball& ball);
+		void removeEffect(Platform& platform, Ball& ball);
+		static constexpr const char* getEffectName() { return GetBonusEffectName(TYPE); }
+		float getDuration() const { return duration; }
 	};
 
 	/**
 	 * @brief Bonus effect that increases ball speed
 	 */
-	class BallSpeedBonus : public IBonusEffect
+	class BallSpeedBonus
 	{
+	public:
+		static constexpr BonusEffectType TYPE = BonusEffectType::BallSpeed;
+
 	private:
 		float originalSpeed;
 		float bonusMultiplier;
 		float duration;
 
 	public:
-		BallSpeedBonus(float speedMultiplier = 1.3f, float effectDuration = 6.0f);
-		void applyEffect(Platform& platform, Ball& ball) override;
-		void removeEffect(Platform& platform, Ball& ball) override;
-		std::string getEffectName() const override { return "Ball Speed+"; }
-		float getDuration() const override { return duration; }
-		std::unique_ptr<IBonusEffect> clone() const override;
+		BallSpeedBonus(float speedMultiplier = GetBonusEffectMagnitude(TYPE), float effectDuration = GetBonusEffectDefaultDuration(TYPE));
+		void applyEffect(Platform& platform, Ball& ball);
+		void removeEffect(Platform& platform, Ball& ball);
+		static constexpr const char* getEffectName() { return GetBonusEffectName(TYPE); }
+		float getDuration() const { return duration; }
 	};
 
 	/**
 	 * @brief Bonus effect that gives extra life
 	 */
-	class ExtraLifeBonus : public IBonusEffect
+	class ExtraLifeBonus
 	{
+	public:
+		static constexpr BonusEffectType TYPE = BonusEffectType::ExtraLife;
+
 	private:
 		float duration;
 
 	public:
-		ExtraLifeBonus(float effectDuration = 0.0f); // Instant effect
-		void applyEffect(Platform& platform, Ball& ball) override;
-		void removeEffect(Platform& platform, Ball& ball) override;
-		std::string getEffectName() const override { return "+1 Life"; }
-		float getDuration() const override { return duration; }
-		std::unique_ptr<IBonusEffect> clone() const override;
+		ExtraLifeBonus(float effectDuration = GetBonusEffectDefaultDuration(TYPE)); // Instant effect
+		void applyEffect(Platform& platform, Ball& ball);
+		void removeEffect(Platform& platform, Ball& ball);
+		static constexpr const char* getEffectName() { return GetBonusEffectName(TYPE); }
+		float getDuration() const { return duration; }
 	};
 
 	/**
 	 * @brief Bonus effect that slows down ball speed
 	 */
-	class BallSlowBonus : public IBonusEffect
+	class BallSlowBonus
 	{
+	public:
+		static constexpr BonusEffectType TYPE = BonusEffectType::BallSlow;
+
 	private:
 		float originalSpeed;
 		float slowMultiplier;
 		float duration;
 
 	public:
-		BallSlowBonus(float speedMultiplier = 0.7f, float effectDuration = 7.0f);
-		void applyEffect(Platform& platform, Ball& ball) override;
-		void removeEffect(Platform& platform, Ball& ball) override;
-		std::string getEffectName() const override { return "Ball Slow"; }
-		float getDuration() const override { return duration; }
-		std::unique_ptr<IBonusEffect> clone() const override;
+		BallSlowBonus(float speedMultiplier = GetBonusEffectMagnitude(TYPE), float effectDuration = GetBonusEffectDefaultDuration(TYPE));
+		void applyEffect(Platform& platform, Ball& ball);
+		void removeEffect(Platform& platform, Ball& ball);
+		static constexpr const char* getEffectName() { return GetBonusEffectName(TYPE); }
+		float getDuration() const { return duration; }
 	};
 
 	/**
 	 * @brief Bonus effect that gives extra points
 	 */
-	class PointsBonus : public IBonusEffect
+	class PointsBonus
 	{
+	public:
+		static constexpr BonusEffectType TYPE = BonusEffectType::Points;
+
 	private:
 		int bonusPoints;
 		float duration;
 
 	public:
-		PointsBonus(int points = 100, float effectDuration = 0.0f); // Instant effect
-		void applyEffect(Platform& platform, Ball& ball) override;
-		void removeEffect(Platform& platform, Ball& ball) override;
-		std::string getEffectName() const override { return "Bonus Points"; }
-		float getDuration() const override { return duration; }
-		std::unique_ptr<IBonusEffect> clone() const override;
+		PointsBonus(int points = static_cast<int>(GetBonusEffectMagnitude(TYPE)), float effectDuration = GetBonusEffectDefaultDuration(TYPE)); // Instant effect
+		int getBonusPoints() const { return bonusPoints; }
+		void applyEffect(Platform& platform, Ball& ball);
+		void removeEffect(Platform& platform, Ball& ball);
+		static constexpr const char* getEffectName() { return GetBonusEffectName(TYPE); }
+		float getDuration() const { return duration; }
 	};
+
+	/**
+	 * @brief Bonus effect that splits every ball in flight into several
+	 */
+	class SplitBallBonus
+	{
+	public:
+		static constexpr BonusEffectType TYPE = BonusEffectType::SplitBall;
+
+	private:
+		int ballsPerBall;
+		float duration;
+
+	public:
+		SplitBallBonus(int newBallsPerBall = static_cast<int>(GetBonusEffectMagnitude(TYPE)), float effectDuration = GetBonusEffectDefaultDuration(TYPE)); // Instant effect
+		int getBallsPerBall() const { return ballsPerBall; }
+		void applyEffect(Platform& platform, Ball& ball);
+		void removeEffect(Platform& platform, Ball& ball);
+		static constexpr const char* getEffectName() { return GetBonusEffectName(TYPE); }
+		float getDuration() const { return duration; }
+	};
+
+	/**
+	 * @brief Any bonus effect, stored by value
+	 * 
+	 * Bonuses and active effects keep their effect inline instead of behind a
+	 * heap pointer, so creating, copying and expiring effects never allocates.
+	 */
+	using BonusEffect = std::variant<PlatformSizeBonus, BallSpeedBonus, ExtraLifeBonus, BallSlowBonus, PointsBonus, SplitBallBonus>;
+
+	template<size_t... Indices>
+	constexpr bool IsBonusEffectInTypeOrder(std::index_sequence<Indices...>)
+	{
+		return ((static_cast<size_t>(std::variant_alternative_t<Indices, BonusEffect>::TYPE) == Indices) && ...);
+	}
+
+	static_assert(std::variant_size_v<BonusEffect> == BONUS_EFFECT_TYPE_COUNT, "BonusEffect needs one alternative per BonusEffectType");
+	static_assert(IsBonusEffectInTypeOrder(std::make_index_sequence<BONUS_EFFECT_TYPE_COUNT>()), "BonusEffect alternatives must follow BonusEffectType order");
+
+	// Type of the effect held, from its position in BonusEffect
+	inline BonusEffectType GetBonusEffectType(const BonusEffect& effect) { return static_cast<BonusEffectType>(effect.index()); }
+
+	void ApplyBonusEffect(BonusEffect& effect, Platform& platform, Ball& ball);
+	void RemoveBonusEffect(BonusEffect& effect, Platform& platform, Ball& ball);
+	float GetBonusEffectDuration(const BonusEffect& effect);
 }
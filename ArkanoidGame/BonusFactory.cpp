@@ -1,60 +1,50 @@
 #include "BonusFactory.h"
 #include "GameSettings.h"
-#include <chrono>
 
 namespace ArkanoidGame
 {
-	BonusFactory::BonusFactory()
-		: rng(static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count())),
-		  dropChance(0.0f, 1.0f),
-		  positionX(50.0f, SCREEN_WIDTH - 50.0f),
-		  bonusType(0, 4) // 5 different bonus types
+	std::optional<Bonus> BonusFactory::createBonus(float x, float y, SimRandom& random)
 	{
-	}
-
-	std::unique_ptr<Bonus> BonusFactory::createBonus(float x, float y)
-	{
-		if (!shouldDropBonus())
+		if (!shouldDropBonus(random))
 		{
-			return nullptr;
+			return std::nullopt;
 		}
 
-		auto effect = createRandomEffect();
-		if (!effect)
-		{
-			return nullptr;
-		}
+		const BonusEffect effect = createRandomEffect(random);
 
 		// Create bonus with slight random offset
-		float offsetX = positionX(rng) - x;
+		float offsetX = random.uniformFloat(50.0f, SCREEN_WIDTH - 50.0f) - x;
 		float finalX = x + offsetX * 0.1f; // Small random offset
 		
-		return std::make_unique<Bonus>(finalX, y, std::move(effect));
+		return Bonus(finalX, y, effect);
 	}
 
-	bool BonusFactory::shouldDropBonus()
+	bool BonusFactory::shouldDropBonus(SimRandom& random)
 	{
-		return dropChance(rng) < BONUS_DROP_CHANCE;
+		return random.nextFloat() < BONUS_DROP_CHANCE;
 	}
 
-	std::unique_ptr<IBonusEffect> BonusFactory::createRandomEffect()
+	BonusEffect BonusFactory::createRandomEffect(SimRandom& random)
 	{
-		int type = bonusType(rng);
+		const auto type = static_cast<BonusEffectType>(random.uniformInt(0, static_cast<int>(BONUS_EFFECT_TYPE_COUNT) - 1));
 		
+		// Effects take their strength and duration from BONUS_EFFECT_INFOS
 		switch (type)
 		{
-		case 0:
-			return std::make_unique<PlatformSizeBonus>(1.5f, 8.0f);
-		case 1:
-			return std::make_unique<BallSpeedBonus>(1.3f, 6.0f);
-		case 2:
-			return std::make_unique<ExtraLifeBonus>();
-		case 3:
-			return std::make_unique<BallSlowBonus>(0.7f, 7.0f);
-		case 4:
-			return std::make_unique<PointsBonus>(100);
+		case BonusEffectType::PlatformSize:
+			return PlatformSizeBonus();
+		case BonusEffectType::BallSpeed:
+			return BallSpeedBonus();
+		case BonusEffectType::ExtraLife:
+			return ExtraLifeBonus();
+		case BonusEffectType::BallSlow:
+			return BallSlowBonus();
+		case BonusEffectType::Points:
+			return PointsBonus();
+		case BonusEffectType::SplitBall:
+			return SplitBallBonus();
 		default:
-			return std::make_unique<PlatformSizeBonus>(1.5f, 8.0f);
+			return PlatformSizeBonus();
 		}
 	}
 }
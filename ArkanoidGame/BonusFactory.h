@@ -1,8 +1,8 @@
 #pragma once
 #include "Bonus.h"
 #include "BonusEffects.h"
-#include <random>
-#include <memory>
+#include "SimRandom.h"
+#include <optional>
 
 namespace ArkanoidGame
 {
@@ -10,37 +10,31 @@ namespace ArkanoidGame
 	 * @brief Factory class for creating bonuses
 	 * 
 	 * Uses Factory pattern to create different types of bonuses
-	 * with random effects and positions
+	 * with random effects and positions. All randomness comes from the
+	 * session generator passed in, so drops replay exactly.
 	 */
 	class BonusFactory
 	{
-	private:
-		std::mt19937 rng;
-		std::uniform_real_distribution<float> dropChance;
-		std::uniform_real_distribution<float> positionX;
-		std::uniform_int_distribution<int> bonusType;
-
 	public:
-		BonusFactory();
-		
 		/**
 		 * @brief Creates a bonus at the specified position
 		 * @param x X position
 		 * @param y Y position
-		 * @return Unique pointer to bonus or nullptr if no bonus should be created
+		 * @param random Session random generator
+		 * @return The bonus, or nothing if no bonus should be created
 		 */
-		std::unique_ptr<Bonus> createBonus(float x, float y);
+		std::optional<Bonus> createBonus(float x, float y, SimRandom& random);
 		
 		/**
 		 * @brief Determines if a bonus should drop (10% chance)
 		 * @return True if bonus should drop
 		 */
-		bool shouldDropBonus();
+		bool shouldDropBonus(SimRandom& random);
 		
 		/**
 		 * @brief Creates a random bonus effect
-		 * @return Unique pointer to bonus effect
+		 * @return The effect, by value
 		 */
-		std::unique_ptr<IBonusEffect> createRandomEffect();
+		BonusEffect createRandomEffect(SimRandom& random);
 	};
 }
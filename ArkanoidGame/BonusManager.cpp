@@ -1,88 +1,122 @@
 #include "BonusManager.h"
 #include "GameSettings.h"
+#include <algorithm>
 
 namespace ArkanoidGame
 {
 	BonusManager::BonusManager()
+		: activeBonuses(MAX_FALLING_BONUSES)
 	{
 	}
 
-	void BonusManager::createBonusFromBlock(float x, float y)
+	void BonusManager::createBonusFromBlock(float x, float y, SimRandom& random, SimEventQueue& events)
 	{
-		auto bonus = factory.createBonus(x, y);
+		auto bonus = factory.createBonus(x, y, random);
 		if (bonus)
 		{
-			// Set up collection callback
-			bonus->onCollected = [this](Bonus* collectedBonus) {
-				// This will be handled in handleBonusCollection
-			};
-			
-			activeBonuses.push_back(std::move(bonus));
+			// A full pool drops the bonus; the random draws above still happen, so replays stay in sync
+			if (activeBonuses.create(*bonus))
+			{
+				events.push(SimEventType::BonusDropped, static_cast<int32_t>(GetBonusEffectType(bonus->getEffect())));
+			}
 		}
 	}
 
-	void BonusManager::updateBonuses(float timeDelta, Platform& platform, Ball& ball)
+	void BonusManager::updateBonuses(float timeDelta, Platform& platform, Ball& ball, SimEventQueue& events)
 	{
 		// Update all active bonuses
-		for (auto& bonus : activeBonuses)
+		for (Bonus& bonus : activeBonuses)
 		{
-			if (bonus && bonus->getIsActive())
+			if (bonus.getIsActive())
 			{
-				bonus->update(timeDelta);
+				bonus.update(timeDelta);
 			}
 		}
 
 		// Update active effects
-		effectManager.updateEffects(timeDelta);
+		effectManager.updateEffects(timeDelta, events);
 
-		// Update recent effects display time
-		if (!recentEffects.empty())
+		// Update recent effect display time
+		if (hasRecentEffect)
 		{
 			effectDisplayTime -= timeDelta;
 			if (effectDisplayTime <= 0.0f)
 			{
-				recentEffects.clear();
+				hasRecentEffect = false;
 				effectDisplayTime = 2.0f; // Reset for next effect
+				events.push(SimEventType::EffectEnded, static_cast<int32_t>(recentEffect));
 			}
 		}
 
 		// Check for platform collisions
-		checkPlatformCollisions(platform, ball);
+		checkPlatformCollisions(platform, ball, events);
 
 		// Remove expired bonuses
 		removeExpiredBonuses();
 	}
 
-	void BonusManager::drawBonuses(sf::RenderWindow& window)
+	void BonusManager::clearAllBonuses()
+	{
+		activeBonuses.clear();
+	}
+
+	void BonusManager::reset()
+	{
+		clearAllBonuses();
+		effectManager.clearAllEffects();
+		hasRecentEffect = false;
+		effectDisplayTime = 2.0f;
+	}
+
+	void BonusManager::addToHash(StateHasher& hasher) const
 	{
-		for (const auto& bonus : activeBonuses)
+		for (const Bonus& bonus : activeBonuses)
 		{
-			if (bonus && bonus->getIsActive())
-			{
-				bonus->draw(window);
-			}
+			hasher.add(bonus.getPosition());
+			hasher.add(GetBonusEffectType(bonus.getEffect()));
+			hasher.add(bonus.getIsCollected());
 		}
+		effectManager.addToHash(hasher);
 	}
 
-	void BonusManager::clearAllBonuses()
+	void BonusManager::saveState(State& state, std::vector<Bonus::State>& bonuses, std::vector<EffectManager::ActiveEffect>& effects) const
 	{
+		state = { recentEffect, hasRecentEffect, effectDisplayTime };
+		bonuses.clear();
+		for (const Bonus& bonus : activeBonuses)
+		{
+			bonuses.push_back(bonus.getState());
+		}
+		effectManager.saveState(effects);
+	}
+
+	void BonusManager::restoreState(const State& state, const Bonus::State* bonuses, size_t bonusCount, const EffectManager::ActiveEffect* effects, size_t effectCount, Platform& platform, Ball& ball)
+	{
+		recentEffect = state.recentEffect;
+		hasRecentEffect = state.hasRecentEffect;
+		effectDisplayTime = state.effectDisplayTime;
 		activeBonuses.clear();
+		for (size_t i = 0; i < bonusCount; ++i)
+		{
+			activeBonuses.create(bonuses[i]);
+		}
+		effectManager.restoreState(effects, effectCount, platform, ball);
 	}
 
-	void BonusManager::checkPlatformCollisions(Platform& platform, Ball& ball)
+	void BonusManager::checkPlatformCollisions(Platform& platform, Ball& ball, SimEventQueue& events)
 	{
 		sf::FloatRect platformBounds = platform.getBounds();
 		
-		for (auto& bonus : activeBonuses)
+		for (Bonus& bonus : activeBonuses)
 		{
-			if (bonus && bonus->getIsActive() && !bonus->getIsCollected())
+			if (bonus.getIsActive() && !bonus.getIsCollected())
 			{
-				sf::FloatRect bonusBounds = bonus->getBounds();
+				sf::FloatRect bonusBounds = bonus.getBounds();
 				
 				if (platformBounds.intersects(bonusBounds))
 				{
-					handleBonusCollection(bonus.get(), platform, ball);
-					bonus->collect();
+					handleBonusCollection(bonus, platform, ball, events);
+					bonus.collect();
 				}
 			}
 		}
@@ -90,70 +124,47 @@ namespace ArkanoidGame
 
 	void BonusManager::removeExpiredBonuses()
 	{
-		activeBonuses.erase(
-			std::remove_if(activeBonuses.begin(), activeBonuses.end(),
-				[](const std::unique_ptr<Bonus>& bonus) {
-					return !bonus || !bonus->getIsActive() || bonus->isExpired();
-				}),
-			activeBonuses.end()
-		);
+		activeBonuses.removeIf(
+			[](const Bonus& bonus) {
+				return !bonus.getIsActive() || bonus.isExpired();
+			});
 	}
 
-	void BonusManager::handleBonusCollection(Bonus* bonus, Platform& platform, Ball& ball)
+	void BonusManager::handleBonusCollection(const Bonus& bonus, Platform& platform, Ball& ball, SimEventQueue& events)
 	{
-		if (!bonus || !bonus->getEffect()) return;
-
-		IBonusEffect* effect = bonus->getEffect();
+		const BonusEffect& effect = bonus.getEffect();
+		const BonusEffectType type = GetBonusEffectType(effect);
 		
-		// Handle instant effects (no duration)
-		if (effect->getDuration() == 0.0f)
+		if (IsInstantBonusEffect(type))
 		{
 			// Apply instant effect
-			effect->applyEffect(platform, ball);
+			BonusEffect instantEffect = effect;
+			ApplyBonusEffect(instantEffect, platform, ball);
 			
-			// Add to recent effects for display
-			recentEffects.clear(); // Clear previous effects
-			recentEffects.push_back(effect->getEffectName());
+			// Replace the recent effect shown in the UI
+			recentEffect = type;
+			hasRecentEffect = true;
 			effectDisplayTime = 2.0f; // Reset display timer
-			
-			// Handle specific instant effects
-			if (effect->getEffectName() == "+1 Life" && onLivesChange)
-			{
-				onLivesChange(1); // Add one life
-			}
-			else if (effect->getEffectName() == "Bonus Points" && onScoreChange)
-			{
-				onScoreChange(100); // Add 100 points
-			}
 		}
 		else
 		{
-			// Handle timed effects through EffectManager
-			auto effectCopy = effect->clone();
-			if (effectCopy)
-			{
-				effectManager.applyEffect(std::move(effectCopy), platform, ball);
-			}
+			// Handle timed effects through EffectManager, which keeps its own copy
+			effectManager.applyEffect(effect, platform, ball);
 		}
 		
-		// Notify about effect application
-		if (onEffectApplied)
+		// Instant effects that change the game rather than the platform or ball carry their amount
+		int32_t value = 1;
+		switch (type)
 		{
-			onEffectApplied(effect->getEffectName());
+		case BonusEffectType::Points:
+			value = std::get<PointsBonus>(effect).getBonusPoints();
+			break;
+		case BonusEffectType::SplitBall:
+			value = std::get<SplitBallBonus>(effect).getBallsPerBall();
+			break;
+		default:
+			break;
 		}
-	}
-
-	std::vector<std::string> BonusManager::getActiveEffectNames() const
-	{
-		std::vector<std::string> allEffects;
-		
-		// Get active timed effects
-		auto activeEffects = effectManager.getActiveEffectNames();
-		allEffects.insert(allEffects.end(), activeEffects.begin(), activeEffects.end());
-		
-		// Add recent instant effects
-		allEffects.insert(allEffects.end(), recentEffects.begin(), recentEffects.end());
-		
-		return allEffects;
+		events.push(SimEventType::BonusCollected, static_cast<int32_t>(type), value);
 	}
 }
@@ -2,11 +2,13 @@
 #include "Bonus.h"
 #include "BonusFactory.h"
 #include "EffectManager.h"
+#include "FixedPool.h"
 #include "Platform.h"
 #include "Ball.h"
+#include "SimEvents.h"
+#include "StateHash.h"
+#include <cstdint>
 #include <vector>
-#include <memory>
-#include <functional>
 
 namespace ArkanoidGame
 {
@@ -17,48 +19,70 @@ namespace ArkanoidGame
 	 * - Creating bonuses when blocks are destroyed
 	 * - Managing active bonuses and their effects
 	 * - Handling bonus collection and expiration
+	 * 
+	 * Falling bonuses live by value in a fixed pool of MAX_FALLING_BONUSES, so
+	 * dropping, updating and collecting them does no heap allocation.
+	 * Collections and ended effects are reported as events; changes to score,
+	 * lives and balls are left to whoever drains the queue.
 	 */
 	class BonusManager
 	{
 	private:
-		std::vector<std::unique_ptr<Bonus>> activeBonuses;
+		FixedPool<Bonus> activeBonuses;
 		BonusFactory factory;
 		EffectManager effectManager;
 		
-		// Track all applied effects (including instant ones)
-		std::vector<std::string> recentEffects;
+		// Most recent instant effect, shown for a moment after collection
+		BonusEffectType recentEffect = BonusEffectType::Count;
+		bool hasRecentEffect = false;
 		float effectDisplayTime = 2.0f; // Show effects for 2 seconds
-		
-		// Callbacks for game state changes
-		std::function<void(int)> onScoreChange;
-		std::function<void(int)> onLivesChange;
-		std::function<void(const std::string&)> onEffectApplied;
 
 	public:
+		// Display state besides the falling bonuses and running effects, for snapshots
+		struct State
+		{
+			BonusEffectType recentEffect;
+			bool hasRecentEffect;
+			float effectDisplayTime;
+		};
+
 		BonusManager();
 		~BonusManager() = default;
 
 		// Bonus lifecycle management
-		void createBonusFromBlock(float x, float y);
-		void updateBonuses(float timeDelta, Platform& platform, Ball& ball);
-		void drawBonuses(sf::RenderWindow& window);
+		void createBonusFromBlock(float x, float y, SimRandom& random, SimEventQueue& events);
+		void updateBonuses(float timeDelta, Platform& platform, Ball& ball, SimEventQueue& events);
 		void clearAllBonuses();
+		void reset(); // Drop all bonuses and effects
 
 		// Collision detection
-		void checkPlatformCollisions(Platform& platform, Ball& ball);
+		void checkPlatformCollisions(Platform& platform, Ball& ball, SimEventQueue& events);
 
-		// Callback setters
-		void setScoreCallback(std::function<void(int)> callback) { onScoreChange = callback; }
-		void setLivesCallback(std::function<void(int)> callback) { onLivesChange = callback; }
-		void setEffectCallback(std::function<void(const std::string&)> callback) { onEffectApplied = callback; }
+		// Snapshot support: state is copied out as plain data; restoring applies no effect (see EffectManager)
+		void saveState(State& state, std::vector<Bonus::State>& bonuses, std::vector<EffectManager::ActiveEffect>& effects) const;
+		void restoreState(const State& state, const Bonus::State* bonuses, size_t bonusCount, const EffectManager::ActiveEffect* effects, size_t effectCount, Platform& platform, Ball& ball);
+
+		// Feed the falling bonuses (position, effect, collected) and the running effects into a state hash
+		void addToHash(StateHasher& hasher) const;
 
 		// Getters
 		size_t getActiveBonusCount() const { return activeBonuses.size(); }
+		const FixedPool<Bonus>& getActiveBonuses() const { return activeBonuses; }
 		bool hasActiveBonuses() const { return !activeBonuses.empty(); }
-		std::vector<std::string> getActiveEffectNames() const;
+
+		// Calls visit(BonusEffectType) for every running timed effect, then the recent instant one
+		template<typename Visitor>
+		void forEachActiveEffect(Visitor visit) const
+		{
+			effectManager.forEachActiveEffect(visit);
+			if (hasRecentEffect)
+			{
+				visit(recentEffect);
+			}
+		}
 
 	private:
 		void removeExpiredBonuses();
-		void handleBonusCollection(Bonus* bonus, Platform& platform, Ball& ball);
+		void handleBonusCollection(const Bonus& bonus, Platform& platform, Ball& ball, SimEventQueue& events);
 	};
 }
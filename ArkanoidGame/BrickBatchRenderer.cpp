@@ -0,0 +1,161 @@
+#include "BrickBatchRenderer.h"
+#include <algorithm>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const float OUTLINE_THICKNESS = 1.0f; // Drawn outside the brick, like sf::Shape outlines
+
+		void SetQuad(sf::Vertex* quad, float left, float top, float width, float height, const sf::Color& color)
+		{
+			quad[0].position = sf::Vector2f(left, top);
+			quad[1].position = sf::Vector2f(left + width, top);
+			quad[2].position = sf::Vector2f(left + width, top + height);
+			quad[3].position = sf::Vector2f(left, top + height);
+			for (int i = 0; i < 4; ++i)
+			{
+				quad[i].color = color;
+			}
+		}
+
+		void HideQuad(sf::Vertex* quad)
+		{
+			SetQuad(quad, 0.0f, 0.0f, 0.0f, 0.0f, sf::Color::Transparent);
+		}
+	}
+
+	BrickBatchRenderer::BrickBatchRenderer()
+		: vertices(sf::Quads)
+	{
+		// Regular block colors (red is reserved for DurableBricks)
+		palette[0] = sf::Color::Green;
+		palette[1] = sf::Color::Blue;
+		palette[2] = sf::Color::Yellow;
+		palette[3] = sf::Color::Magenta;
+		palette[4] = sf::Color::Cyan;
+		palette[5] = sf::Color(255, 165, 0); // Orange
+		palette[6] = sf::Color(128, 0, 128); // Purple
+		palette[7] = sf::Color(255, 192, 203); // Pink
+		palette[8] = sf::Color(0, 128, 0); // Dark Green
+	}
+
+	void BrickBatchRenderer::draw(sf::RenderTarget& target, const BrickField& bricks)
+	{
+		if (builtField != &bricks || builtLayoutVersion != bricks.getLayoutVersion())
+		{
+			rebuild(bricks);
+		}
+
+		// Only bricks hit since the last frame need new vertices
+		const size_t changeCount = bricks.getChangeCount();
+		for (; changeCursor < changeCount; ++changeCursor)
+		{
+			writeBrick(bricks, bricks.getChangedBrick(changeCursor));
+		}
+
+		target.draw(vertices);
+	}
+
+	void BrickBatchRenderer::rebuild(const BrickField& bricks)
+	{
+		vertices.resize(bricks.size() * VERTICES_PER_BRICK);
+		for (size_t i = 0; i < bricks.size(); ++i)
+		{
+			writeBrick(bricks, i);
+		}
+
+		builtField = &bricks;
+		builtLayoutVersion = bricks.getLayoutVersion();
+		changeCursor = bricks.getChangeCount();
+	}
+
+	sf::Color BrickBatchRenderer::getDurableColor(int hits, int maxHits) const
+	{
+		// DurableBricks are always red and darken towards the damaged color with each hit
+		const sf::Color originalColor = sf::Color::Red;
+		const sf::Color damagedColor(
+			static_cast<sf::Uint8>(std::max(0, originalColor.r - 80)),
+			static_cast<sf::Uint8>(std::max(0, originalColor.g - 80)),
+			static_cast<sf::Uint8>(std::max(0, originalColor.b - 80)),
+			originalColor.a);
+
+		if (hits <= 0 || hits >= maxHits)
+		{
+			return originalColor;
+		}
+
+		// Interpolate between original and damaged color
+		const float damageRatio = static_cast<float>(hits) / static_cast<float>(maxHits);
+		return sf::Color(
+			static_cast<sf::Uint8>(originalColor.r - (originalColor.r - damagedColor.r) * damageRatio),
+			static_cast<sf::Uint8>(originalColor.g - (originalColor.g - damagedColor.g) * damageRatio),
+			static_cast<sf::Uint8>(originalColor.b - (originalColor.b - damagedColor.b) * damageRatio),
+			originalColor.a);
+	}
+
+	void BrickBatchRenderer::writeBrick(const BrickField& bricks, size_t index)
+	{
+		sf::Vertex* quads = &vertices[index * VERTICES_PER_BRICK];
+		if (!bricks.isAlive(index))
+		{
+			for (size_t quad = 0; quad < QUADS_PER_BRICK; ++quad)
+			{
+				HideQuad(quads + quad * 4);
+			}
+			return;
+		}
+
+		const float x = bricks.getX(index);
+		const float y = bricks.getY(index);
+		const float width = bricks.getWidth(index);
+		const float height = bricks.getHeight(index);
+		const BlockType type = bricks.getType(index);
+
+		sf::Color fillColor;
+		sf::Color outlineColor = sf::Color::Black;
+		switch (type)
+		{
+		case BlockType::Durable:
+			fillColor = getDurableColor(bricks.getHits(index), bricks.getMaxHits(index));
+			break;
+		case BlockType::Glass:
+			fillColor = sf::Color(200, 220, 255, 100); // Light blue with transparency
+			outlineColor = sf::Color(150, 180, 220, 150); // Slightly darker outline
+			break;
+		default:
+			fillColor = palette[bricks.getColorIndex(index) % BLOCK_COLOR_COUNT];
+			break;
+		}
+
+		// Fill, then the outline strips around it
+		const float t = OUTLINE_THICKNESS;
+		SetQuad(quads + 0, x, y, width, height, fillColor);
+		SetQuad(quads + 4, x - t, y - t, width + 2 * t, t, outlineColor);
+		SetQuad(quads + 8, x - t, y + height, width + 2 * t, t, outlineColor);
+		SetQuad(quads + 12, x - t, y, t, height, outlineColor);
+		SetQuad(quads + 16, x + width, y, t, height, outlineColor);
+
+		// Damage indicator (cracks) on hit durable bricks
+		if (type == BlockType::Durable && bricks.getHits(index) > 0)
+		{
+			SetQuad(quads + 20, x + width * 0.3f, y + height * 0.2f, 2.0f, height * 0.6f, sf::Color::Black);
+			SetQuad(quads + 24, x + width * 0.7f, y + height * 0.3f, 2.0f, height * 0.4f, sf::Color::Black);
+		}
+		else
+		{
+			HideQuad(quads + 20);
+			HideQuad(quads + 24);
+		}
+
+		// Glass reflection effect
+		if (type == BlockType::Glass)
+		{
+			SetQuad(quads + 28, x + width * 0.1f, y + height * 0.1f, width * 0.3f, height * 0.2f, sf::Color(255, 255, 255, 100));
+		}
+		else
+		{
+			HideQuad(quads + 28);
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "BrickField.h"
+#include "GameSettings.h"
+#include <cstdint>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Draws a whole BrickField with one draw call
+	 * 
+	 * Every brick owns a fixed run of quads in a single vertex array: fill,
+	 * four outline strips, two cracks and a glass highlight. Unused quads are
+	 * collapsed. The array is built once per layout and afterwards only the
+	 * bricks listed in the field's change journal are rewritten.
+	 */
+	class BrickBatchRenderer
+	{
+	private:
+		static const size_t QUADS_PER_BRICK = 8;
+		static const size_t VERTICES_PER_BRICK = QUADS_PER_BRICK * 4;
+
+		sf::VertexArray vertices;
+		sf::Color palette[BLOCK_COLOR_COUNT];
+
+		// What the vertices currently show
+		const BrickField* builtField = nullptr;
+		uint32_t builtLayoutVersion = 0;
+		size_t changeCursor = 0;
+
+	public:
+		BrickBatchRenderer();
+
+		void draw(sf::RenderTarget& target, const BrickField& bricks);
+
+	private:
+		void rebuild(const BrickField& bricks);
+		void writeBrick(const BrickField& bricks, size_t index);
+		sf::Color getDurableColor(int hits, int maxHits) const;
+	};
+}
@@ -0,0 +1,355 @@
+#include "BrickField.h"
+#include "SweptCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ArkanoidGame
+{
+	void BrickField::clear()
+	{
+		x.clear();
+		y.clear();
+		width.clear();
+		height.clear();
+		points.clear();
+		hits.clear();
+		maxHits.clear();
+		types.clear();
+		colorIndices.clear();
+		aliveBits.clear();
+		aliveCount = 0;
+		aliveCountsByType.fill(0);
+		grid.clear();
+		isIndexValid = false;
+		layoutBounds = sf::FloatRect();
+		changedBricks.clear();
+		++layoutVersion;
+	}
+
+	void BrickField::reserve(size_t count)
+	{
+		x.reserve(count);
+		y.reserve(count);
+		width.reserve(count);
+		height.reserve(count);
+		points.reserve(count);
+		hits.reserve(count);
+		maxHits.reserve(count);
+		types.reserve(count);
+		colorIndices.reserve(count);
+		aliveBits.reserve((count + 63) / 64);
+	}
+
+	void BrickField::assign(const BrickColumns& columns)
+	{
+		static_assert(sizeof(int) == sizeof(int32_t) && sizeof(BlockType) == sizeof(uint8_t), "Brick columns are copied as raw bytes");
+
+		clear();
+		const size_t count = columns.count;
+		x.resize(count);
+		y.resize(count);
+		width.resize(count);
+		height.resize(count);
+		points.resize(count);
+		hits.assign(count, 0);
+		maxHits.resize(count);
+		types.resize(count);
+		colorIndices.resize(count);
+		if (count == 0)
+			return;
+
+		std::memcpy(x.data(), columns.x, count * sizeof(float));
+		std::memcpy(y.data(), columns.y, count * sizeof(float));
+		std::memcpy(width.data(), columns.width, count * sizeof(float));
+		std::memcpy(height.data(), columns.height, count * sizeof(float));
+		std::memcpy(points.data(), columns.points, count * sizeof(int32_t));
+		std::memcpy(maxHits.data(), columns.maxHits, count);
+		std::memcpy(types.data(), columns.types, count);
+		std::memcpy(colorIndices.data(), columns.colorIndices, count);
+
+		// Every brick starts alive; the bits past the last brick stay clear
+		aliveBits.assign((count + 63) / 64, ~uint64_t(0));
+		if ((count & 63) != 0)
+		{
+			aliveBits.back() = (uint64_t(1) << (count & 63)) - 1;
+		}
+		aliveCount = count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const size_t type = static_cast<size_t>(types[i]);
+			if (type < BLOCK_TYPE_COUNT)
+			{
+				++aliveCountsByType[type];
+			}
+		}
+
+		float left = x[0];
+		float top = y[0];
+		float right = x[0] + width[0];
+		float bottom = y[0] + height[0];
+		for (size_t i = 1; i < count; ++i)
+		{
+			left = std::min(left, x[i]);
+			top = std::min(top, y[i]);
+			right = std::max(right, x[i] + width[i]);
+			bottom = std::max(bottom, y[i] + height[i]);
+		}
+		layoutBounds = sf::FloatRect(left, top, right - left, bottom - top);
+	}
+
+	size_t BrickField::add(float brickX, float brickY, float brickWidth, float brickHeight, BlockType type, int brickPoints, int colorIndex, int hitsRequired)
+	{
+		const size_t index = x.size();
+		x.push_back(brickX);
+		y.push_back(brickY);
+		width.push_back(brickWidth);
+		height.push_back(brickHeight);
+		points.push_back(brickPoints);
+		hits.push_back(0);
+		maxHits.push_back(static_cast<uint8_t>(hitsRequired));
+		types.push_back(type);
+		colorIndices.push_back(static_cast<uint8_t>(colorIndex));
+
+		if ((index >> 6) >= aliveBits.size())
+		{
+			aliveBits.push_back(0);
+		}
+		aliveBits[index >> 6] |= uint64_t(1) << (index & 63);
+		++aliveCount;
+		++aliveCountsByType[static_cast<size_t>(type)];
+		isIndexValid = false;
+
+		if (index == 0)
+		{
+			layoutBounds = sf::FloatRect(brickX, brickY, brickWidth, brickHeight);
+		}
+		else
+		{
+			const float left = std::min(layoutBounds.left, brickX);
+			const float top = std::min(layoutBounds.top, brickY);
+			const float right = std::max(layoutBounds.left + layoutBounds.width, brickX + brickWidth);
+			const float bottom = std::max(layoutBounds.top + layoutBounds.height, brickY + brickHeight);
+			layoutBounds = sf::FloatRect(left, top, right - left, bottom - top);
+		}
+		++layoutVersion;
+		return index;
+	}
+
+	void BrickField::buildIndex(float cellWidth, float cellHeight)
+	{
+		grid.build(x.data(), y.data(), width.data(), height.data(), x.size(), cellWidth, cellHeight,
+			[this](size_t index) { return isAlive(index); });
+		gridCellWidth = cellWidth;
+		gridCellHeight = cellHeight;
+		isIndexValid = true;
+		isGridStale = false;
+	}
+
+	void BrickField::kill(size_t index)
+	{
+		aliveBits[index >> 6] &= ~(uint64_t(1) << (index & 63));
+		--aliveCount;
+		const size_t type = static_cast<size_t>(types[index]);
+		if (type < BLOCK_TYPE_COUNT)
+		{
+			--aliveCountsByType[type];
+		}
+		if (isIndexValid)
+		{
+			grid.remove(static_cast<uint32_t>(index), getBounds(index));
+		}
+	}
+
+	BrickHitResult BrickField::hit(size_t index)
+	{
+		BrickHitResult result;
+		switch (types[index])
+		{
+		case BlockType::Durable:
+			// Survives until it took maxHits hits, bounces the ball every time
+			++hits[index];
+			result.shouldBounce = true;
+			result.isDestroyed = hits[index] >= maxHits[index];
+			break;
+		case BlockType::Glass:
+			// Shatters at once and lets the ball pass through
+			result.shouldBounce = false;
+			result.isDestroyed = true;
+			break;
+		default:
+			result.shouldBounce = true;
+			result.isDestroyed = true;
+			break;
+		}
+
+		if (result.isDestroyed)
+		{
+			kill(index);
+		}
+		changedBricks.push_back(static_cast<uint32_t>(index));
+		return result;
+	}
+
+	int BrickField::findFirstOverlap(const sf::FloatRect& bounds) const
+	{
+		if (!isIndexValid)
+		{
+			return findFirstOverlapLinear(bounds);
+		}
+
+		const float right = bounds.left + bounds.width;
+		const float bottom = bounds.top + bounds.height;
+		uint32_t first = UINT32_MAX;
+
+		// Cells only hold live bricks; keep the lowest index so results match the linear scan
+		grid.forEachCandidate(bounds, [&](uint32_t index) {
+			if (index < first && overlaps(index, bounds.left, bounds.top, right, bottom))
+			{
+				first = index;
+			}
+		});
+		return first == UINT32_MAX ? -1 : static_cast<int>(first);
+	}
+
+	int BrickField::findFirstOverlapLinear(const sf::FloatRect& bounds) const
+	{
+		const float right = bounds.left + bounds.width;
+		const float bottom = bounds.top + bounds.height;
+		const size_t count = x.size();
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (overlaps(i, bounds.left, bounds.top, right, bottom) && isAlive(i))
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	int BrickField::findFirstImpact(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, float& time, sf::Vector2f& normal) const
+	{
+		int first = -1;
+		float bestTime = 2.0f;
+
+		auto sweep = [&](uint32_t index) {
+			float impactTime;
+			sf::Vector2f impactNormal;
+			if (!SweepCircleRect(center, radius, displacement, getBounds(index), impactTime, impactNormal))
+				return;
+
+			// Ties go to the lowest index so the grid and linear paths agree
+			if (impactTime < bestTime || (impactTime == bestTime && static_cast<int>(index) < first))
+			{
+				bestTime = impactTime;
+				normal = impactNormal;
+				first = static_cast<int>(index);
+			}
+		};
+
+		if (isIndexValid)
+		{
+			// Only cells under the swept box can hold a brick the ball reaches this move
+			const float left = std::min(center.x, center.x + displacement.x) - radius;
+			const float top = std::min(center.y, center.y + displacement.y) - radius;
+			const sf::FloatRect sweptBounds(left, top, std::abs(displacement.x) + radius * 2, std::abs(displacement.y) + radius * 2);
+			grid.forEachCandidate(sweptBounds, sweep);
+		}
+		else
+		{
+			const uint32_t count = static_cast<uint32_t>(x.size());
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (isAlive(i))
+				{
+					sweep(i);
+				}
+			}
+		}
+
+		if (first >= 0)
+		{
+			time = bestTime;
+		}
+		return first;
+	}
+
+	void BrickField::addToHash(StateHasher& hasher) const
+	{
+		hasher.addBytes(hits.data(), hits.size());
+		hasher.addBytes(aliveBits.data(), aliveBits.size() * sizeof(uint64_t));
+	}
+
+	void BrickField::restoreState(const uint8_t* brickHits, const uint64_t* brickAliveBits)
+	{
+		std::memcpy(hits.data(), brickHits, hits.size());
+
+		// Only bricks whose liveness differs change; whole words are skipped while they match
+		for (size_t word = 0; word < aliveBits.size(); ++word)
+		{
+			const uint64_t difference = aliveBits[word] ^ brickAliveBits[word];
+			if (difference == 0)
+				continue;
+
+			for (size_t bit = 0; bit < 64; ++bit)
+			{
+				if ((difference >> bit) & 1u)
+				{
+					const size_t index = word * 64 + bit;
+					if ((brickAliveBits[word] >> bit) & 1u)
+					{
+						revive(index);
+					}
+					else
+					{
+						kill(index);
+					}
+				}
+			}
+		}
+		finishRestore();
+	}
+
+	void BrickField::restoreBricks(const BrickChange* changes, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const BrickChange& change = changes[i];
+			hits[change.index] = change.hits;
+			if (change.isAlive && !isAlive(change.index))
+			{
+				revive(change.index);
+			}
+			else if (!change.isAlive && isAlive(change.index))
+			{
+				kill(change.index);
+			}
+		}
+		finishRestore();
+	}
+
+	void BrickField::revive(size_t index)
+	{
+		aliveBits[index >> 6] |= uint64_t(1) << (index & 63);
+		++aliveCount;
+		const size_t type = static_cast<size_t>(types[index]);
+		if (type < BLOCK_TYPE_COUNT)
+		{
+			++aliveCountsByType[type];
+		}
+		if (isIndexValid && !isGridStale && !grid.insert(static_cast<uint32_t>(index), getBounds(index)))
+		{
+			isGridStale = true;
+		}
+	}
+
+	void BrickField::finishRestore()
+	{
+		if (isGridStale)
+		{
+			buildIndex(gridCellWidth, gridCellHeight);
+		}
+		changedBricks.clear();
+		++layoutVersion;
+	}
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include "BrickGrid.h"
+#include "StateHash.h"
+#include "SweptCollision.h"
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Kind of brick, decides how it reacts to a hit and how it is drawn
+	 */
+	enum class BlockType : uint8_t
+	{
+		Regular, // Destroyed by one hit, bounces the ball
+		Durable, // Needs several hits, bounces the ball every time
+		Glass    // Destroyed by one hit, the ball passes through
+	};
+
+	constexpr size_t BLOCK_TYPE_COUNT = 3;
+
+	// State of one brick before a change, as kept by the rewind buffer
+	struct BrickChange
+	{
+		uint32_t index;
+		uint8_t hits;
+		uint8_t isAlive;
+	};
+
+	/**
+	 * @brief Result of a ball hitting a brick
+	 */
+	struct BrickHitResult
+	{
+		bool shouldBounce = false;
+		bool isDestroyed = false;
+	};
+
+	/**
+	 * @brief Read-only brick columns of a whole layout, for example a level mapped from disk
+	 */
+	struct BrickColumns
+	{
+		size_t count = 0;
+		const float* x = nullptr;
+		const float* y = nullptr;
+		const float* width = nullptr;
+		const float* height = nullptr;
+		const int32_t* points = nullptr;
+		const uint8_t* maxHits = nullptr;
+		const uint8_t* types = nullptr;       // BlockType values
+		const uint8_t* colorIndices = nullptr;
+	};
+
+	/**
+	 * @brief Structure-of-arrays storage for all bricks of a level
+	 * 
+	 * Every brick property lives in its own contiguous column, and liveness is a
+	 * packed bitset. Collision and drawing walk the columns linearly instead of
+	 * chasing one heap pointer and virtual call per brick, and live bricks are
+	 * counted as they die, so the win check reads a counter.
+	 * After buildIndex() overlap queries go through a BrickGrid, which is kept
+	 * up to date as bricks die. Every hit is also appended to a change journal,
+	 * so views can update only the bricks that changed.
+	 */
+	class BrickField
+	{
+	private:
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> width;
+		std::vector<float> height;
+		std::vector<int> points;
+		std::vector<uint8_t> hits;      // Hits received so far
+		std::vector<uint8_t> maxHits;   // Hits needed to destroy the brick
+		std::vector<BlockType> types;
+		std::vector<uint8_t> colorIndices; // Index into the renderer palette
+		std::vector<uint64_t> aliveBits;   // Bit i set while brick i is alive
+		size_t aliveCount = 0;             // Set bits in aliveBits, kept up to date as bricks are added and die
+		std::array<size_t, BLOCK_TYPE_COUNT> aliveCountsByType = {};
+		BrickGrid grid;
+		float gridCellWidth = 0.0f;        // Cell size of the last buildIndex(), for rebuilding after a restore
+		float gridCellHeight = 0.0f;
+		bool isIndexValid = false;         // Cleared by add(), set by buildIndex()
+		sf::FloatRect layoutBounds;        // Box around every brick added since clear()
+
+		// Change journal for incremental consumers such as the renderer
+		uint32_t layoutVersion = 0;          // Bumped whenever bricks are added, cleared or restored
+		std::vector<uint32_t> changedBricks; // Bricks hit since the last layout change, in hit order
+		bool isGridStale = false;            // A restored brick did not fit back into its grid cells
+
+	public:
+		void clear();
+		void reserve(size_t count);
+
+		// Replace all bricks with a complete layout, copying each column in one block; call buildIndex() afterwards
+		void assign(const BrickColumns& columns);
+
+		// Add a live brick and return its index
+		size_t add(float brickX, float brickY, float brickWidth, float brickHeight, BlockType type, int brickPoints, int colorIndex, int hitsRequired = 1);
+
+		// Build the grid broadphase over the current bricks; call after the layout is complete
+		void buildIndex(float cellWidth, float cellHeight);
+		bool hasIndex() const { return isIndexValid; }
+
+		/**
+		 * @brief Registers a hit on a live brick
+		 * @return Whether the ball should bounce and whether the brick was destroyed
+		 */
+		BrickHitResult hit(size_t index);
+
+		// Index of the first (lowest index) live brick overlapping bounds, or -1
+		int findFirstOverlap(const sf::FloatRect& bounds) const;
+
+		// Same result as findFirstOverlap, always testing every brick
+		int findFirstOverlapLinear(const sf::FloatRect& bounds) const;
+
+		/**
+		 * @brief Earliest live brick hit by a circle moving by displacement
+		 * @param time Receives the impact time as a fraction of the move
+		 * @param normal Receives the brick surface normal at the contact
+		 * @return Brick index, or -1 if the path is clear
+		 */
+		int findFirstImpact(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, float& time, sf::Vector2f& normal) const;
+
+		/**
+		 * @brief findFirstImpact for long paths, such as a ball traced to where it comes down
+		 * 
+		 * Walks the grid row by row along the path and stops after the row of the
+		 * first hit, so the cost follows the cells actually crossed.
+		 * @param isIgnored Callable returning true for bricks to pass through, e.g. ones a prediction already broke
+		 */
+		template<typename IsIgnored>
+		int traceImpact(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, float& time, sf::Vector2f& normal, IsIgnored isIgnored) const;
+
+		// Feed the mutable per-brick state (hits and liveness) into a state hash
+		void addToHash(StateHasher& hasher) const;
+
+		/**
+		 * @brief Snapshot support: the per-brick state is the hits column and the alive bitset
+		 *
+		 * The layout itself never changes during play, so only these are saved.
+		 * Restoring puts revived bricks back into the grid and bumps the layout
+		 * version, so journal readers start over.
+		 */
+		const uint8_t* getHitsData() const { return hits.data(); }
+		const uint64_t* getAliveBitsData() const { return aliveBits.data(); }
+		size_t getAliveWordCount() const { return aliveBits.size(); }
+		void restoreState(const uint8_t* brickHits, const uint64_t* brickAliveBits);
+		void restoreBricks(const BrickChange* changes, size_t count);
+
+		// Box around every brick of the layout, dead or alive; empty without bricks
+		sf::FloatRect getLayoutBounds() const { return layoutBounds; }
+
+		// True while at least one brick is alive; O(1)
+		bool hasAliveBricks() const { return aliveCount != 0; }
+
+		// Live bricks, in total and of one type; O(1)
+		size_t getAliveCount() const { return aliveCount; }
+		size_t getAliveCount(BlockType type) const { return aliveCountsByType[static_cast<size_t>(type)]; }
+
+		// Change journal: compare layout versions, then read changed bricks from a saved position
+		uint32_t getLayoutVersion() const { return layoutVersion; }
+		size_t getChangeCount() const { return changedBricks.size(); }
+		uint32_t getChangedBrick(size_t change) const { return changedBricks[change]; }
+
+		// Getters
+		size_t size() const { return x.size(); }
+		bool isAlive(size_t index) const { return (aliveBits[index >> 6] >> (index & 63)) & 1u; }
+		sf::FloatRect getBounds(size_t index) const { return sf::FloatRect(x[index], y[index], width[index], height[index]); }
+		float getX(size_t index) const { return x[index]; }
+		float getY(size_t index) const { return y[index]; }
+		float getWidth(size_t index) const { return width[index]; }
+		float getHeight(size_t index) const { return height[index]; }
+		int getPoints(size_t index) const { return points[index]; }
+		int getHits(size_t index) const { return hits[index]; }
+		int getMaxHits(size_t index) const { return maxHits[index]; }
+		BlockType getType(size_t index) const { return types[index]; }
+		int getColorIndex(size_t index) const { return colorIndices[index]; }
+
+	private:
+		void kill(size_t index);
+		void revive(size_t index);
+		void finishRestore();
+		bool overlaps(size_t index, float left, float top, float right, float bottom) const
+		{
+			// Same strict test as sf::Rect::intersects, on the raw columns
+			return left < x[index] + width[index] && x[index] < right &&
+				top < y[index] + height[index] && y[index] < bottom;
+		}
+	};
+
+	template<typename IsIgnored>
+	int BrickField::traceImpact(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, float& time, sf::Vector2f& normal, IsIgnored isIgnored) const
+	{
+		int first = -1;
+		float bestTime = 2.0f;
+		auto sweep = [&](uint32_t index) {
+			float impactTime;
+			sf::Vector2f impactNormal;
+			if (!isIgnored(index) && SweepCircleRect(center, radius, displacement, getBounds(index), impactTime, impactNormal) &&
+				(impactTime < bestTime || (impactTime == bestTime && static_cast<int>(index) < first)))
+			{
+				bestTime = impactTime;
+				normal = impactNormal;
+				first = static_cast<int>(index);
+			}
+			return bestTime;
+		};
+
+		if (isIndexValid)
+		{
+			grid.forEachCandidateAlongPath(center, displacement, radius, sweep);
+		}
+		else
+		{
+			const uint32_t count = static_cast<uint32_t>(x.size());
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (isAlive(i))
+				{
+					sweep(i);
+				}
+			}
+		}
+
+		if (first >= 0)
+		{
+			time = bestTime;
+		}
+		return first;
+	}
+}
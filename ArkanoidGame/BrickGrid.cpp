@@ -0,0 +1,88 @@
+#include "BrickGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ArkanoidGame
+{
+	void BrickGrid::clear()
+	{
+		columns = 0;
+		rows = 0;
+		cellStart.clear();
+		cellLiveCount.clear();
+		cellBricks.clear();
+	}
+
+	void BrickGrid::remove(uint32_t index, const sf::FloatRect& bounds)
+	{
+		int firstColumn, firstRow, lastColumn, lastRow;
+		if (!getCellRange(bounds, firstColumn, firstRow, lastColumn, lastRow))
+			return;
+
+		for (int row = firstRow; row <= lastRow; ++row)
+		{
+			for (int column = firstColumn; column <= lastColumn; ++column)
+			{
+				const size_t cell = static_cast<size_t>(row) * columns + column;
+				uint32_t* begin = cellBricks.data() + cellStart[cell];
+				uint32_t* end = begin + cellLiveCount[cell];
+				uint32_t* found = std::find(begin, end, index);
+				if (found != end)
+				{
+					// Swap with the last live entry; order inside a cell does not matter
+					*found = *(end - 1);
+					--cellLiveCount[cell];
+				}
+			}
+		}
+	}
+
+	bool BrickGrid::insert(uint32_t index, const sf::FloatRect& bounds)
+	{
+		int firstColumn, firstRow, lastColumn, lastRow;
+		if (!getCellRange(bounds, firstColumn, firstRow, lastColumn, lastRow))
+			return true;
+
+		// Cells keep the slots of removed bricks, so a brick that was built in always fits; check all before changing any
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			for (int row = firstRow; row <= lastRow; ++row)
+			{
+				for (int column = firstColumn; column <= lastColumn; ++column)
+				{
+					const size_t cell = static_cast<size_t>(row) * columns + column;
+					if (pass == 0)
+					{
+						if (cellStart[cell] + cellLiveCount[cell] >= cellStart[cell + 1])
+							return false;
+					}
+					else
+					{
+						cellBricks[cellStart[cell] + cellLiveCount[cell]++] = index;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	bool BrickGrid::getCellRange(const sf::FloatRect& bounds, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const
+	{
+		if (isEmpty())
+			return false;
+
+		const float left = (bounds.left - originX) / cellWidth;
+		const float top = (bounds.top - originY) / cellHeight;
+		const float right = (bounds.left + bounds.width - originX) / cellWidth;
+		const float bottom = (bounds.top + bounds.height - originY) / cellHeight;
+
+		if (right < 0.0f || bottom < 0.0f || left >= static_cast<float>(columns) || top >= static_cast<float>(rows))
+			return false;
+
+		firstColumn = std::max(0, static_cast<int>(std::floor(left)));
+		firstRow = std::max(0, static_cast<int>(std::floor(top)));
+		lastColumn = std::min(columns - 1, static_cast<int>(std::floor(right)));
+		lastRow = std::min(rows - 1, static_cast<int>(std::floor(bottom)));
+		return true;
+	}
+}
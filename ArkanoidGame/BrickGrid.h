@@ -0,0 +1,208 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Uniform grid broadphase over the bricks of a BrickField
+	 * 
+	 * Each cell lists the live bricks overlapping it, stored back to back in one
+	 * array (cell c owns cellBricks[cellStart[c] .. cellStart[c] + cellLiveCount[c])).
+	 * A query only visits the cells under the given rectangle, and a destroyed
+	 * brick is swapped out of its cells so later queries never see it again.
+	 */
+	class BrickGrid
+	{
+	private:
+		float originX = 0.0f;
+		float originY = 0.0f;
+		float cellWidth = 1.0f;
+		float cellHeight = 1.0f;
+		int columns = 0;
+		int rows = 0;
+		std::vector<uint32_t> cellStart;
+		std::vector<uint32_t> cellLiveCount;
+		std::vector<uint32_t> cellBricks;
+
+	public:
+		/**
+		 * @brief Rebuilds the grid from brick columns
+		 * @param isAlive Callable returning whether brick i is alive; dead bricks are left out
+		 */
+		template<typename IsAlive>
+		void build(const float* x, const float* y, const float* width, const float* height, size_t count, float gridCellWidth, float gridCellHeight, IsAlive isAlive);
+
+		void clear();
+
+		// Removes brick index (with the given bounds) from all cells it was in
+		void remove(uint32_t index, const sf::FloatRect& bounds);
+
+		// Puts a removed brick back; false if one of its cells has no free slot (it was dead when the grid was built)
+		bool insert(uint32_t index, const sf::FloatRect& bounds);
+
+		// Calls visit(brickIndex) for every live brick in the cells overlapped by bounds
+		template<typename Visit>
+		void forEachCandidate(const sf::FloatRect& bounds, Visit visit) const;
+
+		/**
+		 * @brief Visits the cells a circle sweeps, one grid row at a time in the direction of travel
+		 * 
+		 * In each row only the cells under the part of the path inside that row are
+		 * visited, so a long diagonal path costs its length in cells rather than the
+		 * area of its bounding box. visit(brickIndex) returns the earliest impact
+		 * found so far as a fraction of displacement (above 1 for none); rows the
+		 * circle only reaches later than that are not visited.
+		 */
+		template<typename Visit>
+		void forEachCandidateAlongPath(const sf::Vector2f& start, const sf::Vector2f& displacement, float radius, Visit visit) const;
+
+		bool isEmpty() const { return columns == 0 || rows == 0; }
+
+	private:
+		// Cell range covered by bounds, clamped to the grid; false if bounds miss the grid
+		bool getCellRange(const sf::FloatRect& bounds, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const;
+	};
+
+	template<typename IsAlive>
+	void BrickGrid::build(const float* x, const float* y, const float* width, const float* height, size_t count, float gridCellWidth, float gridCellHeight, IsAlive isAlive)
+	{
+		clear();
+		if (count == 0)
+			return;
+
+		// Grid covers the bounding box of all bricks
+		float minX = x[0], minY = y[0], maxX = x[0] + width[0], maxY = y[0] + height[0];
+		for (size_t i = 1; i < count; ++i)
+		{
+			minX = std::min(minX, x[i]);
+			minY = std::min(minY, y[i]);
+			maxX = std::max(maxX, x[i] + width[i]);
+			maxY = std::max(maxY, y[i] + height[i]);
+		}
+
+		originX = minX;
+		originY = minY;
+		cellWidth = gridCellWidth;
+		cellHeight = gridCellHeight;
+		columns = static_cast<int>((maxX - minX) / cellWidth) + 1;
+		rows = static_cast<int>((maxY - minY) / cellHeight) + 1;
+
+		const size_t cellCount = static_cast<size_t>(columns) * static_cast<size_t>(rows);
+		cellStart.assign(cellCount + 1, 0);
+		cellLiveCount.assign(cellCount, 0);
+
+		// First pass counts bricks per cell, second pass fills the packed array
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (!isAlive(i))
+					continue;
+
+				int firstColumn, firstRow, lastColumn, lastRow;
+				getCellRange(sf::FloatRect(x[i], y[i], width[i], height[i]), firstColumn, firstRow, lastColumn, lastRow);
+				for (int row = firstRow; row <= lastRow; ++row)
+				{
+					for (int column = firstColumn; column <= lastColumn; ++column)
+					{
+						const size_t cell = static_cast<size_t>(row) * columns + column;
+						if (pass == 0)
+						{
+							++cellStart[cell + 1];
+						}
+						else
+						{
+							cellBricks[cellStart[cell] + cellLiveCount[cell]++] = static_cast<uint32_t>(i);
+						}
+					}
+				}
+			}
+
+			if (pass == 0)
+			{
+				for (size_t cell = 0; cell < cellCount; ++cell)
+				{
+					cellStart[cell + 1] += cellStart[cell];
+				}
+				cellBricks.resize(cellStart[cellCount]);
+			}
+		}
+	}
+
+	template<typename Visit>
+	void BrickGrid::forEachCandidate(const sf::FloatRect& bounds, Visit visit) const
+	{
+		int firstColumn, firstRow, lastColumn, lastRow;
+		if (!getCellRange(bounds, firstColumn, firstRow, lastColumn, lastRow))
+			return;
+
+		for (int row = firstRow; row <= lastRow; ++row)
+		{
+			for (int column = firstColumn; column <= lastColumn; ++column)
+			{
+				const size_t cell = static_cast<size_t>(row) * columns + column;
+				const uint32_t* brick = cellBricks.data() + cellStart[cell];
+				const uint32_t* end = brick + cellLiveCount[cell];
+				for (; brick != end; ++brick)
+				{
+					visit(*brick);
+				}
+			}
+		}
+	}
+
+	template<typename Visit>
+	void BrickGrid::forEachCandidateAlongPath(const sf::Vector2f& start, const sf::Vector2f& displacement, float radius, Visit visit) const
+	{
+		int firstColumn, firstRow, lastColumn, lastRow;
+		const float pathLeft = std::min(start.x, start.x + displacement.x) - radius;
+		const float pathTop = std::min(start.y, start.y + displacement.y) - radius;
+		const sf::FloatRect pathBounds(pathLeft, pathTop, std::abs(displacement.x) + radius * 2, std::abs(displacement.y) + radius * 2);
+		if (!getCellRange(pathBounds, firstColumn, firstRow, lastColumn, lastRow))
+			return;
+
+		const bool isMovingDown = displacement.y >= 0.0f;
+		const int rowStep = isMovingDown ? 1 : -1;
+		const int endRow = isMovingDown ? lastRow + 1 : firstRow - 1;
+		float earliestHit = 2.0f;
+		for (int row = isMovingDown ? firstRow : lastRow; row != endRow; row += rowStep)
+		{
+			// Part of the move during which the circle overlaps this row
+			float enterTime = 0.0f;
+			float exitTime = 1.0f;
+			if (displacement.y != 0.0f)
+			{
+				const float rowTop = originY + cellHeight * static_cast<float>(row) - radius;
+				const float rowBottom = rowTop + cellHeight + radius * 2;
+				const float topTime = (rowTop - start.y) / displacement.y;
+				const float bottomTime = (rowBottom - start.y) / displacement.y;
+				enterTime = std::max(0.0f, std::min(topTime, bottomTime));
+				exitTime = std::min(1.0f, std::max(topTime, bottomTime));
+			}
+			if (enterTime > earliestHit)
+				break;
+
+			const float enterX = start.x + displacement.x * enterTime;
+			const float exitX = start.x + displacement.x * exitTime;
+			const float left = (std::min(enterX, exitX) - radius - originX) / cellWidth;
+			const float right = (std::max(enterX, exitX) + radius - originX) / cellWidth;
+			const int rowFirstColumn = std::max(firstColumn, static_cast<int>(std::floor(left)));
+			const int rowLastColumn = std::min(lastColumn, static_cast<int>(std::floor(right)));
+			for (int column = rowFirstColumn; column <= rowLastColumn; ++column)
+			{
+				const size_t cell = static_cast<size_t>(row) * columns + column;
+				const uint32_t* brick = cellBricks.data() + cellStart[cell];
+				const uint32_t* end = brick + cellLiveCount[cell];
+				for (; brick != end; ++brick)
+				{
+					earliestHit = std::min(earliestHit, visit(*brick));
+				}
+			}
+		}
+	}
+}
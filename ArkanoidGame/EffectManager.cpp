@@ -1,10 +1,11 @@
 #include "EffectManager.h"
+#include "GameSettings.h"
 #include <algorithm>
 
 namespace ArkanoidGame
 {
 	EffectManager::EffectManager()
-		: platform(nullptr), ball(nullptr)
+		: activeEffects(MAX_ACTIVE_EFFECTS), platform(nullptr), ball(nullptr)
 	{
 	}
 
@@ -14,25 +15,30 @@ namespace ArkanoidGame
 		clearAllEffects();
 	}
 
-	void EffectManager::applyEffect(std::unique_ptr<IBonusEffect> effect, Platform& platform, Ball& ball)
+	void EffectManager::applyEffect(const BonusEffect& effect, Platform& platform, Ball& ball)
 	{
-		if (!effect) return;
-
 		// Set references for cleanup
 		setReferences(platform, ball);
 
-		// Apply the effect immediately
-		effect->applyEffect(platform, ball);
+		// Instant effects are applied and forgotten
+		float duration = GetBonusEffectDuration(effect);
+		if (duration <= 0.0f)
+		{
+			BonusEffect instantEffect = effect;
+			ApplyBonusEffect(instantEffect, platform, ball);
+			return;
+		}
 
-		// Add to active effects list
-		float duration = effect->getDuration();
-		if (duration > 0.0f) // Only track effects with duration
+		// Only track effects with duration; if every slot is taken the effect is
+		// skipped rather than applied with no way to remove it later
+		ActiveEffect* activeEffect = activeEffects.create(effect, duration);
+		if (activeEffect)
 		{
-			activeEffects.emplace_back(std::move(effect), duration);
+			ApplyBonusEffect(activeEffect->effect, platform, ball);
 		}
 	}
 
-	void EffectManager::updateEffects(float timeDelta)
+	void EffectManager::updateEffects(float timeDelta, SimEventQueue& events)
 	{
 		if (activeEffects.empty()) return;
 
@@ -46,7 +52,7 @@ namespace ArkanoidGame
 		}
 
 		// Remove expired effects
-		removeExpiredEffects();
+		removeExpiredEffects(events);
 	}
 
 	void EffectManager::clearAllEffects()
@@ -54,51 +60,62 @@ namespace ArkanoidGame
 		// Remove all effects and restore original state
 		for (auto& activeEffect : activeEffects)
 		{
-			if (activeEffect.isActive && activeEffect.effect && platform && ball)
+			if (activeEffect.isActive && platform && ball)
 			{
-				activeEffect.effect->removeEffect(*platform, *ball);
+				RemoveBonusEffect(activeEffect.effect, *platform, *ball);
 			}
 		}
 		activeEffects.clear();
 	}
 
-	std::vector<std::string> EffectManager::getActiveEffectNames() const
+	void EffectManager::addToHash(StateHasher& hasher) const
 	{
-		std::vector<std::string> names;
-		for (const auto& activeEffect : activeEffects)
+		hasher.add(static_cast<uint32_t>(activeEffects.size()));
+		for (const ActiveEffect& activeEffect : activeEffects)
 		{
-			if (activeEffect.isActive && activeEffect.effect)
-			{
-				names.push_back(activeEffect.effect->getEffectName());
-			}
+			hasher.add(GetBonusEffectType(activeEffect.effect));
+			hasher.add(activeEffect.remainingTime);
+			hasher.add(activeEffect.isActive);
+		}
+	}
+
+	void EffectManager::saveState(std::vector<ActiveEffect>& effects) const
+	{
+		effects.assign(activeEffects.begin(), activeEffects.end());
+	}
+
+	void EffectManager::restoreState(const ActiveEffect* effects, size_t count, Platform& platform, Ball& ball)
+	{
+		setReferences(platform, ball);
+		activeEffects.clear();
+		for (size_t i = 0; i < count; ++i)
+		{
+			activeEffects.create(effects[i]);
 		}
-		return names;
 	}
 
-	void EffectManager::removeExpiredEffects()
+	void EffectManager::removeExpiredEffects(SimEventQueue& events)
 	{
 		// Remove expired effects
-		activeEffects.erase(
-			std::remove_if(activeEffects.begin(), activeEffects.end(),
-				[this](ActiveEffect& activeEffect) {
-					if (!activeEffect.isActive || !activeEffect.effect)
-						return true;
+		activeEffects.removeIf(
+			[this, &events](ActiveEffect& activeEffect) {
+				if (!activeEffect.isActive)
+					return true;
 
-					// Check if effect has expired
-					if (activeEffect.remainingTime <= 0.0f)
+				// Check if effect has expired
+				if (activeEffect.remainingTime <= 0.0f)
+				{
+					// Remove the effect
+					if (platform && ball)
 					{
-						// Remove the effect
-						if (platform && ball)
-						{
-							activeEffect.effect->removeEffect(*platform, *ball);
-						}
-						activeEffect.isActive = false;
-						return true;
+						RemoveBonusEffect(activeEffect.effect, *platform, *ball);
 					}
-					return false;
-				}),
-			activeEffects.end()
-		);
+					activeEffect.isActive = false;
+					events.push(SimEventType::EffectEnded, static_cast<int32_t>(GetBonusEffectType(activeEffect.effect)));
+					return true;
+				}
+				return false;
+			});
 	}
 
 	void EffectManager::setReferences(Platform& platformRef, Ball& ballRef)
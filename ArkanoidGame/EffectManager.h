@@ -2,8 +2,11 @@
 #include "BonusEffects.h"
 #include "Platform.h"
 #include "Ball.h"
+#include "FixedPool.h"
+#include "SimEvents.h"
+#include "StateHash.h"
+#include <cstdint>
 #include <vector>
-#include <memory>
 
 namespace ArkanoidGame
 {
@@ -11,24 +14,27 @@ namespace ArkanoidGame
 	 * @brief Manages active bonus effects and their timers
 	 * 
 	 * Tracks active effects, applies them, and removes them when they expire.
-	 * Uses RAII pattern to ensure effects are properly cleaned up.
+	 * Uses RAII pattern to ensure effects are properly cleaned up. Effects are
+	 * stored by value in a fixed pool, so applying one never allocates.
 	 */
 	class EffectManager
 	{
-	private:
+	public:
+		// A running effect; plain data, so snapshots copy it as it is
 		struct ActiveEffect
 		{
-			std::unique_ptr<IBonusEffect> effect;
+			BonusEffect effect;
 			float remainingTime;
 			bool isActive;
 
-			ActiveEffect(std::unique_ptr<IBonusEffect> eff, float dur)
-				: effect(std::move(eff)), remainingTime(dur), isActive(true)
+			ActiveEffect(const BonusEffect& eff, float dur)
+				: effect(eff), remainingTime(dur), isActive(true)
 			{
 			}
 		};
 
-		std::vector<ActiveEffect> activeEffects;
+	private:
+		FixedPool<ActiveEffect> activeEffects; // MAX_ACTIVE_EFFECTS slots, reserved up front
 		Platform* platform;
 		Ball* ball;
 
@@ -37,19 +43,41 @@ namespace ArkanoidGame
 		~EffectManager();
 
 		// Effect management
-		void applyEffect(std::unique_ptr<IBonusEffect> effect, Platform& platform, Ball& ball);
-		void updateEffects(float timeDelta);
+		void applyEffect(const BonusEffect& effect, Platform& platform, Ball& ball);
+		void updateEffects(float timeDelta, SimEventQueue& events); // Pushes EffectEnded for every expired effect
 		void clearAllEffects();
 
+		/**
+		 * @brief Snapshot support: copies the running effects out, or replaces them
+		 *
+		 * restoreState() does not apply or remove any effect: the platform and
+		 * ball are restored from the same snapshot, already carrying them.
+		 */
+		void saveState(std::vector<ActiveEffect>& effects) const;
+		void restoreState(const ActiveEffect* effects, size_t count, Platform& platform, Ball& ball);
+
+		// Feed the type and remaining time of every running effect into a state hash
+		void addToHash(StateHasher& hasher) const;
+
 		// Getters
 		bool hasActiveEffects() const { return !activeEffects.empty(); }
 		size_t getActiveEffectCount() const { return activeEffects.size(); }
 		
-		// Get active effect names for UI
-		std::vector<std::string> getActiveEffectNames() const;
+		// Calls visit(BonusEffectType) for every running effect, oldest first
+		template<typename Visitor>
+		void forEachActiveEffect(Visitor visit) const
+		{
+			for (const ActiveEffect& activeEffect : activeEffects)
+			{
+				if (activeEffect.isActive)
+				{
+					visit(GetBonusEffectType(activeEffect.effect));
+				}
+			}
+		}
 
 	private:
-		void removeExpiredEffects();
+		void removeExpiredEffects(SimEventQueue& events);
 		void setReferences(Platform& platform, Ball& ball);
 	};
 }
@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Fixed-capacity storage for short-lived objects of one type
+	 *
+	 * All memory is reserved once in the constructor; create() and removeIf()
+	 * never allocate afterwards. Objects stay densely packed and in creation
+	 * order, so iterating them is a plain array walk and the simulation order
+	 * (and therefore its state hash) does not depend on the pool.
+	 */
+	template<typename T>
+	class FixedPool
+	{
+	private:
+		std::vector<T> items;
+		size_t capacity;
+		size_t rejectedCount = 0; // create() calls refused because the pool was full
+
+	public:
+		explicit FixedPool(size_t poolCapacity)
+			: capacity(poolCapacity)
+		{
+			items.reserve(capacity);
+		}
+
+		/**
+		 * @brief Constructs a new object in place
+		 * @return Pointer to the object, valid until the next removeIf/clear, or nullptr if the pool is full
+		 */
+		template<typename... Args>
+		T* create(Args&&... args)
+		{
+			if (items.size() >= capacity)
+			{
+				++rejectedCount;
+				return nullptr;
+			}
+			items.emplace_back(std::forward<Args>(args)...);
+			return &items.back();
+		}
+
+		// Drop every object the predicate returns true for, keeping the order of the rest
+		template<typename Predicate>
+		void removeIf(Predicate predicate)
+		{
+			items.erase(std::remove_if(items.begin(), items.end(), predicate), items.end());
+		}
+
+		void clear() { items.clear(); }
+
+		size_t size() const { return items.size(); }
+		bool empty() const { return items.empty(); }
+		size_t getCapacity() const { return capacity; }
+		size_t getRejectedCount() const { return rejectedCount; }
+
+		T& operator[](size_t index) { return items[index]; }
+		const T& operator[](size_t index) const { return items[index]; }
+
+		typename std::vector<T>::iterator begin() { return items.begin(); }
+		typename std::vector<T>::iterator end() { return items.end(); }
+		typename std::vector<T>::const_iterator begin() const { return items.begin(); }
+		typename std::vector<T>::const_iterator end() const { return items.end(); }
+	};
+}
@@ -6,18 +6,53 @@
 #include "GameStateExitDialog.h"
 #include "GameStateRecords.h"
 #include "GameStateNameInput.h"
+#include "GameStateVersus.h"
+#include "Profiler.h"
 #include <algorithm>
-#include <climits>
 #include <fstream>
-#include <sstream>
 
 namespace ArkanoidGame
 {
+	namespace
+	{
+		// Profiling zone names of handleWindowEvent, update and draw, indexed by GameStateType
+		const char* const STATE_ZONE_NAMES[][3] = {
+			{ "None::handleWindowEvent", "None::update", "None::draw" },
+			{ "MainMenu::handleWindowEvent", "MainMenu::update", "MainMenu::draw" },
+			{ "Playing::handleWindowEvent", "Playing::update", "Playing::draw" },
+			{ "GameOver::handleWindowEvent", "GameOver::update", "GameOver::draw" },
+			{ "Win::handleWindowEvent", "Win::update", "Win::draw" },
+			{ "ExitDialog::handleWindowEvent", "ExitDialog::update", "ExitDialog::draw" },
+			{ "Records::handleWindowEvent", "Records::update", "Records::draw" },
+			{ "NameInput::handleWindowEvent", "NameInput::update", "NameInput::draw" },
+			{ "Versus::handleWindowEvent", "Versus::update", "Versus::draw" },
+		};
+
+		const char* GetStateZoneName(GameStateType type, int method)
+		{
+			return STATE_ZONE_NAMES[static_cast<int>(type)][method];
+		}
+	}
+
 	Game::Game()
+		: profilerOverlay(resources), leaderboard(MAX_RECORDS), recordsStore(RECORDS_FILE)
 	{
+		// Read every font and sound once, so state switches never touch the disk
+		resources.PreloadAll();
+
+		// Map the level pack; a missing pack leaves generated layouts
+		levels.open(LEVEL_PACK_FILE);
+
 		// Load records from file, or use default if file doesn't exist
 		LoadRecordsFromFile();
 
+		// Build every state once, after the records they show; switches then only enter and exit them
+		for (size_t i = 1; i < GAME_STATE_TYPE_COUNT; ++i)
+		{
+			stateCache[i] = CreateGameState(*this, static_cast<GameStateType>(i));
+		}
+		stateStack.reserve(GAME_STATE_TYPE_COUNT);
+
 		stateChangeType = GameStateChangeType::None;
 		pendingGameStateType = GameStateType::None;
 		pendingGameStateIsExclusivelyVisible = false;
@@ -26,13 +61,14 @@ namespace ArkanoidGame
 
 	Game::~Game()
 	{
-		// Save records before shutting down
-		SaveRecordsToFile();
+		// Every record was appended to the log when it was added, so there is nothing left to save
 		Shutdown();
 	}
 
 	void Game::HandleWindowEvents(sf::RenderWindow& window)
 	{
+		PROFILE_ZONE("Game::HandleWindowEvents");
+
 		sf::Event event;
 		while (window.pollEvent(event))
 		{
@@ -42,8 +78,21 @@ namespace ArkanoidGame
 				window.close();
 			}
 
+			// Profiler controls work in every state
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3)
+			{
+				isProfilerOverlayVisible = !isProfilerOverlayVisible;
+				continue;
+			}
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4)
+			{
+				Profiler::Instance().ExportChromeTrace(PROFILE_TRACE_FILE);
+				continue;
+			}
+
 			if (stateStack.size() > 0)
 			{
+				PROFILE_ZONE(GetStateZoneName(stateStack.back().type, 0));
 				stateStack.back().data->handleWindowEvent(event);
 			}
 		}
@@ -51,37 +100,16 @@ namespace ArkanoidGame
 
 	bool Game::Update(float timeDelta)
 	{
-		if (stateChangeType == GameStateChangeType::Switch)
-		{
-			// Clear all game states
-			stateStack.clear();
-		}
-		else if (stateChangeType == GameStateChangeType::Pop)
-		{
-			// Remove only current game state
-			if (stateStack.size() > 0)
-			{
-				stateStack.pop_back();
-			}
-		}
+		PROFILE_ZONE("Game::Update");
 
-		// Initialize new game state if needed
-		if (pendingGameStateType != GameStateType::None)
+		if (stateChangeType != GameStateChangeType::None || pendingGameStateType != GameStateType::None)
 		{
-			auto newState = CreateGameState(pendingGameStateType);
-			if (newState)
-			{
-				newState->setGame(this);
-				stateStack.push_back({ pendingGameStateType, std::move(newState), pendingGameStateIsExclusivelyVisible });
-			}
+			ApplyPendingStateChange();
 		}
 
-		stateChangeType = GameStateChangeType::None;
-		pendingGameStateType = GameStateType::None;
-		pendingGameStateIsExclusivelyVisible = false;
-
 		if (stateStack.size() > 0)
 		{
+			PROFILE_ZONE(GetStateZoneName(stateStack.back().type, 1));
 			stateStack.back().data->update(timeDelta);
 			return true;
 		}
@@ -89,30 +117,81 @@ namespace ArkanoidGame
 		return false;
 	}
 
-	void Game::Draw(sf::RenderWindow& window)
+	void Game::Draw(sf::RenderWindow& window, float interpolation)
 	{
+		PROFILE_ZONE("Game::Draw");
+		renderInterpolation = interpolation;
+
 		if (stateStack.size() > 0)
 		{
-			std::vector<GameState*> visibleGameStates;
-			for (auto it = stateStack.rbegin(); it != stateStack.rend(); ++it)
+			// Draw bottom-up, starting at the topmost exclusively visible state
+			size_t firstVisible = stateStack.size() - 1;
+			while (firstVisible > 0 && !stateStack[firstVisible].isExclusivelyVisible)
 			{
-				visibleGameStates.push_back(&(*it));
-				if (it->isExclusivelyVisible)
-				{
-					break;
-				}
+				--firstVisible;
 			}
 
-			for (auto it = visibleGameStates.rbegin(); it != visibleGameStates.rend(); ++it)
+			for (size_t i = firstVisible; i < stateStack.size(); ++i)
 			{
-				(*it)->data->draw(window);
+				PROFILE_ZONE(GetStateZoneName(stateStack[i].type, 2));
+				stateStack[i].data->draw(window);
 			}
 		}
+
+		if (isProfilerOverlayVisible)
+		{
+			profilerOverlay.update();
+			profilerOverlay.draw(window);
+		}
 	}
 
 	void Game::Shutdown()
 	{
-		stateStack.clear();
+		ExitAllStates();
+	}
+
+	void Game::ApplyPendingStateChange()
+	{
+		// Only resident states are entered and exited here, so a transition loads and allocates nothing
+		PROFILE_ZONE("Game::ChangeState");
+
+		if (stateChangeType == GameStateChangeType::Switch)
+		{
+			ExitAllStates();
+		}
+		else if (stateChangeType == GameStateChangeType::Pop)
+		{
+			// Remove only current game state
+			if (stateStack.size() > 0)
+			{
+				stateStack.back().data->onExit();
+				stateStack.pop_back();
+			}
+		}
+
+		// A state has one instance, so it can be on the stack only once
+		GameStateBase* newState = stateCache[static_cast<size_t>(pendingGameStateType)].get();
+		const bool isOnStack = std::any_of(stateStack.begin(), stateStack.end(),
+			[this](const GameState& state) { return state.type == pendingGameStateType; });
+		if (newState && !isOnStack)
+		{
+			stateStack.push_back({ pendingGameStateType, newState, pendingGameStateIsExclusivelyVisible });
+			newState->onEnter();
+		}
+
+		stateChangeType = GameStateChangeType::None;
+		pendingGameStateType = GameStateType::None;
+		pendingGameStateIsExclusivelyVisible = false;
+	}
+
+	void Game::ExitAllStates()
+	{
+		// Top state first, the reverse of the order they were entered in
+		while (!stateStack.empty())
+		{
+			stateStack.back().data->onExit();
+			stateStack.pop_back();
+		}
 	}
 
 	bool Game::IsEnableOptions(GameOptions option) const
@@ -134,65 +213,30 @@ namespace ArkanoidGame
 
 	int Game::GetRecordByPlayerId(const std::string& playerId) const
 	{
-		auto it = recordsTable.find(playerId);
-		return (it != recordsTable.end()) ? it->second : 0;
+		return leaderboard.getScore(playerId);
 	}
 
 	void Game::UpdateRecord(const std::string& playerId, int score)
 	{
-		recordsTable[playerId] = score;
+		leaderboard.set(playerId, score);
 	}
 
 	bool Game::IsScoreHighEnough() const
 	{
-		// Check if current score is high enough to be in top 5
-		if (recordsTable.size() < 5)
-		{
-			return true; // Always allow if less than 5 records
-		}
-		
-		// Find the lowest score in current records
-		int lowestScore = INT_MAX;
-		for (const auto& record : recordsTable)
-		{
-			lowestScore = std::min(lowestScore, record.second);
-		}
-		
-		// Player needs to beat the lowest score to qualify
-		return currentScore > lowestScore;
+		// Player needs room on the board or to beat its lowest score
+		return leaderboard.isScoreHighEnough(currentScore);
 	}
 
 	void Game::AddRecord(const std::string& playerName, int score)
 	{
-		// Add the record
-		recordsTable[playerName] = score;
+		// Add the record; the lowest one leaves a full board
+		leaderboard.set(playerName, score);
 		
-		// If we have more than 10 records, remove the lowest ones
-		if (recordsTable.size() > 10)
+		// Append just this score; rewrite the log when appending fails or the log has grown long
+		if (!recordsStore.append(playerName, score) || recordsStore.shouldCompact(leaderboard.size()))
 		{
-			// Convert to vector and sort by score
-			std::vector<std::pair<std::string, int>> records;
-			for (const auto& record : recordsTable)
-			{
-				records.push_back({record.first, record.second});
-			}
-			
-			// Sort by score in descending order
-			std::sort(records.begin(), records.end(), 
-				[](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
-					return a.second > b.second;
-				});
-			
-			// Keep only top 10
-			recordsTable.clear();
-			for (size_t i = 0; i < 10 && i < records.size(); ++i)
-			{
-				recordsTable[records[i].first] = records[i].second;
-			}
+			SaveRecordsToFile();
 		}
-		
-		// Save records immediately after adding new record
-		SaveRecordsToFile();
 	}
 
 	void Game::PushState(GameStateType stateType, bool isExclusivelyVisible)
@@ -214,24 +258,26 @@ namespace ArkanoidGame
 		pendingGameStateIsExclusivelyVisible = false;
 	}
 
-	std::unique_ptr<GameStateBase> CreateGameState(GameStateType stateType)
+	std::unique_ptr<GameStateBase> CreateGameState(Game& game, GameStateType stateType)
 	{
 		switch (stateType)
 		{
 		case GameStateType::MainMenu:
-			return std::make_unique<GameStateMainMenu>();
+			return std::make_unique<GameStateMainMenu>(game);
 		case GameStateType::Playing:
-			return std::make_unique<GameStatePlaying>();
+			return std::make_unique<GameStatePlaying>(game);
 		case GameStateType::GameOver:
-			return std::make_unique<GameStateGameOver>();
+			return std::make_unique<GameStateGameOver>(game);
 		case GameStateType::Win:
-			return std::make_unique<GameStateWin>();
+			return std::make_unique<GameStateWin>(game);
 		case GameStateType::ExitDialog:
-			return std::make_unique<GameStateExitDialog>();
+			return std::make_unique<GameStateExitDialog>(game);
 		case GameStateType::Records:
-			return std::make_unique<GameStateRecords>();
+			return std::make_unique<GameStateRecords>(game);
 		case GameStateType::NameInput:
-			return std::make_unique<GameStateNameInput>();
+			return std::make_unique<GameStateNameInput>(game);
+		case GameStateType::Versus:
+			return std::make_unique<GameStateVersus>(game);
 		default:
 			return nullptr;
 		}
@@ -239,61 +285,52 @@ namespace ArkanoidGame
 
 	void Game::SaveRecordsToFile()
 	{
-		std::ofstream file(RECORDS_FILE);
-		if (!file.is_open())
+		// Failing to write is not fatal; the old log stays in place
+		recordsStore.compact(leaderboard);
+	}
+
+	void Game::LoadRecordsFromFile()
+	{
+		leaderboard.clear();
+		const bool isLogLoaded = recordsStore.load(leaderboard);
+		if (!isLogLoaded)
 		{
-			return; // Failed to open file, silently continue
+			// First start after an update from the text format
+			ImportLegacyRecords();
 		}
 
-		// Write each record in format: "PlayerName Score"
-		for (const auto& record : recordsTable)
+		// If no records were loaded, use defaults
+		if (leaderboard.empty())
 		{
-			file << record.first << " " << record.second << std::endl;
+			leaderboard.set("Champion", 195);
+			leaderboard.set("ProGamer", 180);
+			leaderboard.set("BlockBreaker", 165);
+			leaderboard.set("ArcadeMaster", 150);
+			leaderboard.set("SpeedRunner", 135);
 		}
-	}
 
-	void Game::LoadRecordsFromFile()
-	{
-		std::ifstream file(RECORDS_FILE);
-		if (!file.is_open())
+		// Start a log for imported or default records, and shrink a long or damaged one
+		if (!isLogLoaded || recordsStore.shouldCompact(leaderboard.size()))
 		{
-			// File doesn't exist, use default records
-			recordsTable =
-			{
-				{"Champion", 195},
-				{"ProGamer", 180},
-				{"BlockBreaker", 165},
-				{"ArcadeMaster", 150},
-				{"SpeedRunner", 135},
-			};
-			return;
+			SaveRecordsToFile();
 		}
+	}
 
-		recordsTable.clear();
-		std::string line;
-		while (std::getline(file, line))
+	bool Game::ImportLegacyRecords()
+	{
+		std::ifstream file(LEGACY_RECORDS_FILE);
+		if (!file.is_open())
 		{
-			std::istringstream iss(line);
-			std::string playerName;
-			int score;
-			
-			if (iss >> playerName >> score)
-			{
-				recordsTable[playerName] = score;
-			}
+			return false;
 		}
 
-		// If no records were loaded, use defaults
-		if (recordsTable.empty())
+		// Format: "PlayerName Score" per line
+		std::string playerName;
+		int score;
+		while (file >> playerName >> score)
 		{
-			recordsTable =
-			{
-				{"Champion", 195},
-				{"ProGamer", 180},
-				{"BlockBreaker", 165},
-				{"ArcadeMaster", 150},
-				{"SpeedRunner", 135},
-			};
+			leaderboard.set(playerName, score);
 		}
+		return true;
 	}
 }
@@ -1,6 +1,13 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "GameSettings.h"
+#include "Leaderboard.h"
+#include "LevelPack.h"
+#include "NetChannel.h"
+#include "ProfilerOverlay.h"
+#include "RecordsStore.h"
+#include "ResourceCache.h"
+#include <array>
 #include <unordered_map>
 #include <memory>
 
@@ -25,22 +32,34 @@ namespace ArkanoidGame
 		ExitDialog,
 		Records,
 		NameInput,
+		Versus,
 	};
 
+	constexpr size_t GAME_STATE_TYPE_COUNT = static_cast<size_t>(GameStateType::Versus) + 1;
+
 	// Forward declaration
 	class Game;
 
-	// Base class for all game states
+	/**
+	 * @brief Base class for all game states
+	 *
+	 * States are built once when the game starts and stay resident, so their
+	 * texts and layout are never rebuilt. onEnter() is called each time the
+	 * state is put on the stack and must reset whatever a previous visit left
+	 * behind; onExit() is called when it leaves the stack. Neither may allocate
+	 * beyond the buffers the state already owns.
+	 */
 	class GameStateBase
 	{
 	public:
-		GameStateBase() : game(nullptr) {}
+		explicit GameStateBase(Game& gameInstance) : game(&gameInstance) {}
 		virtual ~GameStateBase() = default;
+		virtual void onEnter() {}
+		virtual void onExit() {}
 		virtual void handleWindowEvent(const sf::Event& event) = 0;
 		virtual void update(float timeDelta) = 0;
 		virtual void draw(sf::RenderWindow& window) = 0;
 		
-		void setGame(Game* gameInstance) { game = gameInstance; }
 		
 	protected:
 		Game* game;
@@ -49,7 +68,7 @@ namespace ArkanoidGame
 	struct GameState
 	{
 		GameStateType type = GameStateType::None;
-		std::unique_ptr<GameStateBase> data = nullptr;
+		GameStateBase* data = nullptr; // Owned by the game's state cache
 		bool isExclusivelyVisible = false;
 	};
 
@@ -64,20 +83,36 @@ namespace ArkanoidGame
 	class Game
 	{
 	public:
-		using RecordsTable = std::unordered_map<std::string, int>;
-
 		Game();
 		~Game();
 
 		void HandleWindowEvents(sf::RenderWindow& window);
 		bool Update(float timeDelta); // Return false if game should be closed
-		void Draw(sf::RenderWindow& window);
+		void Draw(sf::RenderWindow& window, float interpolation = 1.0f);
 		void Shutdown();
 
+		// Fraction of a tick between the previous and current simulation state for this frame, in [0, 1]
+		float GetRenderInterpolation() const { return renderInterpolation; }
+
+		// Simulation ticks per second the Application steps the states at; may differ from PHYSICS_TICKS_PER_SECOND
+		int GetPhysicsRate() const { return physicsRate; }
+		void SetPhysicsRate(int ticksPerSecond) { physicsRate = ticksPerSecond; }
+
+		// Shared fonts and sounds; states take handles in their constructors
+		ResourceCache& GetResources() { return resources; }
+
+		// Designed levels, mapped once at startup; empty when no pack is installed
+		const LevelPack& GetLevels() const { return levels; }
+
+		// Role, address and simulated network conditions of versus matches
+		const VersusSettings& GetVersusSettings() const { return versusSettings; }
+		void SetVersusSettings(const VersusSettings& settings) { versusSettings = settings; }
+
 		bool IsEnableOptions(GameOptions option) const;
 		void SetOption(GameOptions option, bool value);
 
-		const RecordsTable& GetRecordsTable() const { return recordsTable; }
+		// Best scores; screens read its cached ranking and redraw when its version changes
+		const Leaderboard& GetLeaderboard() const { return leaderboard; }
 		int GetRecordByPlayerId(const std::string& playerId) const;
 		void UpdateRecord(const std::string& playerId, int score);
 
@@ -89,11 +124,11 @@ namespace ArkanoidGame
 		bool IsScoreHighEnough() const;
 		void AddRecord(const std::string& playerName, int score);
 
-		// Records persistence
+		// Records persistence: AddRecord appends to the log, SaveRecordsToFile compacts it
 		void SaveRecordsToFile();
 		void LoadRecordsFromFile();
 
-		// Add new game state on top of the stack
+		// Add new game state on top of the stack; ignored if that state is already on it
 		void PushState(GameStateType stateType, bool isExclusivelyVisible);
 
 		// Remove current game state from the stack
@@ -104,18 +139,36 @@ namespace ArkanoidGame
 
 		
 	private:
-		std::vector<GameState> stateStack;
+		ResourceCache resources; // Declared first so it outlives every state holding handles
+		LevelPack levels;        // Also outlives the states, whose sims were built from its levels
+
+		// One resident instance per state type, built at startup; the stack points into it
+		std::array<std::unique_ptr<GameStateBase>, GAME_STATE_TYPE_COUNT> stateCache;
+		std::vector<GameState> stateStack; // Reserved for every state type, so pushes never allocate
 		GameStateChangeType stateChangeType = GameStateChangeType::None;
 		GameStateType pendingGameStateType = GameStateType::None;
 		bool pendingGameStateIsExclusivelyVisible = false;
 
 		GameOptions options = GameOptions::Default;
-		RecordsTable recordsTable;
+		VersusSettings versusSettings;
+		float renderInterpolation = 1.0f;
+		int physicsRate = PHYSICS_TICKS_PER_SECOND;
+
+		// F3 toggles the profiler overlay, F4 writes PROFILE_TRACE_FILE
+		ProfilerOverlay profilerOverlay;
+		bool isProfilerOverlayVisible = false;
+
+		Leaderboard leaderboard;
+		RecordsStore recordsStore;
 		
 		// Current game session data
 		int currentScore = 0;
 		bool gameWon = false;
+
+		bool ImportLegacyRecords();
+		void ApplyPendingStateChange();
+		void ExitAllStates();
 	};
 
-	std::unique_ptr<GameStateBase> CreateGameState(GameStateType stateType);
+	std::unique_ptr<GameStateBase> CreateGameState(Game& game, GameStateType stateType);
 }
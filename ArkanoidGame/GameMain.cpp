@@ -3,12 +3,44 @@
 
 #include <SFML/Graphics.hpp>
 #include "Application.h"
+#include <cstdlib>
+#include <cstring>
 
 
 using namespace ArkanoidGame;
 
-int main()
+int main(int argc, char** argv)
 {
+	// Optional "--physics-rate <ticks per second>" overrides PHYSICS_TICKS_PER_SECOND
+	// Versus: hosts on VERSUS_PORT unless "--join <address>" is given; "--port <port>" changes the port,
+	// "--net-latency <ms>" and "--net-loss <percent>" simulate a worse network on outgoing packets
+	VersusSettings versusSettings;
+	for (int i = 1; i + 1 < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--physics-rate") == 0)
+		{
+			Application::Instance().SetPhysicsRate(std::atoi(argv[i + 1]));
+		}
+		else if (std::strcmp(argv[i], "--join") == 0)
+		{
+			versusSettings.isHost = false;
+			versusSettings.hostAddress = argv[i + 1];
+		}
+		else if (std::strcmp(argv[i], "--port") == 0)
+		{
+			versusSettings.port = static_cast<unsigned short>(std::atoi(argv[i + 1]));
+		}
+		else if (std::strcmp(argv[i], "--net-latency") == 0)
+		{
+			versusSettings.conditions.latency = static_cast<float>(std::atof(argv[i + 1])) / 1000.0f;
+		}
+		else if (std::strcmp(argv[i], "--net-loss") == 0)
+		{
+			versusSettings.conditions.lossRate = static_cast<float>(std::atof(argv[i + 1])) / 100.0f;
+		}
+	}
+	Application::Instance().GetGame().SetVersusSettings(versusSettings);
+
 	Application::Instance().Run();
 
 	return 0;
@@ -1,5 +1,6 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
 
 namespace ArkanoidGame
 {
@@ -7,7 +8,8 @@ namespace ArkanoidGame
 	 * @brief Base class for all game objects
 	 * 
 	 * Provides common interface for game objects including
-	 * position, bounds, rendering, and update functionality.
+	 * position, bounds and update functionality. Game objects hold
+	 * simulation state only; drawing is done by ArkanoidRenderer.
 	 */
 	class GameObject
 	{
@@ -34,7 +36,6 @@ namespace ArkanoidGame
 
 		// Virtual methods to be overridden by derived classes
 		virtual void update(float timeDelta) {}
-		virtual void draw(sf::RenderWindow& window) const = 0;
 		virtual bool checkCollision(const sf::FloatRect& otherBounds) const;
 	};
 }
@@ -15,23 +15,51 @@ namespace ArkanoidGame
 	// Ball settings
 	constexpr float BALL_RADIUS = 10.0f;
 	constexpr float BALL_SPEED = 400.0f;
+	constexpr int BALL_MAX_IMPACTS_PER_STEP = 8; // Contacts resolved per step before the rest of the move is dropped
+	constexpr float BALL_MAX_SPEED = 450.0f;       // Hard limit unless a speed bonus is active
+	constexpr size_t MAX_EXTRA_BALLS = 4096;       // Multiball capacity besides the main ball
+	constexpr float BALL_SPLIT_ANGLE = 0.35f;      // Radians between the directions of split balls
 
 	// Game name
 	constexpr const char* GAME_NAME = "ArkanoidGame";
-	constexpr const char* RECORDS_FILE = "records.txt";
+	constexpr const char* RECORDS_FILE = "records.bin";        // Append-only binary log, see RecordsStore
+	constexpr const char* LEGACY_RECORDS_FILE = "records.txt"; // Text table of older versions, imported once
+	constexpr size_t MAX_RECORDS = 10; // Scores kept on the leaderboard
+	constexpr const char* LAST_REPLAY_FILE = "last_session.arkr"; // Input log of the most recent game
+	constexpr const char* PROFILE_TRACE_FILE = "profile_trace.json"; // Chrome trace written by F4
 
 	// Resource paths
 	const std::string RESOURCES_PATH = "Resources/";
 	const std::string TEXTURES_PATH = RESOURCES_PATH + "Textures/";
 	const std::string FONTS_PATH = RESOURCES_PATH + "Fonts/";
 	const std::string SOUNDS_PATH = RESOURCES_PATH + "Sounds/";
+	const std::string LEVELS_PATH = RESOURCES_PATH + "Levels/";
+
+	// Resource files, loaded once through Game's ResourceCache
+	const std::string FONT_REGULAR_FILE = FONTS_PATH + "Roboto-Regular.ttf";
+	const std::string SOUND_BALL_HIT_FILE = SOUNDS_PATH + "AppleEat.wav";
+	const std::string SOUND_GAME_OVER_FILE = SOUNDS_PATH + "Death.wav";
+	const std::string LEVEL_PACK_FILE = LEVELS_PATH + "levels.arkpak"; // Compiled by "ArkanoidTools compile"; without it layouts are generated
 
 	// Game constants
-	constexpr float TIME_PER_FRAME = 1.0f / 60.0f; // 60 fps
+	constexpr float TIME_PER_FRAME = 1.0f / 60.0f; // 60 fps, display rate when vsync is off
+	constexpr int PHYSICS_TICKS_PER_SECOND = 240; // Fixed simulation rate, independent of the display rate
+	constexpr float MAX_FRAME_TIME = 0.25f; // Longer frames are clamped so a stall cannot queue a burst of ticks
+	constexpr int REWIND_SECONDS = 5; // Play time the rewind buffer keeps
+	constexpr int ATTRACT_DEMO_MAX_SECONDS = 120; // The main menu demo starts over after this long even if the bot has not won
+	constexpr bool IS_VSYNC_ENABLED = true;
+
+	// Versus over the network, see RollbackSession
+	constexpr unsigned short VERSUS_PORT = 47215;
+	constexpr int ROLLBACK_INPUT_DELAY_TICKS = 3; // Local keys take effect this many ticks later, hiding part of the latency
+	constexpr int ROLLBACK_MAX_TICKS = 60;        // Furthest a peer runs ahead of the other's inputs before it waits (250 ms)
+	constexpr int NET_TIMEOUT_SECONDS = 5;        // Silence after which the peer counts as gone
 	constexpr float BONUS_DROP_CHANCE = 0.1f; // 10% chance
 	constexpr float BONUS_FALL_SPEED = 100.0f;
 	constexpr float BONUS_SIZE = 20.0f;
 	constexpr float BONUS_RADIUS = 10.0f;
+	constexpr size_t MAX_FALLING_BONUSES = 512; // Pool size; drops beyond it are discarded
+	constexpr size_t MAX_ACTIVE_EFFECTS = 64;   // Timed effects running at once
 	
 	// Block constants
 	constexpr float BLOCK_WIDTH = 80.0f;
@@ -39,6 +67,7 @@ namespace ArkanoidGame
 	constexpr float BLOCK_SPACING = 10.0f;
 	constexpr int BLOCKS_PER_ROW = 8;
 	constexpr int BLOCK_ROWS = 3;
+	constexpr int BLOCK_COLOR_COUNT = 9; // Size of the regular block palette
 	
 	// UI constants
 	constexpr int UI_FONT_SIZE_LARGE = 48;
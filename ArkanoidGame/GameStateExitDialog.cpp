@@ -3,18 +3,16 @@
 
 namespace ArkanoidGame
 {
-	GameStateExitDialog::GameStateExitDialog()
+	GameStateExitDialog::GameStateExitDialog(Game& gameInstance)
+		: GameStateBase(gameInstance)
 	{
 		initializeUI();
 	}
 
 	void GameStateExitDialog::initializeUI()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(400, 200));
@@ -24,7 +22,7 @@ namespace ArkanoidGame
 		background.setOutlineThickness(2);
 
 		// Initialize exit text
-		exitText.setFont(font);
+		exitText.setFont(*font);
 		exitText.setString("Exit Game?");
 		exitText.setCharacterSize(32);
 		exitText.setFillColor(sf::Color::White);
@@ -32,7 +30,7 @@ namespace ArkanoidGame
 		exitText.setPosition(SCREEN_WIDTH / 2, (SCREEN_HEIGHT - 200) / 2 + 50);
 
 		// Initialize hint text
-		hintText.setFont(font);
+		hintText.setFont(*font);
 		hintText.setString("Press Y to exit, N or ESC to continue");
 		hintText.setCharacterSize(18);
 		hintText.setFillColor(sf::Color::Yellow);
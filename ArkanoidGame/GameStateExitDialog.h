@@ -15,13 +15,13 @@ namespace ArkanoidGame
 	class GameStateExitDialog : public GameStateBase
 	{
 	private:
-		sf::Font font;
+		FontHandle font;
 		sf::Text exitText;
 		sf::Text hintText;
 		sf::RectangleShape background;
 
 	public:
-		GameStateExitDialog();
+		explicit GameStateExitDialog(Game& gameInstance);
 		~GameStateExitDialog() = default;
 
 		void handleWindowEvent(const sf::Event& event) override;
@@ -3,7 +3,8 @@
 
 namespace ArkanoidGame
 {
-	GameStateGameOver::GameStateGameOver()
+	GameStateGameOver::GameStateGameOver(Game& gameInstance)
+		: GameStateBase(gameInstance)
 	{
 		initializeUI();
 		
@@ -17,11 +18,8 @@ namespace ArkanoidGame
 
 	void GameStateGameOver::initializeUI()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
@@ -29,7 +27,7 @@ namespace ArkanoidGame
 		background.setFillColor(sf::Color(100, 0, 0, 200)); // Red background
 
 		// Initialize game over text
-		gameOverText.setFont(font);
+		gameOverText.setFont(*font);
 		gameOverText.setString("GAME OVER");
 		gameOverText.setCharacterSize(UI_FONT_SIZE_LARGE);
 		gameOverText.setFillColor(sf::Color::Red);
@@ -37,7 +35,7 @@ namespace ArkanoidGame
 		gameOverText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 150);
 
 		// Initialize defeat message text
-		defeatMessageText.setFont(font);
+		defeatMessageText.setFont(*font);
 		defeatMessageText.setString("You lost all your lives!");
 		defeatMessageText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		defeatMessageText.setFillColor(sf::Color::White);
@@ -45,7 +43,7 @@ namespace ArkanoidGame
 		defeatMessageText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 100);
 
 		// Initialize play again text
-		playAgainText.setFont(font);
+		playAgainText.setFont(*font);
 		playAgainText.setString("Would you like to play again?");
 		playAgainText.setCharacterSize(UI_FONT_SIZE_SMALL);
 		playAgainText.setFillColor(sf::Color::White);
@@ -53,7 +51,7 @@ namespace ArkanoidGame
 		playAgainText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 50);
 
 		// Initialize yes text
-		yesText.setFont(font);
+		yesText.setFont(*font);
 		yesText.setString("Yes - Play Again");
 		yesText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		yesText.setFillColor(sf::Color::White);
@@ -61,7 +59,7 @@ namespace ArkanoidGame
 		yesText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
 
 		// Initialize no text
-		noText.setFont(font);
+		noText.setFont(*font);
 		noText.setString("No - Main Menu");
 		noText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		noText.setFillColor(sf::Color::White);
@@ -69,6 +67,13 @@ namespace ArkanoidGame
 		noText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
 	}
 
+	void GameStateGameOver::onEnter()
+	{
+		// Every visit starts on the first option
+		selectedOption = 0;
+		updateMenuSelection();
+	}
+
 	void GameStateGameOver::handleWindowEvent(const sf::Event& event)
 	{
 		if (event.type == sf::Event::KeyPressed)
@@ -140,7 +145,7 @@ namespace ArkanoidGame
 		
 		// Draw control hint
 		sf::Text hintText;
-		hintText.setFont(font);
+		hintText.setFont(*font);
 		hintText.setString("Use UP/DOWN arrows to navigate, ENTER to select, ESC for Main Menu");
 		hintText.setCharacterSize(UI_FONT_SIZE_TINY);
 		hintText.setFillColor(sf::Color::Cyan);
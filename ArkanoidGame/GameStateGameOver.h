@@ -15,7 +15,7 @@ namespace ArkanoidGame
 	class GameStateGameOver : public GameStateBase
 	{
 	private:
-		sf::Font font;
+		FontHandle font;
 		sf::Text gameOverText;
 		sf::Text defeatMessageText;
 		sf::Text playAgainText;
@@ -29,9 +29,10 @@ namespace ArkanoidGame
 		sf::Text* menuOptions[MENU_OPTIONS_COUNT];
 
 	public:
-		GameStateGameOver();
+		explicit GameStateGameOver(Game& gameInstance);
 		~GameStateGameOver() = default;
 
+		void onEnter() override;
 		void handleWindowEvent(const sf::Event& event) override;
 		void update(float timeDelta) override;
 		void draw(sf::RenderWindow& window) override;
@@ -1,16 +1,19 @@
 #include "GameStateMainMenu.h"
 #include "GameSettings.h"
+#include <random>
 
 namespace ArkanoidGame
 {
-	GameStateMainMenu::GameStateMainMenu()
+	GameStateMainMenu::GameStateMainMenu(Game& gameInstance)
+		: GameStateBase(gameInstance), demoSim(0)
 	{
 		initializeUI();
 		
 		// Initialize menu options array
 		menuOptions[0] = &startGameText;
-		menuOptions[1] = &recordsText;
-		menuOptions[2] = &exitText;
+		menuOptions[1] = &versusText;
+		menuOptions[2] = &recordsText;
+		menuOptions[3] = &exitText;
 		
 		// Initialize menu selection
 		updateMenuSelection();
@@ -18,19 +21,18 @@ namespace ArkanoidGame
 
 	void GameStateMainMenu::initializeUI()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
 		background.setPosition(0.f, 0.f);
 		background.setFillColor(sf::Color(0, 50, 100));
+		demoOverlay.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
+		demoOverlay.setFillColor(sf::Color(0, 20, 40, 160));
 
 		// Initialize title text
-		titleText.setFont(font);
+		titleText.setFont(*font);
 		titleText.setString("ARKANOID GAME");
 		titleText.setCharacterSize(UI_FONT_SIZE_LARGE);
 		titleText.setFillColor(sf::Color::Yellow);
@@ -38,28 +40,61 @@ namespace ArkanoidGame
 		titleText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 150);
 
 		// Initialize start game text
-		startGameText.setFont(font);
+		startGameText.setFont(*font);
 		startGameText.setString("Start Game");
 		startGameText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		startGameText.setFillColor(sf::Color::White);
 		startGameText.setOrigin(startGameText.getLocalBounds().width / 2, startGameText.getLocalBounds().height / 2);
-		startGameText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 50);
+		startGameText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 75);
+
+		// Initialize versus text
+		versusText.setFont(*font);
+		versusText.setString("Versus (Network)");
+		versusText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
+		versusText.setFillColor(sf::Color::White);
+		versusText.setOrigin(versusText.getLocalBounds().width / 2, versusText.getLocalBounds().height / 2);
+		versusText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 25);
 
 		// Initialize records text
-		recordsText.setFont(font);
+		recordsText.setFont(*font);
 		recordsText.setString("View Records");
 		recordsText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		recordsText.setFillColor(sf::Color::White);
 		recordsText.setOrigin(recordsText.getLocalBounds().width / 2, recordsText.getLocalBounds().height / 2);
-		recordsText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		recordsText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 25);
 
 		// Initialize exit text
-		exitText.setFont(font);
+		exitText.setFont(*font);
 		exitText.setString("Exit Game");
 		exitText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		exitText.setFillColor(sf::Color::White);
 		exitText.setOrigin(exitText.getLocalBounds().width / 2, exitText.getLocalBounds().height / 2);
-		exitText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 50);
+		exitText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 75);
+	}
+
+	void GameStateMainMenu::onEnter()
+	{
+		// Every visit starts on the first option
+		selectedOption = 0;
+		updateMenuSelection();
+		resetDemo();
+	}
+
+	void GameStateMainMenu::resetDemo()
+	{
+		// Same level choice as a new game, so the demo shows what playing looks like
+		const unsigned int seed = std::random_device{}();
+		const LevelPack& levels = game->GetLevels();
+		if (levels.getLevelCount() > 0)
+		{
+			demoSim.reset(seed, levels.getLevel(seed % levels.getLevelCount()));
+		}
+		else
+		{
+			demoSim.reset(seed);
+		}
+		demoPilot.reset();
+		demoTicks = 0;
 	}
 
 	void GameStateMainMenu::handleWindowEvent(const sf::Event& event)
@@ -93,13 +128,20 @@ namespace ArkanoidGame
 
 	void GameStateMainMenu::update(float timeDelta)
 	{
-		// No update logic needed for this state
+		// Advance the demo; a finished or overlong game makes way for a new one
+		demoSim.step(demoPilot.poll(demoSim), timeDelta);
+		++demoTicks;
+		if (demoSim.getStatus() != SimStatus::Running || demoTicks >= static_cast<uint32_t>(ATTRACT_DEMO_MAX_SECONDS * game->GetPhysicsRate()))
+		{
+			resetDemo();
+		}
 	}
 
 	void GameStateMainMenu::updateMenuSelection()
 	{
 		// Reset all text colors to white
 		startGameText.setFillColor(sf::Color::White);
+		versusText.setFillColor(sf::Color::White);
 		recordsText.setFillColor(sf::Color::White);
 		exitText.setFillColor(sf::Color::White);
 		
@@ -116,10 +158,13 @@ namespace ArkanoidGame
 		case 0: // Start Game
 			game->SwitchStateTo(GameStateType::Playing);
 			break;
-		case 1: // View Records
+		case 1: // Versus
+			game->SwitchStateTo(GameStateType::Versus);
+			break;
+		case 2: // View Records
 			game->PushState(GameStateType::Records, true);
 			break;
-		case 2: // Exit Game
+		case 3: // Exit Game
 			game->SwitchStateTo(GameStateType::None);
 			break;
 		}
@@ -127,18 +172,21 @@ namespace ArkanoidGame
 
 	void GameStateMainMenu::draw(sf::RenderWindow& window)
 	{
-		// Draw background
+		// Draw background, then the demo game dimmed behind the menu
 		window.draw(background);
+		demoRenderer.draw(window, demoSim, game ? game->GetRenderInterpolation() : 1.0f);
+		window.draw(demoOverlay);
 
 		// Draw all text elements
 		window.draw(titleText);
 		window.draw(startGameText);
+		window.draw(versusText);
 		window.draw(recordsText);
 		window.draw(exitText);
 		
 		// Draw control hint
 		sf::Text hintText;
-		hintText.setFont(font);
+		hintText.setFont(*font);
 		hintText.setString("Use UP/DOWN arrows to navigate, ENTER to select, ESC to exit");
 		hintText.setCharacterSize(UI_FONT_SIZE_TINY);
 		hintText.setFillColor(sf::Color::Cyan);
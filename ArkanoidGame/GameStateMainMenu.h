@@ -1,5 +1,8 @@
 #pragma once
 #include "SFML/Graphics.hpp"
+#include "ArkanoidRenderer.h"
+#include "ArkanoidSim.h"
+#include "Autopilot.h"
 #include "Game.h"
 
 namespace ArkanoidGame
@@ -9,34 +12,46 @@ namespace ArkanoidGame
 	/**
 	 * @brief Main menu state for Arkanoid game
 	 * 
-	 * Displays the main menu with options to start the game,
-	 * view records, or exit the game. Supports arrow key navigation.
+	 * Displays the main menu with options to start the game, play
+	 * versus over the network, view records, or exit the game. Supports arrow key navigation.
+	 * Behind the menu an Autopilot plays a demo game on a random level, which
+	 * restarts whenever it ends.
 	 */
 	class GameStateMainMenu : public GameStateBase
 	{
 	private:
-		sf::Font font;
+		FontHandle font;
 		sf::Text titleText;
 		sf::Text startGameText;
+		sf::Text versusText;
 		sf::Text recordsText;
 		sf::Text exitText;
 		sf::RectangleShape background;
+		sf::RectangleShape demoOverlay; // Dims the demo so the menu stays readable
+
+		// Attract mode
+		ArkanoidSim demoSim;
+		ArkanoidRenderer demoRenderer;
+		Autopilot demoPilot;
+		uint32_t demoTicks = 0; // Ticks at the running physics rate since the demo started
 		
 		// Menu navigation
 		int selectedOption = 0;
-		static const int MENU_OPTIONS_COUNT = 3;
+		static const int MENU_OPTIONS_COUNT = 4;
 		sf::Text* menuOptions[MENU_OPTIONS_COUNT];
 
 	public:
-		GameStateMainMenu();
+		explicit GameStateMainMenu(Game& gameInstance);
 		~GameStateMainMenu() = default;
 
+		void onEnter() override;
 		void handleWindowEvent(const sf::Event& event) override;
 		void update(float timeDelta) override;
 		void draw(sf::RenderWindow& window) override;
 
 	private:
 		void initializeUI();
+		void resetDemo();
 		void updateMenuSelection();
 		void selectOption();
 	};
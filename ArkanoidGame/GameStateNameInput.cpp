@@ -4,7 +4,8 @@
 
 namespace ArkanoidGame
 {
-	GameStateNameInput::GameStateNameInput()
+	GameStateNameInput::GameStateNameInput(Game& gameInstance)
+		: GameStateBase(gameInstance)
 	{
 		initializeUI();
 		initializeRecordsTable();
@@ -19,11 +20,8 @@ namespace ArkanoidGame
 
 	void GameStateNameInput::initializeUI()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
@@ -31,7 +29,7 @@ namespace ArkanoidGame
 		background.setFillColor(sf::Color(0, 0, 100, 200)); // Blue background
 
 		// Initialize title text
-		titleText.setFont(font);
+		titleText.setFont(*font);
 		titleText.setString("Enter Your Name");
 		titleText.setCharacterSize(UI_FONT_SIZE_LARGE);
 		titleText.setFillColor(sf::Color::Yellow);
@@ -39,14 +37,14 @@ namespace ArkanoidGame
 		titleText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 200);
 
 		// Initialize score text
-		scoreText.setFont(font);
+		scoreText.setFont(*font);
 		scoreText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		scoreText.setFillColor(sf::Color::White);
 		scoreText.setOrigin(scoreText.getLocalBounds().width / 2, scoreText.getLocalBounds().height / 2);
 		scoreText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 150);
 
 		// Initialize name prompt text
-		namePromptText.setFont(font);
+		namePromptText.setFont(*font);
 		namePromptText.setString("Your name:");
 		namePromptText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		namePromptText.setFillColor(sf::Color::White);
@@ -61,7 +59,7 @@ namespace ArkanoidGame
 		inputBox.setOutlineThickness(2);
 
 		// Initialize name input text
-		nameInputText.setFont(font);
+		nameInputText.setFont(*font);
 		nameInputText.setString("Player");
 		nameInputText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		nameInputText.setFillColor(sf::Color::Yellow);
@@ -69,14 +67,14 @@ namespace ArkanoidGame
 		nameInputText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 30);
 
 		// Initialize records hint text
-		recordsHintText.setFont(font);
+		recordsHintText.setFont(*font);
 		recordsHintText.setCharacterSize(UI_FONT_SIZE_SMALL);
 		recordsHintText.setFillColor(sf::Color::Cyan);
 		recordsHintText.setOrigin(recordsHintText.getLocalBounds().width / 2, recordsHintText.getLocalBounds().height / 2);
 		recordsHintText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
 
 		// Initialize save text
-		saveText.setFont(font);
+		saveText.setFont(*font);
 		saveText.setString("Save Score");
 		saveText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		saveText.setFillColor(sf::Color::White);
@@ -84,7 +82,7 @@ namespace ArkanoidGame
 		saveText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 80);
 
 		// Initialize skip text
-		skipText.setFont(font);
+		skipText.setFont(*font);
 		skipText.setString("Skip to Main Menu");
 		skipText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		skipText.setFillColor(sf::Color::White);
@@ -95,6 +93,16 @@ namespace ArkanoidGame
 		playerName = "Player";
 	}
 
+	void GameStateNameInput::onEnter()
+	{
+		// Back to the name prompt; the last name typed stays as the suggestion
+		showRecordsTable = false;
+		isTyping = false;
+		selectedOption = 0;
+		updateMenuSelection();
+		updateInputDisplay();
+	}
+
 	void GameStateNameInput::handleWindowEvent(const sf::Event& event)
 	{
 		if (event.type == sf::Event::KeyPressed)
@@ -276,7 +284,7 @@ namespace ArkanoidGame
 			
 			// Draw control hint for records view
 			sf::Text hintText;
-			hintText.setFont(font);
+			hintText.setFont(*font);
 			hintText.setString("Press ESC to return to main menu");
 			hintText.setCharacterSize(UI_FONT_SIZE_TINY);
 			hintText.setFillColor(sf::Color::Cyan);
@@ -296,7 +304,7 @@ namespace ArkanoidGame
 			
 			// Draw control hints
 			sf::Text hintText;
-			hintText.setFont(font);
+			hintText.setFont(*font);
 			if (isTyping)
 			{
 				hintText.setString("Type your name, ENTER to finish typing");
@@ -316,7 +324,7 @@ namespace ArkanoidGame
 	void GameStateNameInput::initializeRecordsTable()
 	{
 		// Initialize records title
-		recordsTitleText.setFont(font);
+		recordsTitleText.setFont(*font);
 		recordsTitleText.setString("HIGH SCORES");
 		recordsTitleText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		recordsTitleText.setFillColor(sf::Color::Yellow);
@@ -324,10 +332,10 @@ namespace ArkanoidGame
 		recordsTitleText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 50);
 
 		// Initialize records table texts
-		recordsTableTexts.resize(10);
-		for (int i = 0; i < 10; ++i)
+		recordsTableTexts.resize(MAX_RECORDS);
+		for (size_t i = 0; i < recordsTableTexts.size(); ++i)
 		{
-			recordsTableTexts[i].setFont(font);
+			recordsTableTexts[i].setFont(*font);
 			recordsTableTexts[i].setCharacterSize(UI_FONT_SIZE_SMALL);
 			recordsTableTexts[i].setFillColor(sf::Color::White);
 		}
@@ -337,34 +345,21 @@ namespace ArkanoidGame
 	{
 		if (!game) return;
 
-		// Get records from Game class
-		const auto& recordsTable = game->GetRecordsTable();
-		
-		// Convert to vector and sort by score (descending)
-		std::vector<std::pair<std::string, int>> records;
-		for (const auto& record : recordsTable)
-		{
-			records.push_back({record.first, record.second});
-		}
-		
-		// Sort by score in descending order
-		std::sort(records.begin(), records.end(), 
-			[](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
-				return a.second > b.second;
-			});
+		// Ranking is cached by the leaderboard, best first
+		const std::vector<LeaderboardEntry>& ranking = game->GetLeaderboard().getRanking();
 
-		// Display up to 10 records
-		size_t displayCount = std::min(records.size(), recordsTableTexts.size());
+		// Display up to MAX_RECORDS records
+		size_t displayCount = std::min(ranking.size(), recordsTableTexts.size());
 		
 		for (size_t i = 0; i < displayCount; ++i)
 		{
-			std::string recordText = std::to_string(i + 1) + ". " + records[i].first + " - " + std::to_string(records[i].second);
+			std::string recordText = std::to_string(i + 1) + ". " + ranking[i].name + " - " + std::to_string(ranking[i].score);
 			recordsTableTexts[i].setString(recordText);
 			recordsTableTexts[i].setOrigin(recordsTableTexts[i].getLocalBounds().width / 2, recordsTableTexts[i].getLocalBounds().height / 2);
 			recordsTableTexts[i].setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20.0f + static_cast<float>(i) * 25.0f);
 		}
 		
-		// Clear remaining slots if there are fewer than 10 records
+		// Clear remaining slots if there are fewer than MAX_RECORDS records
 		for (size_t i = displayCount; i < recordsTableTexts.size(); ++i)
 		{
 			recordsTableTexts[i].setString("");
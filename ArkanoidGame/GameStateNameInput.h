@@ -16,7 +16,7 @@ namespace ArkanoidGame
 	class GameStateNameInput : public GameStateBase
 	{
 	private:
-		sf::Font font;
+		FontHandle font;
 		sf::Text titleText;
 		sf::Text scoreText;
 		sf::Text namePromptText;
@@ -42,9 +42,10 @@ namespace ArkanoidGame
 		sf::Text* menuOptions[MENU_OPTIONS_COUNT];
 
 	public:
-		GameStateNameInput();
+		explicit GameStateNameInput(Game& gameInstance);
 		~GameStateNameInput() = default;
 
+		void onEnter() override;
 		void handleWindowEvent(const sf::Event& event) override;
 		void update(float timeDelta) override;
 		void draw(sf::RenderWindow& window) override;
@@ -1,37 +1,63 @@
 #include "GameStatePlaying.h"
 #include "GameSettings.h"
-#include <random>
+#include "Profiler.h"
 #include <algorithm>
-#include <cmath>
+#include <cstdio>
+#include <random>
 
 namespace ArkanoidGame
 {
-	GameStatePlaying::GameStatePlaying()
-		: platform(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 50, PLATFORM_WIDTH, PLATFORM_HEIGHT, PLATFORM_SPEED),
-		  ball(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 80, BALL_RADIUS, BALL_SPEED)
+	GameStatePlaying::GameStatePlaying(Game& gameInstance)
+		: GameStateBase(gameInstance), sim(0), rewindBuffer(static_cast<size_t>(REWIND_SECONDS) * gameInstance.GetPhysicsRate())
 	{
 		initializeUI();
-		initializeGameObjects();
-		setupBonusCallbacks();
 	}
 
-	void GameStatePlaying::initializeUI()
+	void GameStatePlaying::onEnter()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// A new game on every visit; the sim and the log reuse their buffers from the last one
+		const unsigned int seed = std::random_device{}();
 
-		// Load sounds
-		if (!ballHitSoundBuffer.loadFromFile(SOUNDS_PATH + "AppleEat.wav"))
+		// With a level pack installed, the seed also picks the level
+		const LevelPack& levels = game->GetLevels();
+		int levelIndex = -1;
+		if (levels.getLevelCount() > 0)
 		{
-			// Fallback if sound loading fails
+			levelIndex = static_cast<int>(seed % levels.getLevelCount());
+			sim.reset(seed, levels.getLevel(levelIndex));
 		}
-		if (!gameOverSoundBuffer.loadFromFile(SOUNDS_PATH + "Death.wav"))
+		else
 		{
-			// Fallback if sound loading fails
+			sim.reset(seed);
 		}
+		inputLog.begin(seed, levelIndex);
+
+		// Retry returns here without rebuilding the level
+		sim.saveSnapshot(startSnapshot);
+		rewindBuffer.setCapacity(static_cast<size_t>(REWIND_SECONDS) * game->GetPhysicsRate());
+		rewindBuffer.reset(sim);
+		isRewindHeld = false;
+
+		markHudDirty();
+		isGameActive = true;
+	}
+
+	void GameStatePlaying::onExit()
+	{
+		// Keep the last game for bug reports and physics regression checks
+		inputLog.finish(sim);
+		inputLog.saveToFile(LAST_REPLAY_FILE);
+		isGameActive = false;
+	}
+
+	void GameStatePlaying::initializeUI()
+	{
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
+
+		// Load sounds
+		ballHitSoundBuffer = game->GetResources().GetSoundBuffer(SOUND_BALL_HIT_FILE);
+		gameOverSoundBuffer = game->GetResources().GetSoundBuffer(SOUND_GAME_OVER_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
@@ -39,367 +65,245 @@ namespace ArkanoidGame
 		background.setFillColor(sf::Color(0, 100, 200));
 
 		// Initialize score text
-		scoreText.setFont(font);
+		scoreText.setFont(*font);
 		scoreText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		scoreText.setFillColor(sf::Color::Yellow);
 		scoreText.setString("Score: 0");
 
 		// Initialize lives text
-		livesText.setFont(font);
+		livesText.setFont(*font);
 		livesText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
 		livesText.setFillColor(sf::Color::Red);
 		livesText.setString("Lives: 3");
 
 		// Initialize input hint text
-		inputHintText.setFont(font);
+		inputHintText.setFont(*font);
 		inputHintText.setCharacterSize(UI_FONT_SIZE_SMALL);
 		inputHintText.setFillColor(sf::Color::White);
-		inputHintText.setString("LEFT/RIGHT: move platform | UP/DOWN: aim ball | SPACE: launch ball");
+		inputHintText.setString("LEFT/RIGHT: move | UP/DOWN: aim | SPACE: launch | BACKSPACE: rewind | R: retry");
 
 		// Initialize active effects text
-		activeEffectsText.setFont(font);
+		activeEffectsText.setFont(*font);
 		activeEffectsText.setCharacterSize(UI_FONT_SIZE_TINY);
 		activeEffectsText.setFillColor(sf::Color::Cyan);
 		activeEffectsText.setString("Active Effects: None");
 
-		// Initialize sounds
-		ballHitSound.setBuffer(ballHitSoundBuffer);
-		gameOverSound.setBuffer(gameOverSoundBuffer);
-	}
+		// Initialize bricks left text
+		bricksLeftText.setFont(*font);
+		bricksLeftText.setCharacterSize(UI_FONT_SIZE_SMALL);
+		bricksLeftText.setFillColor(sf::Color::White);
 
-	void GameStatePlaying::initializeGameObjects()
-	{
-		// Platform and ball are already initialized in constructor
-		initializeBlocks();
-		isGameActive = true;
-	}
-
-	void GameStatePlaying::setupBonusCallbacks()
-	{
-		// Set up callbacks for bonus effects
-		bonusManager.setScoreCallback([this](int points) {
-			score += points;
-		});
-		
-		bonusManager.setLivesCallback([this](int extraLives) {
-			lives += extraLives;
-		});
-		
-		bonusManager.setEffectCallback([this](const std::string& effectName) {
-			// Could add visual feedback here
-			// For now, we'll just update the score text
-		});
+		// Initialize sounds
+		ballHitSound.setBuffer(*ballHitSoundBuffer);
+		gameOverSound.setBuffer(*gameOverSoundBuffer);
 	}
 
-	void GameStatePlaying::initializeBlocks()
+	void GameStatePlaying::gameOver()
 	{
-		blocks.clear();
-		
-		// Define block colors (excluding red - reserved for DurableBricks)
-		std::vector<sf::Color> blockColors = {
-			sf::Color::Green,
-			sf::Color::Blue,
-			sf::Color::Yellow,
-			sf::Color::Magenta,
-			sf::Color::Cyan,
-			sf::Color(255, 165, 0), // Orange
-			sf::Color(128, 0, 128), // Purple
-			sf::Color(255, 192, 203), // Pink
-			sf::Color(0, 128, 0) // Dark Green
-		};
-		
-		// Random number generator
-		std::random_device rd;
-		std::mt19937 gen(rd());
-		
-		// Grid setup - keep the grid structure but randomize within each cell
-		const float startX = 50.0f;
-		const float startY = 100.0f;
-		const float cellWidth = BLOCK_WIDTH + BLOCK_SPACING;
-		const float cellHeight = BLOCK_HEIGHT + BLOCK_SPACING;
-		
-		// Smaller random offset for more even grid
-		const float maxOffsetX = BLOCK_SPACING * 0.15f; // 15% of spacing for more even look
-		const float maxOffsetY = BLOCK_SPACING * 0.15f;
-		
-		// Create all blocks with perfect grid positions first
-		std::vector<std::unique_ptr<Block>> allBlocks;
-		const int totalBlocks = BLOCK_ROWS * BLOCKS_PER_ROW;
-		
-		// Create all blocks with perfect grid positions
-		for (int i = 0; i < totalBlocks; ++i)
-		{
-			int row = i / BLOCKS_PER_ROW;
-			int col = i % BLOCKS_PER_ROW;
-			
-			// Perfect grid position
-			float x = startX + col * cellWidth;
-			float y = startY + row * cellHeight;
-			
-			// Add small random offset
-			std::uniform_real_distribution<float> offsetXDist(-maxOffsetX, maxOffsetX);
-			std::uniform_real_distribution<float> offsetYDist(-maxOffsetY, maxOffsetY);
-			
-			x += offsetXDist(gen);
-			y += offsetYDist(gen);
-			
-			// Ensure blocks stay within screen bounds
-			x = std::max(0.0f, std::min(x, SCREEN_WIDTH - BLOCK_WIDTH));
-			y = std::max(0.0f, std::min(y, SCREEN_HEIGHT - 200.0f - BLOCK_HEIGHT));
-			
-			// Random color for each block
-			std::uniform_int_distribution<int> colorDist(0, static_cast<int>(blockColors.size()) - 1);
-			sf::Color color = blockColors[colorDist(gen)];
-			
-			// Random points (10-30)
-			std::uniform_int_distribution<int> pointsDist(10, 30);
-			int points = pointsDist(gen);
-			
-			// Create regular block (we'll randomize types later)
-			allBlocks.push_back(std::make_unique<Block>(x, y, BLOCK_WIDTH, BLOCK_HEIGHT, color, points));
-		}
-		
-		// Now randomize block types - convert some to special types
-		std::uniform_int_distribution<int> typeDist(0, 9);
-		for (auto& block : allBlocks)
-		{
-			int blockType = typeDist(gen);
-			
-			if (blockType < 2) // 20% chance for DurableBricks
-			{
-				// Get current block properties
-				sf::Vector2f pos = block->getPosition();
-				int points = block->getPoints();
-				
-				// DurableBricks are always red
-				sf::Color durableColor = sf::Color::Red;
-				
-				// Replace with DurableBrick
-				block = std::make_unique<DurableBrick>(pos.x, pos.y, BLOCK_WIDTH, BLOCK_HEIGHT, durableColor, points, 3);
-			}
-			else if (blockType < 4) // 20% chance for GlassBricks
-			{
-				// Get current block properties
-				sf::Vector2f pos = block->getPosition();
-				int points = block->getPoints();
-				
-				// Replace with GlassBrick (keeps its default glass color)
-				block = std::make_unique<GlassBrick>(pos.x, pos.y, BLOCK_WIDTH, BLOCK_HEIGHT, points);
-			}
-			// 60% remain as regular blocks with their random colors
-		}
+		gameOverSound.play();
+		isGameActive = false;
 		
-		// Move all blocks to the main blocks vector
-		for (auto& block : allBlocks)
+		// Save game data and switch to name input state
+		if (game)
 		{
-			blocks.push_back(std::move(block));
+			game->SetCurrentScore(sim.getScore());
+			game->SetGameResult(false); // Player lost
+			game->SwitchStateTo(GameStateType::NameInput);
 		}
 	}
 
-	void GameStatePlaying::handleInput()
+	void GameStatePlaying::handleWindowEvent(const sf::Event& event)
 	{
-		// Platform movement
-		platform.setMovingLeft(sf::Keyboard::isKeyPressed(sf::Keyboard::Left));
-		platform.setMovingRight(sf::Keyboard::isKeyPressed(sf::Keyboard::Right));
+		// Rewind lasts from the key press to its release, and stops when the window loses focus
+		if (event.type == sf::Event::LostFocus || (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::BackSpace))
+		{
+			isRewindHeld = false;
+		}
 
-		// Ball aiming and launch
-		if (!ball.getIsLaunched())
+		if (event.type == sf::Event::KeyPressed)
 		{
-			// Aim with Up/Down arrows
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
-			{
-				ball.setAimDirection(-1.0f); // Aim left
-			}
-			else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
+			if (event.key.code == sf::Keyboard::Escape)
 			{
-				ball.setAimDirection(1.0f); // Aim right
+				// Return to main menu
+				if (game)
+				{
+					game->SwitchStateTo(GameStateType::MainMenu);
+				}
 			}
-			else
+			else if (event.key.code == sf::Keyboard::R && isGameActive)
 			{
-				ball.setAimDirection(0.0f); // Aim straight
+				retry();
 			}
-
-			// Launch ball with Space
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space))
+			else if (event.key.code == sf::Keyboard::BackSpace)
 			{
-				ball.launch();
+				isRewindHeld = true;
 			}
 		}
 	}
 
-	void GameStatePlaying::checkCollisions()
+	void GameStatePlaying::retry()
 	{
-		// Check ball-platform collision
-		if (ball.getIsLaunched())
-		{
-			ball.handlePlatformCollision(platform.getBounds());
-		}
+		// Same seed and level from the first tick; the log starts over with them
+		sim.restoreSnapshot(startSnapshot);
+		inputLog.truncate(0);
+		rewindBuffer.reset(sim);
+		markHudDirty();
+	}
 
-		// Check ball-block collisions
-		checkBlockCollisions();
+	void GameStatePlaying::markHudDirty()
+	{
+		isScoreDirty = true;
+		areLivesDirty = true;
+		areEffectsDirty = true;
+		areBricksDirty = true;
+	}
 
-		// Check if ball fell below screen (lose life)
-		if (ball.getPosition().y > SCREEN_HEIGHT)
+	void GameStatePlaying::update(float timeDelta)
+	{
+		if (!isGameActive)
+			return;
+
+		// While BACKSPACE is held, time runs backwards one recorded tick per tick and the log forgets those ticks
+		if (isRewindHeld)
 		{
-			lives--;
-			if (lives > 0)
-			{
-				resetBall();
-			}
-			else
+			PROFILE_ZONE("Playing::rewind");
+			const size_t undoneTicks = rewindBuffer.rewind(sim, 1);
+			if (undoneTicks > 0)
 			{
-				gameOver();
+				inputLog.truncate(inputLog.getTickCount() - static_cast<uint32_t>(undoneTicks));
+				markHudDirty();
+				updateUI();
 			}
+			return;
 		}
 
-		// Check win condition
-		if (checkWinCondition())
+		SimInput input;
 		{
-			// Player won - save game data and switch to name input state
-			if (game)
-			{
-				game->SetCurrentScore(score);
-				game->SetGameResult(true); // Player won
-				game->SwitchStateTo(GameStateType::NameInput);
-			}
+			PROFILE_ZONE("Playing::input");
+			input = inputProvider->poll(sim);
 		}
+
+		sim.step(input, timeDelta);
+		inputLog.record(input, timeDelta, sim);
+		{
+			PROFILE_ZONE("Playing::recordRewind");
+			rewindBuffer.record(sim);
+		}
+
+		handleSimEvents();
+		updateUI();
 	}
 
-	void GameStatePlaying::checkBlockCollisions()
+	void GameStatePlaying::handleSimEvents()
 	{
-		if (!ball.getIsLaunched()) return;
+		PROFILE_ZONE("Playing::events");
 
-		// Check collisions with all active blocks
-		for (auto& block : blocks)
+		// One pass over the step's events: sounds and HUD changes are batched per tick
+		bool wasBrickHit = false;
+		bool isWon = false;
+		bool isLost = false;
+		for (const SimEvent& event : sim.getEvents())
 		{
-			if (block->getIsActive())
+			switch (event.type)
 			{
-				// Get ball and block bounds
-				sf::FloatRect ballBounds = ball.getBounds();
-				sf::FloatRect blockBounds = block->getBounds();
-				
-				// Check if ball intersects with block
-				if (ballBounds.intersects(blockBounds))
-				{
-					// Handle collision - check if block should bounce ball
-					bool shouldBounce = block->OnHit();
-					
-					if (shouldBounce)
-					{
-						ball.handleBlockCollision(blockBounds);
-					}
-					
-					// Add points if block was destroyed
-					if (block->isDestroyed())
-					{
-						score += block->getPoints();
-						
-						// Create bonus at block position (10% chance)
-						bonusManager.createBonusFromBlock(blockBounds.left + blockBounds.width / 2, blockBounds.top + blockBounds.height / 2);
-					}
-					
-					// Play hit sound
-					ballHitSound.play();
-					
-					break; // Only handle one collision per frame to prevent multiple hits
-				}
+			case SimEventType::BrickHit:
+				wasBrickHit = true;
+				break;
+			case SimEventType::BrickDestroyed:
+				areBricksDirty = true;
+				break;
+			case SimEventType::ScoreChanged:
+				isScoreDirty = true;
+				break;
+			case SimEventType::LifeLost:
+			case SimEventType::LifeGained:
+				areLivesDirty = true;
+				break;
+			case SimEventType::BonusCollected:
+			case SimEventType::EffectEnded:
+				areEffectsDirty = true;
+				break;
+			case SimEventType::GameWon:
+				isWon = true;
+				break;
+			case SimEventType::GameLost:
+				isLost = true;
+				break;
+			default:
+				break;
 			}
 		}
-	}
 
-	void GameStatePlaying::resetBall()
-	{
-		// Reset ball to platform position
-		float platformX = platform.getPosition().x;
-		float platformY = platform.getPosition().y - platform.getHeight() / 2 - ball.getRadius();
-		ball.reset(platformX, platformY);
-	}
-
-	void GameStatePlaying::gameOver()
-	{
-		gameOverSound.play();
-		isGameActive = false;
-		
-		// Save game data and switch to name input state
-		if (game)
+		// Play hit sound once, however many bricks were hit
+		if (wasBrickHit)
 		{
-			game->SetCurrentScore(score);
-			game->SetGameResult(false); // Player lost
-			game->SwitchStateTo(GameStateType::NameInput);
+			ballHitSound.play();
 		}
-	}
 
-	bool GameStatePlaying::checkWinCondition()
-	{
-		// Check if all blocks are destroyed
-		for (const auto& block : blocks)
+		if (isLost)
 		{
-			if (block->getIsActive())
-			{
-				return false; // At least one block is still active
-			}
+			gameOver();
 		}
-		return true; // All blocks are destroyed
-	}
-
-	void GameStatePlaying::handleWindowEvent(const sf::Event& event)
-	{
-		if (event.type == sf::Event::KeyPressed)
+		else if (isWon)
 		{
-			if (event.key.code == sf::Keyboard::Escape)
+			// Player won - save game data and switch to name input state
+			isGameActive = false;
+			if (game)
 			{
-				// Return to main menu
-				if (game)
-				{
-					game->SwitchStateTo(GameStateType::MainMenu);
-				}
+				game->SetCurrentScore(sim.getScore());
+				game->SetGameResult(true); // Player won
+				game->SwitchStateTo(GameStateType::NameInput);
 			}
 		}
 	}
 
-	void GameStatePlaying::update(float timeDelta)
+	void GameStatePlaying::updateUI()
 	{
-		if (!isGameActive)
-			return;
+		PROFILE_ZONE("Playing::updateUI");
 
-		handleInput();
-		
-		// Update game objects
-		platform.update(timeDelta);
-		
-		// Make ball follow platform when not launched
-		if (!ball.getIsLaunched())
+		// setString makes SFML lay the glyphs out again, so skip it when nothing changed
+		if (isScoreDirty)
 		{
-			ball.followPlatform(platform.getPosition(), platform.getWidth());
+			isScoreDirty = false;
+			std::snprintf(hudBuffer, sizeof(hudBuffer), "Score: %d", sim.getScore());
+			scoreText.setString(hudBuffer);
 		}
-		
-		ball.update(timeDelta);
-		
-		// Update bonuses
-		bonusManager.updateBonuses(timeDelta, platform, ball);
-		
-		// Check collisions
-		checkCollisions();
 
-		// Update UI
-		scoreText.setString("Score: " + std::to_string(score));
-		livesText.setString("Lives: " + std::to_string(lives));
-		
-		// Update active effects display
-		auto activeEffects = bonusManager.getActiveEffectNames();
-		if (activeEffects.empty())
+		if (areLivesDirty)
 		{
-			activeEffectsText.setString("Active Effects: None");
+			areLivesDirty = false;
+			std::snprintf(hudBuffer, sizeof(hudBuffer), "Lives: %d", sim.getLives());
+			livesText.setString(hudBuffer);
 		}
-		else
+
+		// Counted by the brick field as bricks die, so this never walks the bricks
+		if (areBricksDirty)
 		{
-			std::string effectsString = "Active Effects: ";
-			for (size_t i = 0; i < activeEffects.size(); ++i)
+			areBricksDirty = false;
+			const BrickField& bricks = sim.getBricks();
+			std::snprintf(hudBuffer, sizeof(hudBuffer), "Bricks: %zu (durable %zu, glass %zu)",
+				bricks.getAliveCount(), bricks.getAliveCount(BlockType::Durable), bricks.getAliveCount(BlockType::Glass));
+			bricksLeftText.setString(hudBuffer);
+		}
+
+		// Update active effects display
+		const BonusManager& bonusManager = sim.getBonusManager();
+		if (areEffectsDirty)
+		{
+			areEffectsDirty = false;
+
+			size_t length = std::snprintf(hudBuffer, sizeof(hudBuffer), "Active Effects: ");
+			bool hasEffects = false;
+			bonusManager.forEachActiveEffect([&](BonusEffectType type) {
+				const int written = std::snprintf(hudBuffer + length, sizeof(hudBuffer) - length, "%s%s", hasEffects ? ", " : "", GetBonusEffectName(type));
+				length = std::min(sizeof(hudBuffer) - 1, length + static_cast<size_t>(std::max(written, 0)));
+				hasEffects = true;
+			});
+			if (!hasEffects)
 			{
-				if (i > 0) effectsString += ", ";
-				effectsString += activeEffects[i];
+				std::snprintf(hudBuffer + length, sizeof(hudBuffer) - length, "None");
 			}
-			activeEffectsText.setString(effectsString);
+			activeEffectsText.setString(hudBuffer);
 		}
 	}
 
@@ -408,18 +312,8 @@ namespace ArkanoidGame
 		// Draw background
 		window.draw(background);
 
-		// Draw blocks
-		for (const auto& block : blocks)
-		{
-			block->draw(window);
-		}
-
-		// Draw game objects
-		platform.draw(window);
-		ball.draw(window);
-		
-		// Draw bonuses
-		bonusManager.drawBonuses(window);
+		// Draw blocks, platform, ball and bonuses
+		renderer.draw(window, sim, game ? game->GetRenderInterpolation() : 1.0f);
 
 		// Draw UI
 		scoreText.setPosition(10, 10);
@@ -431,6 +325,9 @@ namespace ArkanoidGame
 		activeEffectsText.setPosition(10, 70);
 		window.draw(activeEffectsText);
 
+		bricksLeftText.setPosition(SCREEN_WIDTH - bricksLeftText.getLocalBounds().width - 10, 10);
+		window.draw(bricksLeftText);
+
 		inputHintText.setPosition(10, SCREEN_HEIGHT - 30);
 		window.draw(inputHintText);
 	}
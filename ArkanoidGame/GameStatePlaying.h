@@ -1,15 +1,12 @@
 #pragma once
 #include "SFML/Graphics.hpp"
 #include "SFML/Audio.hpp"
-#include "Platform.h"
-#include "Ball.h"
-#include "Block.h"
-#include "DurableBrick.h"
-#include "GlassBrick.h"
-#include "BonusManager.h"
+#include "ArkanoidSim.h"
+#include "ArkanoidRenderer.h"
+#include "InputProvider.h"
+#include "InputLog.h"
+#include "RewindBuffer.h"
 #include "Game.h"
-#include <vector>
-#include <memory>
 
 namespace ArkanoidGame
 {
@@ -18,60 +15,70 @@ namespace ArkanoidGame
 	/**
 	 * @brief Main game state for Arkanoid gameplay
 	 * 
-	 * This state handles the main game loop including:
+	 * This state connects the headless ArkanoidSim to the player:
 	 * - Platform movement controlled by arrow keys
-	 * - Ball physics and collision detection
-	 * - Score tracking and lives management
-	 * - Game over conditions
+	 * - Sounds for block hits and game over
+	 * - Score, lives and active effects display
+	 * - Switching to name input when the game ends
+	 * - Recording the inputs of every tick to LAST_REPLAY_FILE, saved when the state is left
+	 * - Rewinding the last REWIND_SECONDS while BACKSPACE is held, and instant retry with R
 	 */
 	class GameStatePlaying : public GameStateBase
 	{
 	private:
 		// Resource management
-		sf::Font font;
-		sf::SoundBuffer ballHitSoundBuffer;
-		sf::SoundBuffer gameOverSoundBuffer;
+		FontHandle font;
+		SoundBufferHandle ballHitSoundBuffer;
+		SoundBufferHandle gameOverSoundBuffer;
 
-		// Game objects
-		Platform platform;
-		Ball ball;
-		std::vector<std::unique_ptr<Block>> blocks;
-		BonusManager bonusManager;
-		int score = 0;
-		int lives = 3;
+		// Simulation and its view
+		ArkanoidSim sim;
+		ArkanoidRenderer renderer;
+		KeyboardInputProvider keyboardInput;
+		InputProvider* inputProvider = &keyboardInput; // Where the commands of each tick come from
+		InputLog inputLog; // Every tick of this game, saved on exit for replay
+		RewindBuffer rewindBuffer; // The last REWIND_SECONDS of play, sized for the running physics rate
+		SimSnapshot startSnapshot; // State at the first tick, for instant retry
 
 		// UI elements
 		sf::Text scoreText;
 		sf::Text livesText;
 		sf::Text inputHintText;
 		sf::Text activeEffectsText;
+		sf::Text bricksLeftText;
 		sf::RectangleShape background;
 
+		// HUD texts to rebuild, set from the sim events; a text is only rebuilt when its value changed
+		bool isScoreDirty = true;
+		bool areLivesDirty = true;
+		bool areEffectsDirty = true;
+		bool areBricksDirty = true;
+		char hudBuffer[256] = {};
+
 		// Audio
 		sf::Sound ballHitSound;
 		sf::Sound gameOverSound;
 
 		// Game state flags
 		bool isGameActive = false;
+		bool isRewindHeld = false; // BACKSPACE is down in the focused window
 
 	public:
-		GameStatePlaying();
+		explicit GameStatePlaying(Game& gameInstance);
 		~GameStatePlaying() = default;
 
+		void onEnter() override;
+		void onExit() override;
 		void handleWindowEvent(const sf::Event& event) override;
 		void update(float timeDelta) override;
 		void draw(sf::RenderWindow& window) override;
 
 	private:
 		void initializeUI();
-		void initializeGameObjects();
-		void initializeBlocks();
-		void setupBonusCallbacks();
-		void handleInput();
-		void checkCollisions();
-		void checkBlockCollisions();
-		void resetBall();
+		void handleSimEvents();
+		void updateUI();
 		void gameOver();
-		bool checkWinCondition();
+		void retry();
+		void markHudDirty();
 	};
 }
@@ -4,18 +4,16 @@
 
 namespace ArkanoidGame
 {
-	GameStateRecords::GameStateRecords()
+	GameStateRecords::GameStateRecords(Game& gameInstance)
+		: GameStateBase(gameInstance)
 	{
 		initializeUI();
 	}
 
 	void GameStateRecords::initializeUI()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
@@ -23,7 +21,7 @@ namespace ArkanoidGame
 		background.setFillColor(sf::Color(0, 50, 100));
 
 		// Initialize title text
-		titleText.setFont(font);
+		titleText.setFont(*font);
 		titleText.setString("HIGH SCORES");
 		titleText.setCharacterSize(36);
 		titleText.setFillColor(sf::Color::Yellow);
@@ -31,7 +29,7 @@ namespace ArkanoidGame
 		titleText.setPosition(SCREEN_WIDTH / 2, 100);
 
 		// Initialize hint text
-		hintText.setFont(font);
+		hintText.setFont(*font);
 		hintText.setString("Press ESC to return to main menu");
 		hintText.setCharacterSize(18);
 		hintText.setFillColor(sf::Color::White);
@@ -39,10 +37,10 @@ namespace ArkanoidGame
 		hintText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 50);
 
 		// Initialize records table texts
-		recordsTableTexts.resize(10);
-		for (int i = 0; i < 10; ++i)
+		recordsTableTexts.resize(MAX_RECORDS);
+		for (size_t i = 0; i < recordsTableTexts.size(); ++i)
 		{
-			recordsTableTexts[i].setFont(font);
+			recordsTableTexts[i].setFont(*font);
 			recordsTableTexts[i].setCharacterSize(20);
 			recordsTableTexts[i].setFillColor(sf::Color::White);
 		}
@@ -54,34 +52,23 @@ namespace ArkanoidGame
 	{
 		if (!game) return;
 
-		// Get records from Game class
-		const auto& recordsTable = game->GetRecordsTable();
-		
-		// Convert to vector and sort by score (descending)
-		std::vector<std::pair<std::string, int>> records;
-		for (const auto& record : recordsTable)
-		{
-			records.push_back({record.first, record.second});
-		}
-		
-		// Sort by score in descending order
-		std::sort(records.begin(), records.end(), 
-			[](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
-				return a.second > b.second;
-			});
-
-		// Display up to 10 records
-		size_t displayCount = std::min(records.size(), recordsTableTexts.size());
+		shownRecordsVersion = game->GetLeaderboard().getVersion();
+
+		// Ranking is cached by the leaderboard, best first
+		const std::vector<LeaderboardEntry>& ranking = game->GetLeaderboard().getRanking();
+
+		// Display up to MAX_RECORDS records
+		size_t displayCount = std::min(ranking.size(), recordsTableTexts.size());
 		
 		for (size_t i = 0; i < displayCount; ++i)
 		{
-			std::string recordText = std::to_string(i + 1) + ". " + records[i].first + " - " + std::to_string(records[i].second);
+			std::string recordText = std::to_string(i + 1) + ". " + ranking[i].name + " - " + std::to_string(ranking[i].score);
 			recordsTableTexts[i].setString(recordText);
 			recordsTableTexts[i].setOrigin(recordsTableTexts[i].getLocalBounds().width / 2, recordsTableTexts[i].getLocalBounds().height / 2);
 			recordsTableTexts[i].setPosition(SCREEN_WIDTH / 2, 200.0f + static_cast<float>(i) * 30.0f);
 		}
 		
-		// Clear remaining slots if there are fewer than 10 records
+		// Clear remaining slots if there are fewer than MAX_RECORDS records
 		for (size_t i = displayCount; i < recordsTableTexts.size(); ++i)
 		{
 			recordsTableTexts[i].setString("");
@@ -105,8 +92,11 @@ namespace ArkanoidGame
 
 	void GameStateRecords::update(float timeDelta)
 	{
-		// Update records table in case new records were added
-		updateRecordsTable();
+		// Rebuild the texts only when records were added
+		if (game->GetLeaderboard().getVersion() != shownRecordsVersion)
+		{
+			updateRecordsTable();
+		}
 	}
 
 	void GameStateRecords::draw(sf::RenderWindow& window)
@@ -1,6 +1,7 @@
 #pragma once
 #include "SFML/Graphics.hpp"
 #include "Game.h"
+#include <cstdint>
 
 namespace ArkanoidGame
 {
@@ -15,14 +16,15 @@ namespace ArkanoidGame
 	class GameStateRecords : public GameStateBase
 	{
 	private:
-		sf::Font font;
+		FontHandle font;
 		sf::Text titleText;
 		sf::Text hintText;
 		std::vector<sf::Text> recordsTableTexts;
+		uint32_t shownRecordsVersion = UINT32_MAX; // Leaderboard version the texts show
 		sf::RectangleShape background;
 
 	public:
-		GameStateRecords();
+		explicit GameStateRecords(Game& gameInstance);
 		~GameStateRecords() = default;
 
 		void handleWindowEvent(const sf::Event& event) override;
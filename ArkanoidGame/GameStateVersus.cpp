@@ -0,0 +1,229 @@
+#include "GameStateVersus.h"
+#include "GameSettings.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <random>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const float FIELD_SCALE = 0.5f; // Both fields fit side by side at half size
+		const float FIELD_TOP = (SCREEN_HEIGHT - SCREEN_HEIGHT * FIELD_SCALE) / 2;
+	}
+
+	GameStateVersus::GameStateVersus(Game& gameInstance)
+		: GameStateBase(gameInstance), link(socket), session(link, &gameInstance.GetLevels())
+	{
+		initializeUI();
+	}
+
+	void GameStateVersus::initializeUI()
+	{
+		// Shared font and sound, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
+		ballHitSoundBuffer = game->GetResources().GetSoundBuffer(SOUND_BALL_HIT_FILE);
+		ballHitSound.setBuffer(*ballHitSoundBuffer);
+
+		// Initialize background
+		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
+		background.setPosition(0.f, 0.f);
+		background.setFillColor(sf::Color(0, 50, 100));
+		fieldBackground.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
+		fieldBackground.setFillColor(sf::Color(0, 100, 200));
+
+		// Each field keeps its own coordinates and is scaled into a viewport
+		for (int i = 0; i < 2; ++i)
+		{
+			fieldViews[i].reset(sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, SCREEN_HEIGHT));
+			fieldViews[i].setViewport(sf::FloatRect(0.5f * i, FIELD_TOP / SCREEN_HEIGHT, FIELD_SCALE, FIELD_SCALE));
+
+			scoreTexts[i].setFont(*font);
+			scoreTexts[i].setCharacterSize(UI_FONT_SIZE_SMALL);
+			scoreTexts[i].setFillColor(sf::Color::Yellow);
+			scoreTexts[i].setPosition(SCREEN_WIDTH / 2 * i + 10, FIELD_TOP - 30);
+		}
+
+		localFieldFrame.setSize(sf::Vector2f(SCREEN_WIDTH * FIELD_SCALE - 4, SCREEN_HEIGHT * FIELD_SCALE - 4));
+		localFieldFrame.setFillColor(sf::Color::Transparent);
+		localFieldFrame.setOutlineColor(sf::Color::Yellow);
+		localFieldFrame.setOutlineThickness(2.f);
+
+		statusText.setFont(*font);
+		statusText.setCharacterSize(UI_FONT_SIZE_MEDIUM);
+		statusText.setFillColor(sf::Color::White);
+
+		inputHintText.setFont(*font);
+		inputHintText.setCharacterSize(UI_FONT_SIZE_SMALL);
+		inputHintText.setFillColor(sf::Color::White);
+		inputHintText.setString("LEFT/RIGHT: move | UP/DOWN: aim | SPACE: launch | ESC: leave");
+		inputHintText.setPosition(10, SCREEN_HEIGHT - 30);
+	}
+
+	void GameStateVersus::onEnter()
+	{
+		const VersusSettings& settings = game->GetVersusSettings();
+		const unsigned short port = settings.port != 0 ? settings.port : VERSUS_PORT;
+		link.setConditions(settings.conditions);
+		link.clear();
+		sessionTime = 0.0f;
+
+		if (settings.isHost)
+		{
+			hasSocket = socket.open(port);
+
+			// Same choice of level as a single player game
+			const unsigned int seed = std::random_device{}();
+			const LevelPack& levels = game->GetLevels();
+			const int levelIndex = levels.getLevelCount() > 0 ? static_cast<int>(seed % levels.getLevelCount()) : -1;
+			session.host(seed, levelIndex);
+			std::snprintf(hudBuffer, sizeof(hudBuffer), hasSocket ? "Waiting for a player on port %u" : "Cannot open port %u", port);
+		}
+		else
+		{
+			hasSocket = socket.open();
+			socket.setPeer(sf::IpAddress(settings.hostAddress), port);
+			session.join();
+			std::snprintf(hudBuffer, sizeof(hudBuffer), hasSocket ? "Joining %s:%u" : "Cannot open a port to join %s:%u",
+				settings.hostAddress.c_str(), port);
+		}
+		setStatus(hudBuffer);
+
+		const float localLeft = SCREEN_WIDTH / 2 * session.getLocalPlayer();
+		localFieldFrame.setPosition(localLeft + 2, FIELD_TOP + 2);
+		shownScores[0] = -1;
+		shownScores[1] = -1;
+		updateUI();
+	}
+
+	void GameStateVersus::onExit()
+	{
+		socket.close();
+		hasSocket = false;
+	}
+
+	void GameStateVersus::handleWindowEvent(const sf::Event& event)
+	{
+		if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
+		{
+			game->SwitchStateTo(GameStateType::MainMenu);
+		}
+	}
+
+	void GameStateVersus::update(float timeDelta)
+	{
+		if (!hasSocket)
+			return;
+
+		link.advance(timeDelta);
+
+		// The session ticks at RollbackSession::TIME_STEP on both peers, whatever the local physics rate,
+		// so both the match speed and the peer timeout stay in real time
+		const bool wasRunning = session.isRunning();
+		sessionTime += timeDelta;
+		if (sessionTime < RollbackSession::TIME_STEP)
+		{
+			return;
+		}
+
+		// Once the match stopped, keep answering so the peer can confirm it too
+		if (session.isFinished() || session.isDesynced() || session.isPeerLost())
+		{
+			for (; sessionTime >= RollbackSession::TIME_STEP; sessionTime -= RollbackSession::TIME_STEP)
+			{
+				session.poll();
+			}
+			return;
+		}
+
+		for (; sessionTime >= RollbackSession::TIME_STEP; sessionTime -= RollbackSession::TIME_STEP)
+		{
+			stepSession();
+		}
+
+		if (session.isDesynced())
+		{
+			std::snprintf(hudBuffer, sizeof(hudBuffer), "Out of sync with the other player at tick %u", session.getDesyncTick());
+			setStatus(hudBuffer);
+		}
+		else if (session.isPeerLost())
+		{
+			setStatus("Connection lost");
+		}
+		else if (session.isFinished())
+		{
+			const VersusOutcome outcome = session.getOutcome();
+			const bool isLocalWin = (outcome == VersusOutcome::Player1Won && session.getLocalPlayer() == 0) ||
+				(outcome == VersusOutcome::Player2Won && session.getLocalPlayer() == 1);
+			setStatus(outcome == VersusOutcome::Draw ? "Draw!" : (isLocalWin ? "You won!" : "You lost"));
+		}
+		else if (!wasRunning && session.isRunning())
+		{
+			setStatus("");
+		}
+		updateUI();
+	}
+
+	void GameStateVersus::stepSession()
+	{
+		SimInput input;
+		{
+			PROFILE_ZONE("Versus::input");
+			input = inputProvider->poll(session.getSim(session.getLocalPlayer()));
+		}
+
+		if (session.advance(input))
+		{
+			for (const SimEvent& simEvent : session.getSim(session.getLocalPlayer()).getEvents())
+			{
+				if (simEvent.type == SimEventType::BrickHit)
+				{
+					ballHitSound.play();
+					break;
+				}
+			}
+		}
+	}
+
+	void GameStateVersus::setStatus(const char* status)
+	{
+		statusText.setString(status);
+		statusText.setOrigin(statusText.getLocalBounds().width / 2, 0.f);
+		statusText.setPosition(SCREEN_WIDTH / 2, 20);
+	}
+
+	void GameStateVersus::updateUI()
+	{
+		// Scores change rarely, but a rollback can change them back, so compare rather than follow events
+		for (int i = 0; i < 2; ++i)
+		{
+			const int score = session.getSim(i).getScore();
+			if (score != shownScores[i])
+			{
+				shownScores[i] = score;
+				std::snprintf(hudBuffer, sizeof(hudBuffer), "Player %d%s: %d", i + 1, i == session.getLocalPlayer() ? " (you)" : "", score);
+				scoreTexts[i].setString(hudBuffer);
+			}
+		}
+	}
+
+	void GameStateVersus::draw(sf::RenderWindow& window)
+	{
+		window.draw(background);
+
+		const float interpolation = game->GetRenderInterpolation();
+		for (int i = 0; i < 2; ++i)
+		{
+			window.setView(fieldViews[i]);
+			window.draw(fieldBackground);
+			renderers[i].draw(window, session.getSim(i), interpolation);
+		}
+		window.setView(window.getDefaultView());
+
+		window.draw(localFieldFrame);
+		window.draw(scoreTexts[0]);
+		window.draw(scoreTexts[1]);
+		window.draw(statusText);
+		window.draw(inputHintText);
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "SFML/Graphics.hpp"
+#include "SFML/Audio.hpp"
+#include "ArkanoidRenderer.h"
+#include "InputProvider.h"
+#include "NetChannel.h"
+#include "RollbackSession.h"
+#include "Game.h"
+
+namespace ArkanoidGame
+{
+	class Game; // Forward declaration
+
+	/**
+	 * @brief Two-player versus over the network
+	 * 
+	 * Hosts or joins a match as the game's VersusSettings say and plays it
+	 * through a RollbackSession:
+	 * - Both fields side by side, the local one marked
+	 * - Local keys from an InputProvider, the remote player's from the network
+	 * - Outgoing packets pass a LossyChannel, so latency and loss can be simulated from the command line
+	 * - The result once both sides have confirmed it, or why the match stopped
+	 */
+	class GameStateVersus : public GameStateBase
+	{
+	private:
+		// Resource management
+		FontHandle font;
+		SoundBufferHandle ballHitSoundBuffer;
+
+		// Network and simulation
+		UdpChannel socket;
+		LossyChannel link;
+		RollbackSession session;
+		KeyboardInputProvider keyboardInput;
+		InputProvider* inputProvider = &keyboardInput; // Local player's commands
+		ArkanoidRenderer renderers[2];
+		sf::View fieldViews[2];                        // Each field scaled into its half of the window
+		bool hasSocket = false;
+		float sessionTime = 0.0f; // Time not yet spent on a whole session tick
+
+		// UI elements
+		sf::RectangleShape background;
+		sf::RectangleShape fieldBackground;  // In field coordinates, drawn in each field's view
+		sf::RectangleShape localFieldFrame;
+		sf::Text statusText;
+		sf::Text scoreTexts[2];
+		sf::Text inputHintText;
+		int shownScores[2] = { -1, -1 };
+		char hudBuffer[128] = {};
+
+		// Audio
+		sf::Sound ballHitSound;
+
+	public:
+		explicit GameStateVersus(Game& gameInstance);
+		~GameStateVersus() = default;
+
+		void onEnter() override;
+		void onExit() override;
+		void handleWindowEvent(const sf::Event& event) override;
+		void update(float timeDelta) override;
+		void draw(sf::RenderWindow& window) override;
+
+	private:
+		void initializeUI();
+		void updateUI();
+		void setStatus(const char* status);
+		void stepSession(); // One session tick with the local player's input
+	};
+}
@@ -3,7 +3,8 @@
 
 namespace ArkanoidGame
 {
-	GameStateWin::GameStateWin()
+	GameStateWin::GameStateWin(Game& gameInstance)
+		: GameStateBase(gameInstance)
 	{
 		initializeUI();
 		
@@ -17,11 +18,8 @@ namespace ArkanoidGame
 
 	void GameStateWin::initializeUI()
 	{
-		// Load font
-		if (!font.loadFromFile(FONTS_PATH + "Roboto-Regular.ttf"))
-		{
-			// Fallback to default font if loading fails
-		}
+		// Shared font, loaded once by the game
+		font = game->GetResources().GetFont(FONT_REGULAR_FILE);
 
 		// Initialize background
 		background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
@@ -29,7 +27,7 @@ namespace ArkanoidGame
 		background.setFillColor(sf::Color(0, 100, 0, 200)); // Green background
 
 		// Initialize congratulations text
-		congratulationsText.setFont(font);
+		congratulationsText.setFont(*font);
 		congratulationsText.setString("CONGRATULATIONS!");
 		congratulationsText.setCharacterSize(48);
 		congratulationsText.setFillColor(sf::Color::Yellow);
@@ -37,7 +35,7 @@ namespace ArkanoidGame
 		congratulationsText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 150);
 
 		// Initialize play again text
-		playAgainText.setFont(font);
+		playAgainText.setFont(*font);
 		playAgainText.setString("You destroyed all blocks!");
 		playAgainText.setCharacterSize(24);
 		playAgainText.setFillColor(sf::Color::White);
@@ -45,7 +43,7 @@ namespace ArkanoidGame
 		playAgainText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 100);
 
 		// Initialize yes text
-		yesText.setFont(font);
+		yesText.setFont(*font);
 		yesText.setString("Yes - Play Again");
 		yesText.setCharacterSize(24);
 		yesText.setFillColor(sf::Color::White);
@@ -53,7 +51,7 @@ namespace ArkanoidGame
 		yesText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
 
 		// Initialize no text
-		noText.setFont(font);
+		noText.setFont(*font);
 		noText.setString("No - Main Menu");
 		noText.setCharacterSize(24);
 		noText.setFillColor(sf::Color::White);
@@ -61,6 +59,13 @@ namespace ArkanoidGame
 		noText.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
 	}
 
+	void GameStateWin::onEnter()
+	{
+		// Every visit starts on the first option
+		selectedOption = 0;
+		updateMenuSelection();
+	}
+
 	void GameStateWin::handleWindowEvent(const sf::Event& event)
 	{
 		if (event.type == sf::Event::KeyPressed)
@@ -131,7 +136,7 @@ namespace ArkanoidGame
 		
 		// Draw control hint
 		sf::Text hintText;
-		hintText.setFont(font);
+		hintText.setFont(*font);
 		hintText.setString("Use UP/DOWN arrows to navigate, ENTER to select, ESC for Main Menu");
 		hintText.setCharacterSize(16);
 		hintText.setFillColor(sf::Color::Cyan);
@@ -15,7 +15,7 @@ namespace ArkanoidGame
 	class GameStateWin : public GameStateBase
 	{
 	private:
-		sf::Font font;
+		FontHandle font;
 		sf::Text congratulationsText;
 		sf::Text playAgainText;
 		sf::Text yesText;
@@ -28,9 +28,10 @@ namespace ArkanoidGame
 		sf::Text* menuOptions[MENU_OPTIONS_COUNT];
 
 	public:
-		GameStateWin();
+		explicit GameStateWin(Game& gameInstance);
 		~GameStateWin() = default;
 
+		void onEnter() override;
 		void handleWindowEvent(const sf::Event& event) override;
 		void update(float timeDelta) override;
 		void draw(sf::RenderWindow& window) override;
@@ -0,0 +1,261 @@
+#include "InputLog.h"
+#include <cstring>
+#include <fstream>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const char LOG_MAGIC[4] = { 'A', 'R', 'K', 'R' };
+		const uint8_t LOG_VERSION = 4; // Bumped whenever the game rules or the state hash change, since old logs would no longer replay
+
+		// Fixed little-endian layout, so logs move between machines
+		void WriteUInt(std::ostream& stream, uint64_t value, int byteCount)
+		{
+			for (int i = 0; i < byteCount; ++i)
+			{
+				stream.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+			}
+		}
+
+		bool ReadUInt(std::istream& stream, uint64_t& value, int byteCount)
+		{
+			value = 0;
+			for (int i = 0; i < byteCount; ++i)
+			{
+				const int byte = stream.get();
+				if (byte == std::char_traits<char>::eof())
+					return false;
+				value |= static_cast<uint64_t>(byte) << (8 * i);
+			}
+			return true;
+		}
+
+		// Run lengths are LEB128 varints: 7 bits per byte, high bit set on all but the last
+		void WriteVarint(std::ostream& stream, uint32_t value)
+		{
+			while (value >= 0x80)
+			{
+				stream.put(static_cast<char>((value & 0x7F) | 0x80));
+				value >>= 7;
+			}
+			stream.put(static_cast<char>(value));
+		}
+
+		bool ReadVarint(std::istream& stream, uint32_t& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 35; shift += 7)
+			{
+				const int byte = stream.get();
+				if (byte == std::char_traits<char>::eof())
+					return false;
+				value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+	}
+
+	uint8_t PackInput(const SimInput& input)
+	{
+		uint8_t bits = 0;
+		if (input.moveLeft) bits |= MoveLeftBit;
+		if (input.moveRight) bits |= MoveRightBit;
+		if (input.aimLeft) bits |= AimLeftBit;
+		if (input.aimRight) bits |= AimRightBit;
+		if (input.launch) bits |= LaunchBit;
+		return bits;
+	}
+
+	SimInput UnpackInput(uint8_t bits)
+	{
+		SimInput input;
+		input.moveLeft = (bits & MoveLeftBit) != 0;
+		input.moveRight = (bits & MoveRightBit) != 0;
+		input.aimLeft = (bits & AimLeftBit) != 0;
+		input.aimRight = (bits & AimRightBit) != 0;
+		input.launch = (bits & LaunchBit) != 0;
+		return input;
+	}
+
+	void InputLog::begin(unsigned int sessionSeed, int sessionLevelIndex)
+	{
+		seed = sessionSeed;
+		levelIndex = sessionLevelIndex;
+		timeStep = 0.0f;
+		inputs.clear();
+		checkpoints.clear();
+		finalHash = 0;
+	}
+
+	void InputLog::record(const SimInput& input, float tickTime, const ArkanoidSim& sim)
+	{
+		// The game always ticks at a fixed rate, so the first tick defines it
+		if (inputs.empty())
+		{
+			timeStep = tickTime;
+		}
+
+		inputs.push_back(PackInput(input));
+		if (inputs.size() % CHECKPOINT_INTERVAL == 0)
+		{
+			checkpoints.push_back(sim.computeStateHash());
+		}
+	}
+
+	void InputLog::truncate(uint32_t tickCount)
+	{
+		if (tickCount < inputs.size())
+		{
+			inputs.resize(tickCount);
+			checkpoints.resize(tickCount / CHECKPOINT_INTERVAL);
+		}
+	}
+
+	void InputLog::finish(const ArkanoidSim& sim)
+	{
+		finalHash = sim.computeStateHash();
+	}
+
+	bool InputLog::saveToFile(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		uint32_t timeStepBits;
+		std::memcpy(&timeStepBits, &timeStep, sizeof(timeStepBits));
+
+		file.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+		WriteUInt(file, LOG_VERSION, 1);
+		WriteUInt(file, seed, 4);
+		WriteUInt(file, static_cast<uint32_t>(levelIndex), 4);
+		WriteUInt(file, timeStepBits, 4);
+		WriteUInt(file, inputs.size(), 4);
+		WriteUInt(file, checkpoints.size(), 4);
+		WriteUInt(file, finalHash, 8);
+
+		// (mask, run length) pairs
+		size_t tick = 0;
+		while (tick < inputs.size())
+		{
+			const uint8_t bits = inputs[tick];
+			size_t runEnd = tick + 1;
+			while (runEnd < inputs.size() && inputs[runEnd] == bits)
+			{
+				++runEnd;
+			}
+			file.put(static_cast<char>(bits));
+			WriteVarint(file, static_cast<uint32_t>(runEnd - tick));
+			tick = runEnd;
+		}
+
+		for (uint64_t hash : checkpoints)
+		{
+			WriteUInt(file, hash, 8);
+		}
+		return file.good();
+	}
+
+	bool InputLog::loadFromFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		char magic[sizeof(LOG_MAGIC)];
+		if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0)
+		{
+			return false;
+		}
+
+		uint64_t version, seedValue, levelValue, timeStepBits, tickCount, checkpointCount, hash;
+		if (!ReadUInt(file, version, 1) || version != LOG_VERSION ||
+			!ReadUInt(file, seedValue, 4) || !ReadUInt(file, levelValue, 4) || !ReadUInt(file, timeStepBits, 4) ||
+			!ReadUInt(file, tickCount, 4) || !ReadUInt(file, checkpointCount, 4) ||
+			!ReadUInt(file, hash, 8))
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> loadedInputs;
+		loadedInputs.reserve(static_cast<size_t>(tickCount));
+		while (loadedInputs.size() < tickCount)
+		{
+			const int bits = file.get();
+			uint32_t runLength;
+			if (bits == std::char_traits<char>::eof() || !ReadVarint(file, runLength) || runLength > tickCount - loadedInputs.size())
+			{
+				return false;
+			}
+			loadedInputs.insert(loadedInputs.end(), runLength, static_cast<uint8_t>(bits));
+		}
+
+		std::vector<uint64_t> loadedCheckpoints(static_cast<size_t>(checkpointCount));
+		for (uint64_t& checkpoint : loadedCheckpoints)
+		{
+			if (!ReadUInt(file, checkpoint, 8))
+			{
+				return false;
+			}
+		}
+
+		const uint32_t timeStepBits32 = static_cast<uint32_t>(timeStepBits);
+		std::memcpy(&timeStep, &timeStepBits32, sizeof(timeStep));
+		seed = static_cast<unsigned int>(seedValue);
+		levelIndex = static_cast<int32_t>(static_cast<uint32_t>(levelValue));
+		inputs = std::move(loadedInputs);
+		checkpoints = std::move(loadedCheckpoints);
+		finalHash = hash;
+		return true;
+	}
+
+	ReplayResult ReplayInputLog(const InputLog& log, ArkanoidSim& sim, const LevelPack* levels)
+	{
+		ReplayResult result;
+		const int levelIndex = log.getLevelIndex();
+		if (levelIndex >= 0 && (!levels || static_cast<size_t>(levelIndex) >= levels->getLevelCount()))
+		{
+			// The level the log was played on is not available
+			result.firstMismatchTick = 0;
+			return result;
+		}
+		sim.reset(log.getSeed(), levelIndex >= 0 ? levels->getLevel(levelIndex) : LevelView());
+
+		const std::vector<uint64_t>& checkpoints = log.getCheckpoints();
+		const uint32_t tickCount = log.getTickCount();
+		const float timeStep = log.getTimeStep();
+		bool isMatching = true;
+
+		for (uint32_t tick = 0; tick < tickCount; ++tick)
+		{
+			sim.step(UnpackInput(log.getInputBits(tick)), timeStep);
+
+			const uint32_t ticksDone = tick + 1;
+			if (ticksDone % InputLog::CHECKPOINT_INTERVAL == 0)
+			{
+				const size_t checkpoint = ticksDone / InputLog::CHECKPOINT_INTERVAL - 1;
+				if (checkpoint < checkpoints.size() && checkpoints[checkpoint] != sim.computeStateHash() && isMatching)
+				{
+					isMatching = false;
+					result.firstMismatchTick = ticksDone;
+				}
+			}
+		}
+
+		result.ticks = tickCount;
+		result.finalHash = sim.computeStateHash();
+		result.isMatching = isMatching && result.finalHash == log.getFinalHash();
+		if (!result.isMatching && result.firstMismatchTick < 0)
+		{
+			result.firstMismatchTick = tickCount;
+		}
+		return result;
+	}
+}
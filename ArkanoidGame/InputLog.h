@@ -0,0 +1,85 @@
+#pragma once
+#include "ArkanoidSim.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	// One bit per SimInput key in a recorded tick
+	enum InputBits : uint8_t
+	{
+		MoveLeftBit = 1 << 0,
+		MoveRightBit = 1 << 1,
+		AimLeftBit = 1 << 2,
+		AimRightBit = 1 << 3,
+		LaunchBit = 1 << 4,
+	};
+
+	uint8_t PackInput(const SimInput& input);
+	SimInput UnpackInput(uint8_t bits);
+
+	/**
+	 * @brief Recorded session: seed, level, tick length and one key bitmask per tick
+	 * 
+	 * Together with the headless ArkanoidSim this is enough to reproduce a game
+	 * bit for bit. A state hash is stored every CHECKPOINT_INTERVAL ticks and at
+	 * the end, so a replay can tell exactly where it diverged.
+	 * On disk the masks are run-length encoded, since keys change rarely.
+	 */
+	class InputLog
+	{
+	public:
+		static constexpr uint32_t CHECKPOINT_INTERVAL = 256;
+
+	private:
+		unsigned int seed = 0;
+		int levelIndex = -1;               // Level in the game's LevelPack, -1 for a generated layout
+		float timeStep = 0.0f;
+		std::vector<uint8_t> inputs;       // Key bitmask per tick
+		std::vector<uint64_t> checkpoints; // State hash after every CHECKPOINT_INTERVAL ticks
+		uint64_t finalHash = 0;
+
+	public:
+		// Start a new recording for a sim that was just reset with sessionSeed on level sessionLevelIndex
+		void begin(unsigned int sessionSeed, int sessionLevelIndex = -1);
+
+		// Append the input of a tick, after sim has been stepped with it
+		void record(const SimInput& input, float tickTime, const ArkanoidSim& sim);
+
+		// Drop every tick after the first tickCount, after the sim was rewound to that tick
+		void truncate(uint32_t tickCount);
+
+		// Store the hash of the last state
+		void finish(const ArkanoidSim& sim);
+
+		bool saveToFile(const std::string& path) const;
+		bool loadFromFile(const std::string& path);
+
+		// Getters
+		unsigned int getSeed() const { return seed; }
+		int getLevelIndex() const { return levelIndex; }
+		float getTimeStep() const { return timeStep; }
+		uint32_t getTickCount() const { return static_cast<uint32_t>(inputs.size()); }
+		uint8_t getInputBits(uint32_t tick) const { return inputs[tick]; }
+		const std::vector<uint64_t>& getCheckpoints() const { return checkpoints; }
+		uint64_t getFinalHash() const { return finalHash; }
+	};
+
+	/**
+	 * @brief Outcome of replaying an InputLog
+	 */
+	struct ReplayResult
+	{
+		uint32_t ticks = 0;
+		uint64_t finalHash = 0;
+		bool isMatching = false;      // Every checkpoint and the final hash agree with the log
+		int64_t firstMismatchTick = -1; // Tick of the first checkpoint that differs, -1 if none
+	};
+
+	/**
+	 * @brief Resets sim with the log seed and level and steps it through every recorded tick as fast as possible
+	 * @param levels Pack the level index refers to; logs of generated layouts need none
+	 */
+	ReplayResult ReplayInputLog(const InputLog& log, ArkanoidSim& sim, const LevelPack* levels = nullptr);
+}
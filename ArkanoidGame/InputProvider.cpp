@@ -0,0 +1,21 @@
+#include "InputProvider.h"
+#include <SFML/Window/Keyboard.hpp>
+
+namespace ArkanoidGame
+{
+	SimInput KeyboardInputProvider::poll(const ArkanoidSim& /*sim*/)
+	{
+		SimInput input;
+
+		// Platform movement
+		input.moveLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+		input.moveRight = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+
+		// Ball aiming with Up/Down arrows and launch with Space
+		input.aimLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+		input.aimRight = sf::Keyboard::isKeyPressed(sf::Keyboard::Down);
+		input.launch = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+
+		return input;
+	}
+}
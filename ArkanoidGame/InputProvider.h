@@ -0,0 +1,30 @@
+#pragma once
+#include "ArkanoidSim.h"
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Source of a player's commands, asked once per simulation tick
+	 * 
+	 * Game states step their sims with whatever their provider returns, so a
+	 * player can be driven by the keyboard, a bot or the network without the
+	 * state knowing which.
+	 */
+	class InputProvider
+	{
+	public:
+		virtual ~InputProvider() = default;
+
+		// Commands for the next step of sim
+		virtual SimInput poll(const ArkanoidSim& sim) = 0;
+	};
+
+	/**
+	 * @brief Reads the arrow keys and SPACE
+	 */
+	class KeyboardInputProvider : public InputProvider
+	{
+	public:
+		SimInput poll(const ArkanoidSim& sim) override;
+	};
+}
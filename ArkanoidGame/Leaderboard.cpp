@@ -0,0 +1,69 @@
+#include "Leaderboard.h"
+
+namespace ArkanoidGame
+{
+	Leaderboard::Leaderboard(size_t boardCapacity)
+		: capacity(boardCapacity)
+	{
+		nameIndex.reserve(capacity + 1);
+	}
+
+	bool Leaderboard::set(const std::string& playerName, int score)
+	{
+		auto indexIt = nameIndex.find(playerName);
+		if (indexIt == nameIndex.end())
+		{
+			// A new player below the lowest score of a full board would leave it at once
+			if (!isScoreHighEnough(score))
+			{
+				return false;
+			}
+			indexIt = nameIndex.emplace(playerName, entries.end()).first;
+		}
+		else
+		{
+			entries.erase(indexIt->second);
+		}
+		indexIt->second = entries.emplace(score, playerName);
+
+		if (entries.size() > capacity)
+		{
+			auto lowest = std::prev(entries.end());
+			nameIndex.erase(lowest->second);
+			entries.erase(lowest);
+		}
+
+		++version;
+		isRankingDirty = true;
+		return contains(playerName);
+	}
+
+	void Leaderboard::clear()
+	{
+		entries.clear();
+		nameIndex.clear();
+		++version;
+		isRankingDirty = true;
+	}
+
+	int Leaderboard::getScore(const std::string& playerName) const
+	{
+		auto it = nameIndex.find(playerName);
+		return (it != nameIndex.end()) ? it->second->first : 0;
+	}
+
+	const std::vector<LeaderboardEntry>& Leaderboard::getRanking() const
+	{
+		if (isRankingDirty)
+		{
+			ranking.clear();
+			ranking.reserve(entries.size());
+			for (const auto& entry : entries)
+			{
+				ranking.push_back({ entry.second, entry.first });
+			}
+			isRankingDirty = false;
+		}
+		return ranking;
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	struct LeaderboardEntry
+	{
+		std::string name;
+		int score = 0;
+	};
+
+	/**
+	 * @brief The best scores, one per player name, limited to a fixed count
+	 *
+	 * Scores are kept ordered (best first) with an index from name to entry,
+	 * so setting a score costs O(log n), the lowest score on the board is
+	 * known in O(1) and a score too low for a full board is rejected without
+	 * touching it. getRanking() caches the ordered view until the next change;
+	 * screens compare getVersion() to know when to rebuild their texts.
+	 */
+	class Leaderboard
+	{
+	private:
+		using ScoreOrder = std::multimap<int, std::string, std::greater<int>>;
+
+		ScoreOrder entries; // Best first; equal scores keep the order they were set in
+		std::unordered_map<std::string, ScoreOrder::iterator> nameIndex;
+		size_t capacity;
+		uint32_t version = 0;
+
+		mutable std::vector<LeaderboardEntry> ranking;
+		mutable bool isRankingDirty = true;
+
+	public:
+		explicit Leaderboard(size_t boardCapacity);
+
+		/**
+		 * @brief Sets the score of a player, replacing any earlier one
+		 *
+		 * When the board overflows, the lowest score leaves it.
+		 * @return Whether the player is on the board afterwards
+		 */
+		bool set(const std::string& playerName, int score);
+		void clear();
+
+		// Whether a new player with this score would make it onto the board
+		bool isScoreHighEnough(int score) const { return entries.size() < capacity || score > getLowestScore(); }
+
+		// Score of the player, or 0 if the player is not on the board
+		int getScore(const std::string& playerName) const;
+		bool contains(const std::string& playerName) const { return nameIndex.count(playerName) != 0; }
+
+		// Lowest score on the board, 0 when it is empty
+		int getLowestScore() const { return entries.empty() ? 0 : std::prev(entries.end())->first; }
+
+		// Entries best first, rebuilt only after a change
+		const std::vector<LeaderboardEntry>& getRanking() const;
+
+		// Getters
+		size_t size() const { return entries.size(); }
+		bool empty() const { return entries.empty(); }
+		size_t getCapacity() const { return capacity; }
+		uint32_t getVersion() const { return version; }
+	};
+}
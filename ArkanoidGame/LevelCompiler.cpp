@@ -0,0 +1,246 @@
+#include "LevelCompiler.h"
+#include "GameSettings.h"
+#include "LevelPack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const char* const LEVEL_SOURCE_MAGIC = "arkanoid-level";
+		const int LEVEL_SOURCE_VERSION = 1;
+
+		bool ParseBlockType(const std::string& text, BlockType& type)
+		{
+			if (text == "regular") type = BlockType::Regular;
+			else if (text == "durable") type = BlockType::Durable;
+			else if (text == "glass") type = BlockType::Glass;
+			else return false;
+			return true;
+		}
+
+		// Reads "<type> <points> <color> [hits]" and checks the values
+		bool ParseBrickProperties(std::istringstream& line, LevelSourceBrick& brick, std::string& problem)
+		{
+			std::string typeName;
+			if (!(line >> typeName >> brick.points >> brick.colorIndex))
+			{
+				problem = "expected <type> <points> <color> [hits]";
+				return false;
+			}
+			if (!ParseBlockType(typeName, brick.type))
+			{
+				problem = "unknown brick type '" + typeName + "'";
+				return false;
+			}
+			if (brick.colorIndex < 0 || brick.colorIndex >= BLOCK_COLOR_COUNT)
+			{
+				problem = "color must be 0 to " + std::to_string(BLOCK_COLOR_COUNT - 1);
+				return false;
+			}
+
+			brick.hits = brick.type == BlockType::Durable ? 3 : 1;
+			int hits;
+			if (line >> hits)
+			{
+				brick.hits = hits;
+			}
+			if (brick.hits < 1 || brick.hits > 255)
+			{
+				problem = "hits must be 1 to 255";
+				return false;
+			}
+			return true;
+		}
+
+		template<typename T>
+		void WriteColumn(std::ostream& stream, const std::vector<LevelSourceBrick>& bricks, T LevelSourceBrick::* field)
+		{
+			for (const LevelSourceBrick& brick : bricks)
+			{
+				stream.write(reinterpret_cast<const char*>(&(brick.*field)), sizeof(T));
+			}
+		}
+
+		template<typename T>
+		void WriteNarrowColumn(std::ostream& stream, const std::vector<LevelSourceBrick>& bricks, T LevelSourceBrick::* field)
+		{
+			for (const LevelSourceBrick& brick : bricks)
+			{
+				stream.put(static_cast<char>(brick.*field));
+			}
+		}
+	}
+
+	bool LoadLevelSource(const std::string& path, LevelSource& level, std::string& error)
+	{
+		std::ifstream file(path);
+		if (!file.is_open())
+		{
+			error = path + ": cannot open";
+			return false;
+		}
+
+		level = LevelSource();
+		float brickWidth = BLOCK_WIDTH;
+		float brickHeight = BLOCK_HEIGHT;
+		bool hasVersion = false;
+		std::string text;
+		for (int lineNumber = 1; std::getline(file, text); ++lineNumber)
+		{
+			text = text.substr(0, text.find('#'));
+			std::istringstream line(text);
+			std::string directive;
+			if (!(line >> directive))
+				continue;
+
+			std::string problem;
+			if (!hasVersion)
+			{
+				int version = 0;
+				if (directive != LEVEL_SOURCE_MAGIC || !(line >> version) || version != LEVEL_SOURCE_VERSION)
+				{
+					problem = std::string("expected '") + LEVEL_SOURCE_MAGIC + " " + std::to_string(LEVEL_SOURCE_VERSION) + "'";
+				}
+				hasVersion = true;
+			}
+			else if (directive == "name")
+			{
+				std::getline(line >> std::ws, level.name);
+				if (level.name.empty() || level.name.size() >= LEVEL_NAME_SIZE)
+				{
+					problem = "name must be 1 to " + std::to_string(LEVEL_NAME_SIZE - 1) + " characters";
+				}
+			}
+			else if (directive == "size")
+			{
+				if (!(line >> brickWidth >> brickHeight) || !(brickWidth > 0.0f) || !(brickHeight > 0.0f))
+				{
+					problem = "expected a positive <width> <height>";
+				}
+			}
+			else if (directive == "brick")
+			{
+				LevelSourceBrick brick;
+				brick.width = brickWidth;
+				brick.height = brickHeight;
+				if (!(line >> brick.x >> brick.y))
+				{
+					problem = "expected <x> <y>";
+				}
+				else if (ParseBrickProperties(line, brick, problem))
+				{
+					level.bricks.push_back(brick);
+				}
+			}
+			else if (directive == "grid")
+			{
+				float startX, startY, spacingX, spacingY;
+				int columns, rows;
+				LevelSourceBrick brick;
+				brick.width = brickWidth;
+				brick.height = brickHeight;
+				if (!(line >> startX >> startY >> columns >> rows >> spacingX >> spacingY) || columns < 1 || rows < 1)
+				{
+					problem = "expected <x> <y> <columns> <rows> <spacingX> <spacingY>";
+				}
+				else if (ParseBrickProperties(line, brick, problem))
+				{
+					for (int row = 0; row < rows; ++row)
+					{
+						for (int column = 0; column < columns; ++column)
+						{
+							brick.x = startX + column * (brickWidth + spacingX);
+							brick.y = startY + row * (brickHeight + spacingY);
+							level.bricks.push_back(brick);
+						}
+					}
+				}
+			}
+			else
+			{
+				problem = "unknown directive '" + directive + "'";
+			}
+
+			if (!problem.empty())
+			{
+				error = path + ":" + std::to_string(lineNumber) + ": " + problem;
+				return false;
+			}
+		}
+
+		if (level.name.empty() || level.bricks.empty())
+		{
+			error = path + ": a level needs a name and at least one brick";
+			return false;
+		}
+		return true;
+	}
+
+	bool WriteLevelPack(const std::string& path, const std::vector<LevelSource>& levels, std::string& error)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			error = path + ": cannot write";
+			return false;
+		}
+
+		LevelPackHeader header = {};
+		std::memcpy(header.magic, LEVEL_PACK_MAGIC, sizeof(LEVEL_PACK_MAGIC));
+		header.version = LEVEL_PACK_VERSION;
+		header.levelCount = static_cast<uint32_t>(levels.size());
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		// Levels follow the index, each starting 8-byte aligned
+		uint64_t offset = sizeof(LevelPackHeader) + levels.size() * sizeof(LevelPackIndexEntry);
+		std::vector<uint64_t> offsets;
+		for (const LevelSource& level : levels)
+		{
+			offset = (offset + 7) / 8 * 8;
+			offsets.push_back(offset);
+
+			LevelPackIndexEntry entry = {};
+			entry.offset = offset;
+			entry.brickCount = static_cast<uint32_t>(level.bricks.size());
+			std::memcpy(entry.name, level.name.data(), std::min(level.name.size(), LEVEL_NAME_SIZE - 1));
+
+			// Cells as large as the largest brick, so each brick covers at most four cells
+			for (const LevelSourceBrick& brick : level.bricks)
+			{
+				entry.cellWidth = std::max(entry.cellWidth, brick.width);
+				entry.cellHeight = std::max(entry.cellHeight, brick.height);
+			}
+			file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+			offset += level.bricks.size() * LEVEL_BYTES_PER_BRICK;
+		}
+
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			const std::vector<LevelSourceBrick>& bricks = levels[i].bricks;
+			while (static_cast<uint64_t>(file.tellp()) < offsets[i])
+			{
+				file.put(0);
+			}
+
+			WriteColumn(file, bricks, &LevelSourceBrick::x);
+			WriteColumn(file, bricks, &LevelSourceBrick::y);
+			WriteColumn(file, bricks, &LevelSourceBrick::width);
+			WriteColumn(file, bricks, &LevelSourceBrick::height);
+			WriteColumn(file, bricks, &LevelSourceBrick::points);
+			WriteNarrowColumn(file, bricks, &LevelSourceBrick::hits);
+			WriteNarrowColumn(file, bricks, &LevelSourceBrick::type);
+			WriteNarrowColumn(file, bricks, &LevelSourceBrick::colorIndex);
+		}
+
+		if (!file.good())
+		{
+			error = path + ": write failed";
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "BrickField.h"
+#include <string>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	struct LevelSourceBrick
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+		float width = 0.0f;
+		float height = 0.0f;
+		BlockType type = BlockType::Regular;
+		int points = 0;
+		int colorIndex = 0;
+		int hits = 1;
+	};
+
+	/**
+	 * @brief A level as written by a designer, before compilation
+	 *
+	 * Text format, one directive per line; '#' starts a comment:
+	 *   arkanoid-level 1                 - required first directive, the format version
+	 *   name <text>                      - level name, up to LEVEL_NAME_SIZE - 1 characters
+	 *   size <width> <height>            - size of the bricks that follow (default BLOCK_WIDTH x BLOCK_HEIGHT)
+	 *   brick <x> <y> <type> <points> <color> [hits]
+	 *   grid <x> <y> <columns> <rows> <spacingX> <spacingY> <type> <points> <color> [hits]
+	 * Types are regular, durable and glass; durable bricks need 3 hits unless given.
+	 */
+	struct LevelSource
+	{
+		std::string name;
+		std::vector<LevelSourceBrick> bricks;
+	};
+
+	// Parse a level text file; on failure error names the file, line and problem
+	bool LoadLevelSource(const std::string& path, LevelSource& level, std::string& error);
+
+	// Write levels as a pack that LevelPack can map, in the given order
+	bool WriteLevelPack(const std::string& path, const std::vector<LevelSource>& levels, std::string& error);
+}
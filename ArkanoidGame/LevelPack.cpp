@@ -0,0 +1,88 @@
+#include "LevelPack.h"
+#include <cstring>
+
+namespace ArkanoidGame
+{
+	bool LevelPack::open(const std::string& path)
+	{
+		close();
+		if (!file.open(path) || file.getSize() < sizeof(LevelPackHeader))
+		{
+			file.close();
+			return false;
+		}
+
+		LevelPackHeader header;
+		std::memcpy(&header, file.getData(), sizeof(header));
+		const uint64_t indexEnd = sizeof(LevelPackHeader) + static_cast<uint64_t>(header.levelCount) * sizeof(LevelPackIndexEntry);
+		if (std::memcmp(header.magic, LEVEL_PACK_MAGIC, sizeof(LEVEL_PACK_MAGIC)) != 0 || header.version != LEVEL_PACK_VERSION || indexEnd > file.getSize())
+		{
+			file.close();
+			return false;
+		}
+
+		// Every level must lie inside the file, so getLevel() needs no checks
+		levelCount = header.levelCount;
+		for (size_t i = 0; i < levelCount; ++i)
+		{
+			const LevelPackIndexEntry entry = readIndexEntry(i);
+			const uint64_t levelSize = static_cast<uint64_t>(entry.brickCount) * LEVEL_BYTES_PER_BRICK;
+			if (entry.brickCount == 0 || entry.offset % 8 != 0 || entry.offset < indexEnd || entry.offset + levelSize > file.getSize() ||
+				!(entry.cellWidth > 0.0f) || !(entry.cellHeight > 0.0f) || entry.name[LEVEL_NAME_SIZE - 1] != '\0')
+			{
+				close();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void LevelPack::close()
+	{
+		file.close();
+		levelCount = 0;
+	}
+
+	LevelView LevelPack::getLevel(size_t index) const
+	{
+		const char* indexEntry = file.getData() + sizeof(LevelPackHeader) + index * sizeof(LevelPackIndexEntry);
+		const LevelPackIndexEntry entry = readIndexEntry(index);
+		const size_t count = entry.brickCount;
+		const char* columns = file.getData() + entry.offset;
+
+		LevelView level;
+		level.name = indexEntry + offsetof(LevelPackIndexEntry, name);
+		level.cellWidth = entry.cellWidth;
+		level.cellHeight = entry.cellHeight;
+		level.bricks.count = count;
+		level.bricks.x = reinterpret_cast<const float*>(columns);
+		level.bricks.y = reinterpret_cast<const float*>(columns + count * 4);
+		level.bricks.width = reinterpret_cast<const float*>(columns + count * 8);
+		level.bricks.height = reinterpret_cast<const float*>(columns + count * 12);
+		level.bricks.points = reinterpret_cast<const int32_t*>(columns + count * 16);
+		level.bricks.maxHits = reinterpret_cast<const uint8_t*>(columns + count * 20);
+		level.bricks.types = reinterpret_cast<const uint8_t*>(columns + count * 21);
+		level.bricks.colorIndices = reinterpret_cast<const uint8_t*>(columns + count * 22);
+		return level;
+	}
+
+	int LevelPack::findLevel(const std::string& name) const
+	{
+		for (size_t i = 0; i < levelCount; ++i)
+		{
+			if (name == getLevel(i).name)
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	LevelPackIndexEntry LevelPack::readIndexEntry(size_t index) const
+	{
+		// Copied out, since the index has no alignment guarantee in memory
+		LevelPackIndexEntry entry;
+		std::memcpy(&entry, file.getData() + sizeof(LevelPackHeader) + index * sizeof(LevelPackIndexEntry), sizeof(entry));
+		return entry;
+	}
+}
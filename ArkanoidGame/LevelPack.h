@@ -0,0 +1,88 @@
+#pragma once
+#include "BrickField.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief On-disk layout of a compiled level pack, version LEVEL_PACK_VERSION
+	 *
+	 * All values are little-endian, the byte order of every platform the game
+	 * runs on, so columns are read without conversion. The file starts with a
+	 * LevelPackHeader, followed by levelCount LevelPackIndexEntry records, so
+	 * any level is found with one index lookup. Each level is a block of brick columns starting at
+	 * an 8-byte aligned offset: x, y, width, height (float), points (int32),
+	 * then maxHits, type and color index (uint8), brickCount values each.
+	 * Packs are written by the compile command of ArkanoidTools from text
+	 * sources; the game itself never parses level text.
+	 */
+	constexpr char LEVEL_PACK_MAGIC[4] = { 'A', 'R', 'K', 'L' };
+	constexpr uint32_t LEVEL_PACK_VERSION = 1;
+	constexpr size_t LEVEL_NAME_SIZE = 48; // Including the terminating zero
+	constexpr size_t LEVEL_BYTES_PER_BRICK = 5 * 4 + 3;
+
+	struct LevelPackHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t levelCount;
+		uint32_t reserved;
+	};
+
+	struct LevelPackIndexEntry
+	{
+		uint64_t offset;     // Start of the brick columns from the beginning of the file
+		uint32_t brickCount;
+		float cellWidth;     // Broadphase cell size suited to the level's bricks
+		float cellHeight;
+		uint32_t reserved;
+		char name[LEVEL_NAME_SIZE];
+	};
+
+	static_assert(sizeof(LevelPackHeader) == 16, "Level pack header must match the file layout");
+	static_assert(sizeof(LevelPackIndexEntry) == 72, "Level pack index entry must match the file layout");
+
+	/**
+	 * @brief One level of a pack, pointing into the mapped file
+	 */
+	struct LevelView
+	{
+		const char* name = "";
+		float cellWidth = 0.0f;
+		float cellHeight = 0.0f;
+		BrickColumns bricks;
+
+		// A default view means no level: the sim generates its layout instead
+		bool isValid() const { return bricks.x != nullptr; }
+	};
+
+	/**
+	 * @brief Compiled levels, memory-mapped for the lifetime of the pack
+	 *
+	 * open() checks the header and index only, so it costs the same for any
+	 * number of bricks. Level views stay valid until the pack is closed.
+	 */
+	class LevelPack
+	{
+	private:
+		MappedFile file;
+		uint32_t levelCount = 0;
+
+	public:
+		// Map a pack and validate its index; returns false and stays empty if the file is missing or malformed
+		bool open(const std::string& path);
+		void close();
+
+		size_t getLevelCount() const { return levelCount; }
+		LevelView getLevel(size_t index) const;
+
+		// Index of the level with this name, or -1
+		int findLevel(const std::string& name) const;
+
+	private:
+		LevelPackIndexEntry readIndexEntry(size_t index) const;
+	};
+}
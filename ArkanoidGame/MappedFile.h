@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Read-only memory mapping of a whole file
+	 *
+	 * The operating system pages the file in on first access, so opening is
+	 * cheap however large the file is, and the bytes can be read in place
+	 * without copying them into a buffer first.
+	 */
+	class MappedFile
+	{
+	private:
+		const char* data = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		void* fileHandle = nullptr;
+		void* mappingHandle = nullptr;
+#endif
+
+	public:
+		MappedFile() = default;
+		~MappedFile() { close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Map the file, closing any file mapped before; returns false if it cannot be opened or is empty
+		bool open(const std::string& path);
+		void close();
+
+		// Getters
+		bool isOpen() const { return data != nullptr; }
+		const char* getData() const { return data; }
+		size_t getSize() const { return size; }
+	};
+}
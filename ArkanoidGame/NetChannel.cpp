@@ -0,0 +1,108 @@
+#include "NetChannel.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ArkanoidGame
+{
+	bool UdpChannel::open(unsigned short localPort)
+	{
+		socket.unbind();
+		isPeerKnown = false;
+		const unsigned short port = localPort == 0 ? static_cast<unsigned short>(sf::Socket::AnyPort) : localPort;
+		if (socket.bind(port) != sf::Socket::Done)
+		{
+			return false;
+		}
+
+		// Polled once per tick, so a missing packet must never block the game
+		socket.setBlocking(false);
+		return true;
+	}
+
+	void UdpChannel::close()
+	{
+		socket.unbind();
+		isPeerKnown = false;
+	}
+
+	void UdpChannel::setPeer(const sf::IpAddress& address, unsigned short port)
+	{
+		peerAddress = address;
+		peerPort = port;
+		isPeerKnown = true;
+	}
+
+	void UdpChannel::send(const void* data, size_t size)
+	{
+		if (!isPeerKnown)
+			return;
+
+		// A full send buffer drops the packet, which the protocol has to survive anyway
+		socket.send(data, size, peerAddress, peerPort);
+	}
+
+	size_t UdpChannel::receive(void* buffer, size_t capacity)
+	{
+		sf::IpAddress sender;
+		unsigned short senderPort = 0;
+		size_t size = 0;
+		while (socket.receive(buffer, capacity, size, sender, senderPort) == sf::Socket::Done)
+		{
+			if (!isPeerKnown)
+			{
+				setPeer(sender, senderPort);
+			}
+			if (sender == peerAddress && senderPort == peerPort && size > 0)
+			{
+				return size;
+			}
+		}
+		return 0;
+	}
+
+	LossyChannel::LossyChannel(PacketChannel& innerChannel, const NetConditions& netConditions, uint32_t seed)
+		: channel(innerChannel), conditions(netConditions), random(seed)
+	{
+	}
+
+	void LossyChannel::send(const void* data, size_t size)
+	{
+		if (conditions.lossRate > 0.0f && random.nextFloat() < conditions.lossRate)
+		{
+			++droppedCount;
+			return;
+		}
+
+		const bool isDelayed = conditions.latency > 0.0f || conditions.jitter > 0.0f;
+		if (!isDelayed || size > MAX_DATAGRAM_SIZE)
+		{
+			channel.send(data, size);
+			return;
+		}
+
+		DelayedPacket packet;
+		packet.deliveryTime = time + conditions.latency + conditions.jitter * random.nextFloat();
+		packet.size = size;
+		std::memcpy(packet.data.data(), data, size);
+		delayedPackets.push_back(packet);
+	}
+
+	void LossyChannel::advance(float seconds)
+	{
+		time += seconds;
+
+		// Due packets go out in the order of their delivery time, so jitter reorders them
+		if (conditions.jitter > 0.0f)
+		{
+			std::stable_sort(delayedPackets.begin(), delayedPackets.end(),
+				[](const DelayedPacket& first, const DelayedPacket& second) { return first.deliveryTime < second.deliveryTime; });
+		}
+		size_t dueCount = 0;
+		while (dueCount < delayedPackets.size() && delayedPackets[dueCount].deliveryTime <= time)
+		{
+			channel.send(delayedPackets[dueCount].data.data(), delayedPackets[dueCount].size);
+			++dueCount;
+		}
+		delayedPackets.erase(delayedPackets.begin(), delayedPackets.begin() + dueCount);
+	}
+}
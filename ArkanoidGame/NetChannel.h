@@ -0,0 +1,123 @@
+#pragma once
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include "SimRandom.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	constexpr size_t MAX_DATAGRAM_SIZE = 512; // Largest packet a channel has to carry
+
+	/**
+	 * @brief Unreliable, unordered datagram link to one peer
+	 */
+	class PacketChannel
+	{
+	public:
+		virtual ~PacketChannel() = default;
+
+		// Send one datagram to the peer; it may be lost, duplicated or overtaken by later ones
+		virtual void send(const void* data, size_t size) = 0;
+
+		// Copy the next waiting datagram into buffer and return its size, 0 when none is waiting
+		virtual size_t receive(void* buffer, size_t capacity) = 0;
+	};
+
+	/**
+	 * @brief PacketChannel over a non-blocking sf::UdpSocket
+	 * 
+	 * Without a peer set, the sender of the first datagram becomes the peer,
+	 * which is how a host learns the address of whoever joined it. Datagrams
+	 * from anyone else are dropped after that.
+	 */
+	class UdpChannel : public PacketChannel
+	{
+	private:
+		sf::UdpSocket socket;
+		sf::IpAddress peerAddress;
+		unsigned short peerPort = 0;
+		bool isPeerKnown = false;
+
+	public:
+		// Bind to localPort, or to any free port for 0; false if the port is taken
+		bool open(unsigned short localPort = 0);
+		void close();
+
+		void setPeer(const sf::IpAddress& address, unsigned short port);
+		bool hasPeer() const { return isPeerKnown; }
+		unsigned short getLocalPort() const { return socket.getLocalPort(); }
+
+		void send(const void* data, size_t size) override;
+		size_t receive(void* buffer, size_t capacity) override;
+	};
+
+	/**
+	 * @brief Network conditions to simulate on a link
+	 */
+	struct NetConditions
+	{
+		float latency = 0.0f;   // One-way delay in seconds
+		float jitter = 0.0f;    // Extra random delay, up to this many seconds, which also reorders packets
+		float lossRate = 0.0f;  // Share of packets dropped, 0..1
+	};
+
+	/**
+	 * @brief Latency and loss shim in front of another channel
+	 * 
+	 * Sent packets are dropped or held back according to NetConditions and
+	 * passed on by advance() once their delay has passed; receiving goes
+	 * straight through. Both ends of a link wrap their own channel, so the
+	 * round trip is twice the latency. The shim keeps its own clock and
+	 * random generator, so a loopback test sees the same losses on every run.
+	 * With default conditions every packet goes straight through.
+	 */
+	class LossyChannel : public PacketChannel
+	{
+	private:
+		struct DelayedPacket
+		{
+			double deliveryTime;
+			size_t size;
+			std::array<uint8_t, MAX_DATAGRAM_SIZE> data;
+		};
+
+		PacketChannel& channel;
+		NetConditions conditions;
+		SimRandom random;
+		double time = 0.0;
+		std::vector<DelayedPacket> delayedPackets;
+		uint64_t droppedCount = 0;
+
+	public:
+		LossyChannel(PacketChannel& innerChannel, const NetConditions& netConditions = NetConditions(), uint32_t seed = 1);
+
+		void setConditions(const NetConditions& netConditions) { conditions = netConditions; }
+		const NetConditions& getConditions() const { return conditions; }
+		uint64_t getDroppedCount() const { return droppedCount; }
+		size_t getDelayedCount() const { return delayedPackets.size(); }
+
+		// Move the shim's clock on by seconds and pass on every packet due by then
+		void advance(float seconds);
+
+		// Forget the packets still held back
+		void clear() { delayedPackets.clear(); }
+
+		void send(const void* data, size_t size) override;
+		size_t receive(void* buffer, size_t capacity) override { return channel.receive(buffer, capacity); }
+	};
+
+	/**
+	 * @brief How this game takes part in a versus match, set from the command line
+	 */
+	struct VersusSettings
+	{
+		bool isHost = true;
+		std::string hostAddress = "127.0.0.1"; // Address to join; hosts ignore it
+		unsigned short port = 0;               // Host port; 0 for VERSUS_PORT
+		NetConditions conditions;              // Simulated on outgoing packets, for testing
+	};
+}
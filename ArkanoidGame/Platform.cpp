@@ -3,17 +3,14 @@
 namespace ArkanoidGame
 {
 	Platform::Platform(float x, float y, float w, float h, float s)
-		: GameObject(x, y, w, h), speed(s), isMovingLeft(false), isMovingRight(false)
+		: GameObject(x, y, w, h), speed(s), isMovingLeft(false), isMovingRight(false), hasVisualEffect(false)
 	{
-		shape.setSize(sf::Vector2f(size.x, size.y));
-		shape.setPosition(position);
-		shape.setFillColor(sf::Color::Blue);
-		shape.setOrigin(size.x / 2, size.y / 2);
 	}
 
 	sf::FloatRect Platform::getBounds() const
 	{
-		return shape.getGlobalBounds();
+		// Position is the platform center
+		return sf::FloatRect(position.x - size.x / 2, position.y - size.y / 2, size.x, size.y);
 	}
 
 	void Platform::setMovingLeft(bool moving)
@@ -51,21 +48,11 @@ namespace ArkanoidGame
 		{
 			position.x = SCREEN_WIDTH - size.x / 2;
 		}
-
-		// Update shape position
-		shape.setPosition(position);
-	}
-
-	void Platform::draw(sf::RenderWindow& window) const
-	{
-		window.draw(shape);
 	}
 
 	void Platform::setWidth(float newWidth)
 	{
 		size.x = newWidth;
-		shape.setSize(sf::Vector2f(size.x, size.y));
-		shape.setOrigin(size.x / 2, size.y / 2);
 		
 		// Ensure platform stays within bounds
 		if (position.x - size.x / 2 < 0)
@@ -76,19 +63,26 @@ namespace ArkanoidGame
 		{
 			position.x = SCREEN_WIDTH - size.x / 2;
 		}
-		
-		shape.setPosition(position);
 	}
 
 	void Platform::setVisualEffect(bool hasEffect)
 	{
-		if (hasEffect)
-		{
-			shape.setFillColor(sf::Color::Magenta); // Purple when effect is active
-		}
-		else
-		{
-			shape.setFillColor(sf::Color::Blue); // Normal blue color
-		}
+		hasVisualEffect = hasEffect; // Renderer draws the platform purple while set
+	}
+
+	Platform::State Platform::getState() const
+	{
+		return { position, size, speed, isMovingLeft, isMovingRight, hasVisualEffect, isActive };
+	}
+
+	void Platform::setState(const State& state)
+	{
+		position = state.position;
+		size = state.size;
+		speed = state.speed;
+		isMovingLeft = state.isMovingLeft;
+		isMovingRight = state.isMovingRight;
+		hasVisualEffect = state.hasVisualEffect;
+		isActive = state.isActive;
 	}
 }
@@ -1,5 +1,4 @@
 #pragma once
-#include <SFML/Graphics.hpp>
 #include "GameSettings.h"
 #include "GameObject.h"
 
@@ -15,12 +14,24 @@ namespace ArkanoidGame
 	class Platform : public GameObject
 	{
 	private:
-		sf::RectangleShape shape;    // Visual representation of the platform
 		float speed;                 // Movement speed in pixels per second
 		bool isMovingLeft;           // Flag for left movement
 		bool isMovingRight;          // Flag for right movement
+		bool hasVisualEffect;        // Whether a bonus highlight should be drawn
 
 	public:
+		// Everything that changes during play, as plain data for snapshots
+		struct State
+		{
+			sf::Vector2f position;
+			sf::Vector2f size;
+			float speed;
+			bool isMovingLeft;
+			bool isMovingRight;
+			bool hasVisualEffect;
+			bool isActive;
+		};
+
 		Platform(float x, float y, float w, float h, float s);
 		~Platform() = default;
 
@@ -33,12 +44,13 @@ namespace ArkanoidGame
 		void setMovingLeft(bool moving);
 		void setMovingRight(bool moving);
 		void update(float timeDelta) override;
-
-		// Rendering
-		void draw(sf::RenderWindow& window) const override;
 		
 		// Bonus support
 		void setWidth(float newWidth);
 		void setVisualEffect(bool hasEffect);
+		bool getHasVisualEffect() const { return hasVisualEffect; }
+
+		State getState() const;
+		void setState(const State& state);
 	};
 }
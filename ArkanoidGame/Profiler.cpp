@@ -0,0 +1,126 @@
+#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		thread_local uint32_t zoneDepth = 0;
+		thread_local uint32_t threadId = UINT32_MAX;
+	}
+
+	Profiler& Profiler::Instance()
+	{
+		static Profiler instance;
+		return instance;
+	}
+
+	Profiler::Profiler()
+		: slots(new Slot[EVENT_CAPACITY]), startTime(std::chrono::steady_clock::now())
+	{
+	}
+
+	uint64_t Profiler::Now() const
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+	}
+
+	uint32_t Profiler::GetCurrentThreadId()
+	{
+		if (threadId == UINT32_MAX)
+		{
+			threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+		}
+		return threadId;
+	}
+
+	void Profiler::BeginFrame()
+	{
+		const uint64_t now = Now();
+		if (frameStartNs != 0)
+		{
+			frameTimes[frameCount % FRAME_HISTORY] = static_cast<float>(now - frameStartNs) * 1e-9f;
+			++frameCount;
+		}
+		previousFrameStartNs = frameStartNs;
+		frameStartNs = now;
+	}
+
+	float Profiler::GetFrameTime(size_t ageInFrames) const
+	{
+		if (ageInFrames >= GetFrameTimeCount())
+		{
+			return 0.0f;
+		}
+		return frameTimes[(frameCount - 1 - ageInFrames) % FRAME_HISTORY];
+	}
+
+	void Profiler::RecordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth)
+	{
+		const uint64_t index = writeCursor.fetch_add(1, std::memory_order_relaxed);
+		Slot& slot = slots[index & (EVENT_CAPACITY - 1)];
+
+		// Odd sequence marks the slot as being written (seqlock)
+		slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.event.name = name;
+		slot.event.startNs = startNs;
+		slot.event.endNs = endNs;
+		slot.event.threadId = GetCurrentThreadId();
+		slot.event.depth = depth;
+
+		slot.sequence.store(index * 2 + 2, std::memory_order_release);
+	}
+
+	bool Profiler::readEvent(uint64_t index, ProfileEvent& event) const
+	{
+		const Slot& slot = slots[index & (EVENT_CAPACITY - 1)];
+		const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+		if (before != index * 2 + 2)
+		{
+			return false;
+		}
+
+		event = slot.event;
+
+		// A writer lapping the ring may have replaced the event while it was copied
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot.sequence.load(std::memory_order_relaxed) == before;
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& path) const
+	{
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		// Complete ("X") events with microsecond timestamps
+		file << std::fixed << std::setprecision(3);
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool isFirst = true;
+		ForEachEventSince(0, [&](const ProfileEvent& event) {
+			file << (isFirst ? "\n" : ",\n");
+			file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+				<< ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+				<< ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0 << "}";
+			isFirst = false;
+		});
+		file << "\n]}\n";
+		return file.good();
+	}
+
+	ProfileZone::ProfileZone(const char* zoneName)
+		: name(zoneName), startNs(Profiler::Instance().Now()), depth(zoneDepth++)
+	{
+	}
+
+	ProfileZone::~ProfileZone()
+	{
+		--zoneDepth;
+		Profiler::Instance().RecordZone(name, startNs, Profiler::Instance().Now(), depth);
+	}
+}
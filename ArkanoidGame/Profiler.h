@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief One finished timing zone
+	 */
+	struct ProfileEvent
+	{
+		const char* name = nullptr; // String literal from PROFILE_ZONE
+		uint64_t startNs = 0;       // Since profiler start
+		uint64_t endNs = 0;
+		uint32_t threadId = 0;
+		uint32_t depth = 0;         // Nesting level on its thread
+	};
+
+	/**
+	 * @brief Collects timing zones and frame times for the whole process
+	 * 
+	 * Zones from any thread go into a fixed-size lock-free ring buffer: writers
+	 * claim a slot with one atomic increment and publish it with a sequence
+	 * number, so readers can walk new events while the game keeps running.
+	 * Old events are overwritten once the ring is full.
+	 */
+	class Profiler
+	{
+	public:
+		static constexpr size_t EVENT_CAPACITY = 1 << 16;   // Power of two
+		static constexpr size_t FRAME_HISTORY = 240;        // Frame times kept for the overlay
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> sequence{ 0 }; // 2 * index + 2 once event index is complete
+			ProfileEvent event;
+		};
+
+		std::unique_ptr<Slot[]> slots;
+		std::atomic<uint64_t> writeCursor{ 0 };
+		std::atomic<uint32_t> nextThreadId{ 0 };
+		std::chrono::steady_clock::time_point startTime;
+
+		// Frame timing, written by the main thread only
+		float frameTimes[FRAME_HISTORY] = {};
+		uint64_t frameCount = 0;
+		uint64_t frameStartNs = 0;
+		uint64_t previousFrameStartNs = 0;
+
+	public:
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+
+		static Profiler& Instance();
+
+		uint64_t Now() const;
+
+		// Called once per displayed frame; closes the previous frame
+		void BeginFrame();
+
+		void RecordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+
+		/**
+		 * @brief Calls visit(const ProfileEvent&) for events recorded since cursor, oldest first
+		 * @param cursor Position returned by the previous call, or 0 to start with the oldest kept event
+		 * @return Cursor for the next call
+		 */
+		template<typename Visit>
+		uint64_t ForEachEventSince(uint64_t cursor, Visit visit) const;
+
+		// Write every kept event as Chrome trace JSON (chrome://tracing, Perfetto)
+		bool ExportChromeTrace(const std::string& path) const;
+
+		// Frame time of the frame that ended ageInFrames frames ago (0 = last complete frame), in seconds
+		float GetFrameTime(size_t ageInFrames) const;
+		size_t GetFrameTimeCount() const { return frameCount < FRAME_HISTORY ? static_cast<size_t>(frameCount) : FRAME_HISTORY; }
+
+		// Bounds of the last complete frame, for grouping zones by frame
+		uint64_t GetLastFrameStart() const { return previousFrameStartNs; }
+		uint64_t GetLastFrameEnd() const { return frameStartNs; }
+
+		uint32_t GetCurrentThreadId();
+
+	private:
+		Profiler();
+		~Profiler() = default;
+
+		bool readEvent(uint64_t index, ProfileEvent& event) const;
+	};
+
+	/**
+	 * @brief Times the enclosing scope and records it on destruction
+	 */
+	class ProfileZone
+	{
+	private:
+		const char* name;
+		uint64_t startNs;
+		uint32_t depth;
+
+	public:
+		explicit ProfileZone(const char* zoneName);
+		~ProfileZone();
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+	};
+
+	template<typename Visit>
+	uint64_t Profiler::ForEachEventSince(uint64_t cursor, Visit visit) const
+	{
+		const uint64_t end = writeCursor.load(std::memory_order_acquire);
+
+		// Events older than one ring length have been overwritten
+		if (end > EVENT_CAPACITY && cursor < end - EVENT_CAPACITY)
+		{
+			cursor = end - EVENT_CAPACITY;
+		}
+
+		for (; cursor < end; ++cursor)
+		{
+			ProfileEvent event;
+			if (!readEvent(cursor, event))
+			{
+				if (cursor + EVENT_CAPACITY <= writeCursor.load(std::memory_order_acquire))
+				{
+					continue; // Overwritten while reading
+				}
+				break; // Still being written; pick it up next time
+			}
+			visit(event);
+		}
+		return cursor;
+	}
+}
+
+// Scoped timing zone; name must be a string literal. Define ARKANOID_DISABLE_PROFILER to compile zones out.
+#ifdef ARKANOID_DISABLE_PROFILER
+#define PROFILE_ZONE(name) ((void)0)
+#else
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ::ArkanoidGame::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name)
+#endif
@@ -0,0 +1,157 @@
+#include "ProfilerOverlay.h"
+#include "GameSettings.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const float PANEL_WIDTH = 320.0f;
+		const float PANEL_LEFT = SCREEN_WIDTH - PANEL_WIDTH - 10.0f;
+		const float PANEL_TOP = 10.0f;
+		const float GRAPH_HEIGHT = 80.0f;
+		const float GRAPH_SCALE_MS = 33.3f;   // Frame time at full graph height
+		const float BUDGET_MS = TIME_PER_FRAME * 1000.0f;
+		const float HISTOGRAM_HEIGHT = 50.0f;
+		const float SMOOTHING = 0.1f;
+
+		void SetQuad(sf::VertexArray& quads, size_t index, float left, float top, float width, float height, const sf::Color& color)
+		{
+			sf::Vertex* quad = &quads[index * 4];
+			quad[0].position = sf::Vector2f(left, top);
+			quad[1].position = sf::Vector2f(left + width, top);
+			quad[2].position = sf::Vector2f(left + width, top + height);
+			quad[3].position = sf::Vector2f(left, top + height);
+			for (int i = 0; i < 4; ++i)
+			{
+				quad[i].color = color;
+			}
+		}
+	}
+
+	ProfilerOverlay::ProfilerOverlay(ResourceCache& resourceCache)
+		: resources(resourceCache),
+		  font(resourceCache.GetFont(FONT_REGULAR_FILE)),
+		  frameGraph(sf::Quads, Profiler::FRAME_HISTORY * 4),
+		  histogram(sf::Quads, HISTOGRAM_BUCKETS * 4),
+		  budgetLine(sf::Lines, 2)
+	{
+		panel.setPosition(PANEL_LEFT, PANEL_TOP);
+		panel.setSize(sf::Vector2f(PANEL_WIDTH, SCREEN_HEIGHT - 2 * PANEL_TOP));
+		panel.setFillColor(sf::Color(0, 0, 0, 180));
+
+		statsText.setFont(*font);
+		statsText.setCharacterSize(UI_FONT_SIZE_TINY);
+		statsText.setFillColor(sf::Color::White);
+		statsText.setPosition(PANEL_LEFT + 8.0f, PANEL_TOP + GRAPH_HEIGHT + HISTOGRAM_HEIGHT + 24.0f);
+
+		const float budgetY = PANEL_TOP + 4.0f + GRAPH_HEIGHT * (1.0f - BUDGET_MS / GRAPH_SCALE_MS);
+		budgetLine[0] = sf::Vertex(sf::Vector2f(PANEL_LEFT, budgetY), sf::Color::Red);
+		budgetLine[1] = sf::Vertex(sf::Vector2f(PANEL_LEFT + PANEL_WIDTH, budgetY), sf::Color::Red);
+	}
+
+	ProfilerOverlay::ZoneStats& ProfilerOverlay::findZone(const char* name, uint32_t depth)
+	{
+		for (int i = 0; i < zoneCount; ++i)
+		{
+			if (zones[i].name == name)
+			{
+				return zones[i];
+			}
+		}
+		if (zoneCount < MAX_ZONES)
+		{
+			zones[zoneCount].name = name;
+			zones[zoneCount].depth = depth;
+			return zones[zoneCount++];
+		}
+		return zones[MAX_ZONES - 1]; // Table full; lump the rest into the last entry
+	}
+
+	void ProfilerOverlay::update()
+	{
+		eventCursor = Profiler::Instance().ForEachEventSince(eventCursor, [this](const ProfileEvent& event) {
+			findZone(event.name, event.depth).pendingMs += static_cast<float>(event.endNs - event.startNs) * 1e-6f;
+		});
+
+		for (int i = 0; i < zoneCount; ++i)
+		{
+			zones[i].averageMs += (zones[i].pendingMs - zones[i].averageMs) * SMOOTHING;
+			zones[i].pendingMs = 0.0f;
+		}
+
+		updateGraphs();
+		updateText();
+	}
+
+	void ProfilerOverlay::updateGraphs()
+	{
+		const Profiler& profiler = Profiler::Instance();
+		const size_t frameCount = profiler.GetFrameTimeCount();
+		const float barWidth = (PANEL_WIDTH - 16.0f) / Profiler::FRAME_HISTORY;
+		const float graphBottom = PANEL_TOP + 4.0f + GRAPH_HEIGHT;
+
+		int buckets[HISTOGRAM_BUCKETS] = {};
+		for (size_t age = 0; age < Profiler::FRAME_HISTORY; ++age)
+		{
+			const float frameMs = age < frameCount ? profiler.GetFrameTime(age) * 1000.0f : 0.0f;
+			const float height = std::min(frameMs / GRAPH_SCALE_MS, 1.0f) * GRAPH_HEIGHT;
+			const sf::Color color = frameMs > BUDGET_MS * 1.05f ? sf::Color(255, 120, 0) : sf::Color::Green;
+
+			// Newest frame on the right
+			const float left = PANEL_LEFT + 8.0f + (Profiler::FRAME_HISTORY - 1 - age) * barWidth;
+			SetQuad(frameGraph, age, left, graphBottom - height, barWidth, height, color);
+
+			if (age < frameCount)
+			{
+				buckets[std::min(static_cast<int>(frameMs / 2.0f), HISTOGRAM_BUCKETS - 1)]++;
+			}
+		}
+
+		const int largestBucket = std::max(1, *std::max_element(buckets, buckets + HISTOGRAM_BUCKETS));
+		const float bucketWidth = (PANEL_WIDTH - 16.0f) / HISTOGRAM_BUCKETS;
+		const float histogramBottom = graphBottom + 12.0f + HISTOGRAM_HEIGHT;
+		for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+		{
+			const float height = HISTOGRAM_HEIGHT * buckets[bucket] / largestBucket;
+			const sf::Color color = (bucket + 1) * 2.0f > BUDGET_MS ? sf::Color(255, 120, 0) : sf::Color::Cyan;
+			SetQuad(histogram, bucket, PANEL_LEFT + 8.0f + bucket * bucketWidth, histogramBottom - height, bucketWidth - 1.0f, height, color);
+		}
+	}
+
+	void ProfilerOverlay::updateText()
+	{
+		const Profiler& profiler = Profiler::Instance();
+		const float lastFrameMs = profiler.GetFrameTime(0) * 1000.0f;
+
+		float worstMs = 0.0f;
+		for (size_t age = 0; age < profiler.GetFrameTimeCount(); ++age)
+		{
+			worstMs = std::max(worstMs, profiler.GetFrameTime(age) * 1000.0f);
+		}
+
+		char line[128];
+		std::snprintf(line, sizeof(line), "Frame %.2f ms  worst %.2f ms  (F3 hide, F4 trace)\n", lastFrameMs, worstMs);
+		std::string text = line;
+		std::snprintf(line, sizeof(line), "Resources: %u loads, %.1f ms\n", resources.GetTotalLoadCount(), resources.GetTotalLoadSeconds() * 1000.0);
+		text += line;
+		for (int i = 0; i < zoneCount; ++i)
+		{
+			std::snprintf(line, sizeof(line), "%*s%-30s %6.3f ms\n", static_cast<int>(zones[i].depth) * 2, "", zones[i].name, zones[i].averageMs);
+			text += line;
+		}
+		statsText.setString(text);
+	}
+
+	void ProfilerOverlay::draw(sf::RenderWindow& window)
+	{
+		window.draw(panel);
+		window.draw(frameGraph);
+		window.draw(budgetLine);
+		window.draw(histogram);
+		window.draw(statsText);
+	}
+}
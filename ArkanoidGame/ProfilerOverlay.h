@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "ResourceCache.h"
+#include <cstdint>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief In-game view of the Profiler
+	 * 
+	 * Shows a graph of recent frame times against the 60 fps budget, a
+	 * histogram of those frame times, and the smoothed time per frame spent
+	 * in each profiling zone, plus the time spent loading resources.
+	 */
+	class ProfilerOverlay
+	{
+	private:
+		static const int MAX_ZONES = 32;
+		static const int HISTOGRAM_BUCKETS = 20; // 2 ms each, the last one collects everything slower
+
+		struct ZoneStats
+		{
+			const char* name = nullptr;
+			uint32_t depth = 0;
+			float pendingMs = 0.0f;  // Time collected since the last update
+			float averageMs = 0.0f;  // Smoothed time per frame
+		};
+
+		ResourceCache& resources;
+		FontHandle font;
+		sf::Text statsText;
+		sf::RectangleShape panel;
+		sf::VertexArray frameGraph;
+		sf::VertexArray histogram;
+		sf::VertexArray budgetLine;
+
+		ZoneStats zones[MAX_ZONES];
+		int zoneCount = 0;
+		uint64_t eventCursor = 0;
+
+	public:
+		explicit ProfilerOverlay(ResourceCache& resourceCache);
+
+		// Pull new profiler events and rebuild the graphs; call once per frame while visible
+		void update();
+		void draw(sf::RenderWindow& window);
+
+	private:
+		ZoneStats& findZone(const char* name, uint32_t depth);
+		void updateGraphs();
+		void updateText();
+	};
+}
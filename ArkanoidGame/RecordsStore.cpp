@@ -0,0 +1,222 @@
+#include "RecordsStore.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const char RECORDS_MAGIC[4] = { 'A', 'R', 'K', 'S' };
+		const uint8_t RECORDS_VERSION = 1;
+		const size_t HEADER_SIZE = sizeof(RECORDS_MAGIC) + 1;
+		const size_t ENTRY_OVERHEAD = 1 + 4 + 4; // Name length, score, checksum
+
+		// Fixed little-endian layout, so records files move between machines
+		void PutUInt32(char* bytes, uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+			}
+		}
+
+		uint32_t GetUInt32(const char* bytes)
+		{
+			uint32_t value = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				value |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+			}
+			return value;
+		}
+
+		// Checksum of an entry: everything before its checksum field
+		uint32_t ComputeEntryChecksum(const char* entry, size_t size)
+		{
+			StateHasher hasher;
+			hasher.addBytes(entry, size);
+			return static_cast<uint32_t>(hasher.getValue());
+		}
+
+		// Append one encoded entry to buffer; the name is cut to MAX_NAME_LENGTH bytes
+		void EncodeEntry(std::vector<char>& buffer, const std::string& playerName, int score)
+		{
+			const size_t nameLength = std::min(playerName.size(), RecordsStore::MAX_NAME_LENGTH);
+			const size_t start = buffer.size();
+			buffer.resize(start + nameLength + ENTRY_OVERHEAD);
+
+			char* entry = buffer.data() + start;
+			entry[0] = static_cast<char>(nameLength);
+			std::memcpy(entry + 1, playerName.data(), nameLength);
+			PutUInt32(entry + 1 + nameLength, static_cast<uint32_t>(score));
+			PutUInt32(entry + 5 + nameLength, ComputeEntryChecksum(entry, 5 + nameLength));
+		}
+
+		std::FILE* OpenFile(const std::string& path, const char* mode)
+		{
+#ifdef _MSC_VER
+			std::FILE* file = nullptr;
+			return fopen_s(&file, path.c_str(), mode) == 0 ? file : nullptr;
+#else
+			return std::fopen(path.c_str(), mode);
+#endif
+		}
+
+		// Push written data through the OS cache, so a power loss cannot undo it
+		bool FlushToDisk(std::FILE* file)
+		{
+			if (std::fflush(file) != 0)
+				return false;
+#ifdef _WIN32
+			return _commit(_fileno(file)) == 0;
+#else
+			return fsync(fileno(file)) == 0;
+#endif
+		}
+
+		bool WriteAndClose(std::FILE* file, const std::vector<char>& buffer)
+		{
+			const bool isWritten = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() && FlushToDisk(file);
+			return std::fclose(file) == 0 && isWritten;
+		}
+	}
+
+	bool RecordsStore::load(Leaderboard& board)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		// The whole log in one read; entries are then decoded straight from memory
+		const std::streamoff fileSize = file.tellg();
+		if (fileSize < static_cast<std::streamoff>(HEADER_SIZE))
+		{
+			return false;
+		}
+		std::vector<char> bytes(static_cast<size_t>(fileSize));
+		file.seekg(0);
+		if (!file.read(bytes.data(), fileSize))
+		{
+			return false;
+		}
+
+		if (std::memcmp(bytes.data(), RECORDS_MAGIC, sizeof(RECORDS_MAGIC)) != 0 || static_cast<uint8_t>(bytes[sizeof(RECORDS_MAGIC)]) != RECORDS_VERSION)
+		{
+			return false;
+		}
+
+		logEntryCount = 0;
+		hasDamagedTail = false;
+		std::string playerName;
+		size_t offset = HEADER_SIZE;
+		while (offset < bytes.size())
+		{
+			// A torn or corrupt entry ends the log; nothing after it can be trusted
+			const char* entry = bytes.data() + offset;
+			const size_t nameLength = static_cast<unsigned char>(entry[0]);
+			const size_t entrySize = nameLength + ENTRY_OVERHEAD;
+			if (bytes.size() - offset < entrySize || GetUInt32(entry + 5 + nameLength) != ComputeEntryChecksum(entry, 5 + nameLength))
+			{
+				hasDamagedTail = true;
+				break;
+			}
+
+			playerName.assign(entry + 1, nameLength);
+			board.set(playerName, static_cast<int>(GetUInt32(entry + 1 + nameLength)));
+			++logEntryCount;
+			offset += entrySize;
+		}
+		return true;
+	}
+
+	bool RecordsStore::append(const std::string& playerName, int score)
+	{
+		// Appending after a torn entry would hide the new one from every later load
+		if (hasDamagedTail)
+		{
+			return false;
+		}
+
+		std::FILE* file = OpenFile(path, "ab");
+		if (!file)
+		{
+			return false;
+		}
+
+		// Entry and, for a new file, header go out in one write
+		std::vector<char> buffer;
+		buffer.reserve(HEADER_SIZE + MAX_NAME_LENGTH + ENTRY_OVERHEAD);
+		std::fseek(file, 0, SEEK_END);
+		if (std::ftell(file) == 0)
+		{
+			buffer.insert(buffer.end(), RECORDS_MAGIC, RECORDS_MAGIC + sizeof(RECORDS_MAGIC));
+			buffer.push_back(static_cast<char>(RECORDS_VERSION));
+		}
+		EncodeEntry(buffer, playerName, score);
+
+		if (!WriteAndClose(file, buffer))
+		{
+			return false;
+		}
+		++logEntryCount;
+		return true;
+	}
+
+	bool RecordsStore::compact(const Leaderboard& board)
+	{
+		// Best first, so a reload sets the scores in the same order and equal scores keep their ranks
+		const std::vector<LeaderboardEntry>& ranking = board.getRanking();
+		std::vector<char> buffer;
+		buffer.reserve(HEADER_SIZE + ranking.size() * (ENTRY_OVERHEAD + 16));
+		buffer.insert(buffer.end(), RECORDS_MAGIC, RECORDS_MAGIC + sizeof(RECORDS_MAGIC));
+		buffer.push_back(static_cast<char>(RECORDS_VERSION));
+		for (const LeaderboardEntry& entry : ranking)
+		{
+			EncodeEntry(buffer, entry.name, entry.score);
+		}
+
+		// Write the new log next to the old one, then swap them in a single rename
+		const std::string temporaryPath = path + ".tmp";
+		std::FILE* file = OpenFile(temporaryPath, "wb");
+		if (!file)
+		{
+			return false;
+		}
+
+		std::error_code error;
+		if (!WriteAndClose(file, buffer))
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		logEntryCount = ranking.size();
+		hasDamagedTail = false;
+		return true;
+	}
+
+	bool RecordsStore::shouldCompact(size_t liveRecordCount) const
+	{
+		return hasDamagedTail || (logEntryCount >= COMPACTION_MIN_ENTRIES && logEntryCount > liveRecordCount * COMPACTION_RATIO);
+	}
+}
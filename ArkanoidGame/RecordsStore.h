@@ -0,0 +1,59 @@
+#pragma once
+#include "Leaderboard.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Binary, append-only records file
+	 *
+	 * The file is a short header followed by one entry per saved score:
+	 * name length, name bytes, score and a checksum of the entry. A new score
+	 * is appended as a single entry, so saving never rewrites the file; a crash
+	 * while appending leaves at most one torn entry at the end, which the next
+	 * load detects by its checksum and drops.
+	 *
+	 * Loading reads the file with one read and replays the entries in order
+	 * into a Leaderboard, exactly as they were added during play. Once the log
+	 * holds many more entries than the board, compact() rewrites it as one
+	 * entry per record into a temporary file and renames that over the log, so
+	 * a crash leaves either the old or the new file, never a mix.
+	 */
+	class RecordsStore
+	{
+	public:
+		static const size_t MAX_NAME_LENGTH = 255;
+		static const size_t COMPACTION_MIN_ENTRIES = 1024; // Smaller logs are never worth compacting
+		static const size_t COMPACTION_RATIO = 4;          // Compact when the log has this many entries per record
+
+	private:
+		std::string path;
+		size_t logEntryCount = 0;   // Valid entries in the file, as of the last load, append or compaction
+		bool hasDamagedTail = false; // The last load dropped a torn or corrupt entry; compact before appending
+
+	public:
+		explicit RecordsStore(const std::string& filePath) : path(filePath) {}
+
+		/**
+		 * @brief Replays the log into board
+		 * @return false if the file is missing or not a records file; board is left untouched then
+		 */
+		bool load(Leaderboard& board);
+
+		// Append one score and flush it to disk
+		bool append(const std::string& playerName, int score);
+
+		// Replace the log with one entry per record on the board, atomically
+		bool compact(const Leaderboard& board);
+
+		// Whether the log has grown enough beyond a board of liveRecordCount to be worth compacting
+		bool shouldCompact(size_t liveRecordCount) const;
+
+		// Getters
+		const std::string& getPath() const { return path; }
+		size_t getLogEntryCount() const { return logEntryCount; }
+		bool getHasDamagedTail() const { return hasDamagedTail; }
+	};
+}
@@ -0,0 +1,42 @@
+#include "ResourceCache.h"
+#include "GameSettings.h"
+#include "Profiler.h"
+#include <chrono>
+
+namespace ArkanoidGame
+{
+	template<typename T>
+	void ResourceStore<T>::load(Entry& entry)
+	{
+		PROFILE_ZONE("ResourceCache::load");
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// A failed load keeps the empty resource, like the states did before
+		entry.resource = std::make_unique<T>();
+		entry.isLoaded = entry.resource->loadFromFile(entry.path);
+
+		loadSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		++loadCount;
+	}
+
+	template class ResourceStore<sf::Font>;
+	template class ResourceStore<sf::Texture>;
+	template class ResourceStore<sf::SoundBuffer>;
+
+	void ResourceCache::PreloadAll()
+	{
+		fonts.preload(FONT_REGULAR_FILE);
+		soundBuffers.preload(SOUND_BALL_HIT_FILE);
+		soundBuffers.preload(SOUND_GAME_OVER_FILE);
+	}
+
+	double ResourceCache::GetTotalLoadSeconds() const
+	{
+		return fonts.getLoadSeconds() + textures.getLoadSeconds() + soundBuffers.getLoadSeconds();
+	}
+
+	uint32_t ResourceCache::GetTotalLoadCount() const
+	{
+		return fonts.getLoadCount() + textures.getLoadCount() + soundBuffers.getLoadCount();
+	}
+}
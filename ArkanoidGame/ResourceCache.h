@@ -0,0 +1,151 @@
+#pragma once
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	template<typename T>
+	class ResourceStore;
+
+	/**
+	 * @brief Shared reference to a cached resource
+	 * 
+	 * Copying a handle adds a reference, destroying it drops one. The resource
+	 * stays loaded while any handle or a preload pin refers to it.
+	 */
+	template<typename T>
+	class ResourceHandle
+	{
+	private:
+		typename ResourceStore<T>::Entry* entry = nullptr;
+
+	public:
+		ResourceHandle() = default;
+		explicit ResourceHandle(typename ResourceStore<T>::Entry* storeEntry) : entry(storeEntry) { acquire(); }
+		ResourceHandle(const ResourceHandle& other) : entry(other.entry) { acquire(); }
+		ResourceHandle(ResourceHandle&& other) noexcept : entry(other.entry) { other.entry = nullptr; }
+		~ResourceHandle() { release(); }
+
+		ResourceHandle& operator=(ResourceHandle other) noexcept
+		{
+			std::swap(entry, other.entry);
+			return *this;
+		}
+
+		bool isValid() const { return entry != nullptr; }
+		bool isLoaded() const { return entry && entry->isLoaded; }
+		const T& operator*() const { return *entry->resource; }
+		const T* operator->() const { return entry->resource.get(); }
+
+	private:
+		void acquire() { if (entry) ++entry->refCount; }
+		void release()
+		{
+			if (entry && --entry->refCount == 0 && !entry->isPinned)
+			{
+				entry->resource.reset(); // Nobody uses it any more
+				entry->isLoaded = false;
+			}
+			entry = nullptr;
+		}
+	};
+
+	/**
+	 * @brief Resources of one type, keyed by file path
+	 */
+	template<typename T>
+	class ResourceStore
+	{
+	public:
+		struct Entry
+		{
+			std::string path;
+			std::unique_ptr<T> resource;
+			uint32_t refCount = 0;
+			bool isPinned = false;  // Preloaded; kept even without handles
+			bool isLoaded = false;  // False if the file could not be read
+		};
+
+	private:
+		std::vector<std::unique_ptr<Entry>> entries; // Entries never move, handles point at them
+		double loadSeconds = 0.0;
+		uint32_t loadCount = 0;
+
+	public:
+		ResourceHandle<T> acquire(const std::string& path)
+		{
+			Entry& entry = findOrAdd(path);
+			if (!entry.resource)
+			{
+				load(entry);
+			}
+			return ResourceHandle<T>(&entry);
+		}
+
+		void preload(const std::string& path)
+		{
+			Entry& entry = findOrAdd(path);
+			entry.isPinned = true;
+			if (!entry.resource)
+			{
+				load(entry);
+			}
+		}
+
+		double getLoadSeconds() const { return loadSeconds; }
+		uint32_t getLoadCount() const { return loadCount; }
+
+	private:
+		Entry& findOrAdd(const std::string& path)
+		{
+			// A game has a handful of files, a linear scan beats hashing here
+			for (const auto& entry : entries)
+			{
+				if (entry->path == path)
+				{
+					return *entry;
+				}
+			}
+			entries.push_back(std::make_unique<Entry>());
+			entries.back()->path = path;
+			return *entries.back();
+		}
+
+		void load(Entry& entry);
+	};
+
+	using FontHandle = ResourceHandle<sf::Font>;
+	using TextureHandle = ResourceHandle<sf::Texture>;
+	using SoundBufferHandle = ResourceHandle<sf::SoundBuffer>;
+
+	/**
+	 * @brief Fonts, textures and sound buffers shared by all game states
+	 * 
+	 * Owned by Game. Each file is read once and handed out as ref-counted
+	 * handles; preloaded files stay resident, so recreating states on every
+	 * transition does no disk I/O. Load times are measured per store.
+	 */
+	class ResourceCache
+	{
+	private:
+		ResourceStore<sf::Font> fonts;
+		ResourceStore<sf::Texture> textures;
+		ResourceStore<sf::SoundBuffer> soundBuffers;
+
+	public:
+		FontHandle GetFont(const std::string& path) { return fonts.acquire(path); }
+		TextureHandle GetTexture(const std::string& path) { return textures.acquire(path); }
+		SoundBufferHandle GetSoundBuffer(const std::string& path) { return soundBuffers.acquire(path); }
+
+		// Load and pin every file the game uses, so later lookups never touch the disk
+		void PreloadAll();
+
+		double GetTotalLoadSeconds() const;
+		uint32_t GetTotalLoadCount() const;
+	};
+}
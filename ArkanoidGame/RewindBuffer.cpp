@@ -0,0 +1,98 @@
+#include "RewindBuffer.h"
+#include <algorithm>
+
+namespace ArkanoidGame
+{
+	RewindBuffer::RewindBuffer(size_t tickCapacity)
+		: frames(std::max<size_t>(tickCapacity, 1) + 1) // One more frame for the state the oldest tick started from
+	{
+	}
+
+	void RewindBuffer::setCapacity(size_t tickCapacity)
+	{
+		// Frames that stay keep their arrays, so an unchanged capacity costs nothing
+		frames.resize(std::max<size_t>(tickCapacity, 1) + 1);
+		newest = 0;
+		count = 0;
+	}
+
+	void RewindBuffer::reset(const ArkanoidSim& sim)
+	{
+		const BrickField& bricks = sim.getBricks();
+		shadowHits.assign(bricks.getHitsData(), bricks.getHitsData() + bricks.size());
+		shadowAliveBits.assign(bricks.getAliveBitsData(), bricks.getAliveBitsData() + bricks.getAliveWordCount());
+		syncJournal(sim);
+
+		newest = 0;
+		count = 1;
+		frames[newest].undo.clear();
+		sim.saveSnapshot(frames[newest].snapshot, false);
+	}
+
+	void RewindBuffer::record(const ArkanoidSim& sim)
+	{
+		const BrickField& bricks = sim.getBricks();
+		if (count == 0 || bricks.getLayoutVersion() != journalVersion)
+		{
+			// A new level or a restore from outside: earlier ticks cannot be undone from here
+			reset(sim);
+			return;
+		}
+
+		newest = (newest + 1) % frames.size();
+		count = std::min(count + 1, frames.size());
+		Frame& frame = frames[newest];
+
+		// Bricks hit during the tick, with their state from before it; a brick hit twice is kept once
+		frame.undo.clear();
+		const size_t changeCount = bricks.getChangeCount();
+		for (; journalPosition < changeCount; ++journalPosition)
+		{
+			const uint32_t index = bricks.getChangedBrick(journalPosition);
+			const uint64_t aliveMask = uint64_t(1) << (index & 63);
+			const bool wasAlive = (shadowAliveBits[index >> 6] & aliveMask) != 0;
+			const bool isAlive = bricks.isAlive(index);
+			const uint8_t hits = static_cast<uint8_t>(bricks.getHits(index));
+			if (shadowHits[index] == hits && wasAlive == isAlive)
+				continue;
+
+			frame.undo.push_back({ index, shadowHits[index], static_cast<uint8_t>(wasAlive) });
+			shadowHits[index] = hits;
+			shadowAliveBits[index >> 6] = isAlive ? (shadowAliveBits[index >> 6] | aliveMask) : (shadowAliveBits[index >> 6] & ~aliveMask);
+		}
+
+		sim.saveSnapshot(frame.snapshot, false);
+	}
+
+	size_t RewindBuffer::rewind(ArkanoidSim& sim, size_t ticks)
+	{
+		ticks = std::min(ticks, getAvailableTicks());
+		if (ticks == 0)
+			return 0;
+
+		// Undo bricks newest tick first, keeping the shadow in step
+		for (size_t i = 0; i < ticks; ++i)
+		{
+			const std::vector<BrickChange>& undo = frames[newest].undo;
+			sim.restoreBricks(undo.data(), undo.size());
+			for (const BrickChange& change : undo)
+			{
+				const uint64_t aliveMask = uint64_t(1) << (change.index & 63);
+				shadowHits[change.index] = change.hits;
+				shadowAliveBits[change.index >> 6] = change.isAlive ? (shadowAliveBits[change.index >> 6] | aliveMask) : (shadowAliveBits[change.index >> 6] & ~aliveMask);
+			}
+			newest = (newest + frames.size() - 1) % frames.size();
+			--count;
+		}
+
+		sim.restoreSnapshot(frames[newest].snapshot);
+		syncJournal(sim);
+		return ticks;
+	}
+
+	void RewindBuffer::syncJournal(const ArkanoidSim& sim)
+	{
+		journalVersion = sim.getBricks().getLayoutVersion();
+		journalPosition = sim.getBricks().getChangeCount();
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "ArkanoidSim.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief The last ticks of a session, for stepping back in time
+	 *
+	 * Each recorded tick keeps the small parts of the sim whole (a SimSnapshot
+	 * without bricks) and the bricks as a delta: the bricks hit during that
+	 * tick with their state before it, found through the brick field's change
+	 * journal. Recording therefore costs the bonuses, effects and balls plus
+	 * the bricks actually hit, however many bricks the level has. The oldest
+	 * tick is dropped once the buffer is full; frames keep their arrays, so
+	 * after one pass around the ring recording no longer allocates.
+	 */
+	class RewindBuffer
+	{
+	private:
+		struct Frame
+		{
+			SimSnapshot snapshot;             // Saved without bricks
+			std::vector<BrickChange> undo;    // Brick states before this tick
+		};
+
+		std::vector<Frame> frames;            // Ring; frames[newest] is the latest state
+		size_t newest = 0;
+		size_t count = 0;
+
+		// Brick state as of the newest frame, to tell what a tick changed
+		std::vector<uint8_t> shadowHits;
+		std::vector<uint64_t> shadowAliveBits;
+		uint32_t journalVersion = 0;          // Layout version of the brick field's change journal
+		size_t journalPosition = 0;           // Journal entries already folded into the shadow
+
+	public:
+		explicit RewindBuffer(size_t tickCapacity);
+
+		// Keep up to tickCapacity ticks from now on; forgets every tick, so call reset() before recording again
+		void setCapacity(size_t tickCapacity);
+
+		// Forget every tick; sim's current state becomes the earliest one to return to
+		void reset(const ArkanoidSim& sim);
+
+		// Add sim's state after a step; starts over if the bricks were laid out or restored elsewhere
+		void record(const ArkanoidSim& sim);
+
+		// Move sim back by up to ticks recorded ticks and forget them; returns the number of ticks undone
+		size_t rewind(ArkanoidSim& sim, size_t ticks);
+
+		size_t getAvailableTicks() const { return count > 0 ? count - 1 : 0; }
+		size_t getCapacity() const { return frames.size(); }
+
+	private:
+		void syncJournal(const ArkanoidSim& sim);
+	};
+}
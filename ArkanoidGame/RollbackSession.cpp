@@ -0,0 +1,357 @@
+#include "RollbackSession.h"
+#include "InputLog.h"
+#include "Profiler.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		const char PACKET_MAGIC[4] = { 'A', 'R', 'K', 'V' };
+		const uint8_t PROTOCOL_VERSION = 2; // Bumped with the packet layout, the game rules or the state hash
+		const size_t PACKET_HEADER_SIZE = offsetof(NetInputPacket, inputs);
+
+		int CompareScores(const ArkanoidSim& player1, const ArkanoidSim& player2)
+		{
+			return player1.getScore() > player2.getScore() ? 1 : (player1.getScore() < player2.getScore() ? -1 : 0);
+		}
+	}
+
+	uint64_t ComputeVersusHash(uint32_t tick, const ArkanoidSim& player1, const ArkanoidSim& player2)
+	{
+		StateHasher hasher;
+		hasher.add(tick);
+		hasher.add(player1.computeStateHash());
+		hasher.add(player2.computeStateHash());
+		return hasher.getValue();
+	}
+
+	VersusOutcome GetVersusOutcome(const ArkanoidSim& player1, const ArkanoidSim& player2)
+	{
+		const SimStatus first = player1.getStatus();
+		const SimStatus second = player2.getStatus();
+		if (first == SimStatus::Running && second == SimStatus::Running)
+		{
+			return VersusOutcome::Running;
+		}
+
+		// One field ended: clearing it wins, losing the last ball loses
+		if (second == SimStatus::Running)
+		{
+			return first == SimStatus::Won ? VersusOutcome::Player1Won : VersusOutcome::Player2Won;
+		}
+		if (first == SimStatus::Running)
+		{
+			return second == SimStatus::Won ? VersusOutcome::Player2Won : VersusOutcome::Player1Won;
+		}
+
+		// Both on the same tick
+		if (first != second)
+		{
+			return first == SimStatus::Won ? VersusOutcome::Player1Won : VersusOutcome::Player2Won;
+		}
+		const int comparison = CompareScores(player1, player2);
+		return comparison > 0 ? VersusOutcome::Player1Won : (comparison < 0 ? VersusOutcome::Player2Won : VersusOutcome::Draw);
+	}
+
+	RollbackSession::RollbackSession(PacketChannel& packetChannel, const LevelPack* levelPack, uint32_t inputDelayTicks, uint32_t maxRollback)
+		: channel(packetChannel), levels(levelPack), inputDelay(inputDelayTicks), maxRollbackTicks(std::max(maxRollback, 1u)),
+		players{ Player(maxRollbackTicks), Player(maxRollbackTicks) }
+	{
+		// Reserve a few minutes of inputs so a match does not reallocate while it is played
+		const size_t reservedTicks = static_cast<size_t>(PHYSICS_TICKS_PER_SECOND) * 60 * 5;
+		inputs[0].reserve(reservedTicks);
+		inputs[1].reserve(reservedTicks);
+		usedRemoteInputs.reserve(reservedTicks);
+		reset(0, -1);
+	}
+
+	void RollbackSession::host(unsigned int matchSeed, int matchLevelIndex)
+	{
+		localPlayer = 0;
+		remotePlayer = 1;
+		reset(matchSeed, matchLevelIndex);
+	}
+
+	void RollbackSession::join()
+	{
+		localPlayer = 1;
+		remotePlayer = 0;
+		reset(0, -1);
+	}
+
+	void RollbackSession::reset(unsigned int matchSeed, int matchLevelIndex)
+	{
+		seed = matchSeed;
+		levelIndex = matchLevelIndex;
+		const bool hasLevel = levels && levelIndex >= 0 && static_cast<size_t>(levelIndex) < levels->getLevelCount();
+		for (Player& player : players)
+		{
+			if (hasLevel)
+			{
+				player.sim.reset(seed, levels->getLevel(static_cast<size_t>(levelIndex)));
+			}
+			else
+			{
+				player.sim.reset(seed);
+			}
+			player.history.reset(player.sim);
+		}
+
+		// The first inputDelay ticks have no keys pressed on either side, which both peers know without asking
+		for (std::vector<uint8_t>& playerInputs : inputs)
+		{
+			playerInputs.assign(inputDelay, 0);
+		}
+		usedRemoteInputs.clear();
+		tick = 0;
+		remoteAckTick = 0;
+		rollbackTick = NO_TICK;
+		hashes.fill(TickHash());
+		peerHash = TickHash();
+		desyncTick = NO_TICK;
+		isConnected = false;
+		silentTicks = 0;
+		lastRollbackTicks = 0;
+		stats = RollbackStats();
+	}
+
+	bool RollbackSession::advance(const SimInput& localInput)
+	{
+		PROFILE_ZONE("Rollback::advance");
+
+		receivePackets();
+		bool isStepped = false;
+		if (isConnected && getOutcome() == VersusOutcome::Running)
+		{
+			// Waiting when too far ahead keeps every possible correction within the rewind history
+			const uint32_t remoteTicks = static_cast<uint32_t>(inputs[remotePlayer].size());
+			if (tick >= remoteTicks + maxRollbackTicks)
+			{
+				++stats.stalls;
+			}
+			else
+			{
+				inputs[localPlayer].push_back(PackInput(localInput));
+				simulateTick();
+				++stats.ticks;
+				isStepped = true;
+			}
+		}
+		sendPacket();
+		return isStepped;
+	}
+
+	void RollbackSession::poll()
+	{
+		receivePackets();
+		sendPacket();
+	}
+
+	uint32_t RollbackSession::getConfirmedTick() const
+	{
+		return std::min(tick, static_cast<uint32_t>(inputs[remotePlayer].size()));
+	}
+
+	bool RollbackSession::getTickHash(uint32_t hashTick, uint64_t& hash) const
+	{
+		const TickHash& entry = hashes[hashTick % HASH_HISTORY];
+		if (hashTick == NO_TICK || entry.tick != hashTick)
+		{
+			return false;
+		}
+		hash = entry.hash;
+		return true;
+	}
+
+	uint8_t RollbackSession::getInputBits(int player, uint32_t inputTick) const
+	{
+		if (player == remotePlayer && inputTick >= inputs[remotePlayer].size())
+		{
+			return inputTick < usedRemoteInputs.size() ? usedRemoteInputs[inputTick] : 0;
+		}
+		return inputTick < inputs[player].size() ? inputs[player][inputTick] : 0;
+	}
+
+	void RollbackSession::receivePackets()
+	{
+		PROFILE_ZONE("Rollback::receive");
+
+		lastRollbackTicks = 0;
+		++silentTicks;
+		size_t size;
+		while ((size = channel.receive(&packet, sizeof(packet))) > 0)
+		{
+			readPacket(size);
+		}
+
+		if (rollbackTick != NO_TICK)
+		{
+			rollBack();
+		}
+		comparePeerHash();
+	}
+
+	void RollbackSession::readPacket(size_t size)
+	{
+		if (size < PACKET_HEADER_SIZE || std::memcmp(packet.magic, PACKET_MAGIC, sizeof(PACKET_MAGIC)) != 0 ||
+			packet.version != PROTOCOL_VERSION || packet.senderPlayer != remotePlayer ||
+			packet.inputCount > NetInputPacket::MAX_INPUTS || size != PACKET_HEADER_SIZE + packet.inputCount)
+		{
+			return;
+		}
+		if (!isConnected)
+		{
+			// The joining peer plays whatever the host picked
+			if (localPlayer != 0)
+			{
+				reset(packet.seed, packet.levelIndex);
+			}
+			isConnected = true;
+		}
+		++stats.packetsReceived;
+		silentTicks = 0;
+		remoteAckTick = std::max(remoteAckTick, packet.ackTick);
+
+		// Inputs arrive as a range starting at our last acknowledgement, so only the part past what we have is new
+		std::vector<uint8_t>& remoteInputs = inputs[remotePlayer];
+		for (uint32_t i = 0; i < packet.inputCount; ++i)
+		{
+			const uint32_t inputTick = packet.firstTick + i;
+			if (inputTick < remoteInputs.size())
+				continue;
+			if (inputTick > remoteInputs.size())
+				break;
+
+			const uint8_t bits = packet.inputs[i];
+			remoteInputs.push_back(bits);
+			if (inputTick < tick && usedRemoteInputs[inputTick] != bits)
+			{
+				rollbackTick = std::min(rollbackTick, inputTick);
+			}
+		}
+
+		if (packet.hashTick != NO_TICK && (peerHash.tick == NO_TICK || packet.hashTick > peerHash.tick))
+		{
+			peerHash.tick = packet.hashTick;
+			peerHash.hash = packet.hash;
+		}
+	}
+
+	void RollbackSession::rollBack()
+	{
+		PROFILE_ZONE("Rollback::resimulate");
+
+		// Everything from the first wrong tick on is stepped again with what is known now
+		const uint32_t targetTick = tick;
+		const uint32_t depth = targetTick - rollbackTick;
+		for (Player& player : players)
+		{
+			player.history.rewind(player.sim, depth);
+		}
+		tick = rollbackTick;
+		rollbackTick = NO_TICK;
+
+		while (tick < targetTick)
+		{
+			simulateTick();
+		}
+
+		lastRollbackTicks = depth;
+		++stats.rollbacks;
+		stats.resimulatedTicks += depth;
+		stats.maxRollbackTicks = std::max(stats.maxRollbackTicks, depth);
+	}
+
+	void RollbackSession::simulateTick()
+	{
+		// Missing remote keys are predicted to stay as last confirmed
+		const std::vector<uint8_t>& remoteInputs = inputs[remotePlayer];
+		uint8_t remoteBits = 0;
+		if (tick < remoteInputs.size())
+		{
+			remoteBits = remoteInputs[tick];
+		}
+		else if (!remoteInputs.empty())
+		{
+			remoteBits = remoteInputs.back();
+		}
+		if (tick < usedRemoteInputs.size())
+		{
+			usedRemoteInputs[tick] = remoteBits;
+		}
+		else
+		{
+			usedRemoteInputs.push_back(remoteBits);
+		}
+
+		for (int i = 0; i < 2; ++i)
+		{
+			Player& player = players[i];
+			const uint8_t bits = i == localPlayer ? inputs[localPlayer][tick] : remoteBits;
+			player.sim.step(UnpackInput(bits), TIME_STEP);
+			player.history.record(player.sim);
+		}
+
+		TickHash& entry = hashes[tick % HASH_HISTORY];
+		entry.tick = tick;
+		entry.hash = ComputeVersusHash(tick, players[0].sim, players[1].sim);
+		++tick;
+	}
+
+	void RollbackSession::comparePeerHash()
+	{
+		// Only a tick confirmed on both sides has a final state to compare
+		if (peerHash.tick == NO_TICK || peerHash.tick >= getConfirmedTick())
+			return;
+
+		uint64_t localHash;
+		if (getTickHash(peerHash.tick, localHash))
+		{
+			++stats.hashesCompared;
+			if (localHash != peerHash.hash && peerHash.tick < desyncTick)
+			{
+				desyncTick = peerHash.tick;
+			}
+		}
+		peerHash = TickHash();
+	}
+
+	void RollbackSession::sendPacket()
+	{
+		PROFILE_ZONE("Rollback::send");
+
+		std::memcpy(packet.magic, PACKET_MAGIC, sizeof(PACKET_MAGIC));
+		packet.seed = seed;
+		packet.levelIndex = levelIndex;
+		packet.version = PROTOCOL_VERSION;
+		packet.senderPlayer = static_cast<uint8_t>(localPlayer);
+		std::memset(packet.reserved, 0, sizeof(packet.reserved));
+		packet.ackTick = static_cast<uint32_t>(inputs[remotePlayer].size());
+
+		// Everything the peer has not acknowledged, oldest first
+		const std::vector<uint8_t>& localInputs = inputs[localPlayer];
+		const uint32_t firstTick = std::min(remoteAckTick, static_cast<uint32_t>(localInputs.size()));
+		const size_t count = std::min<size_t>(localInputs.size() - firstTick, NetInputPacket::MAX_INPUTS);
+		packet.firstTick = firstTick;
+		packet.inputCount = static_cast<uint8_t>(count);
+		if (count > 0)
+		{
+			std::memcpy(packet.inputs, localInputs.data() + firstTick, count);
+		}
+
+		const uint32_t confirmedTick = getConfirmedTick();
+		packet.hashTick = NO_TICK;
+		packet.hash = 0;
+		if (confirmedTick > 0 && getTickHash(confirmedTick - 1, packet.hash))
+		{
+			packet.hashTick = confirmedTick - 1;
+		}
+
+		channel.send(&packet, PACKET_HEADER_SIZE + count);
+		++stats.packetsSent;
+	}
+}
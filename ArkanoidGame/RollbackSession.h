@@ -0,0 +1,203 @@
+#pragma once
+#include "ArkanoidSim.h"
+#include "GameSettings.h"
+#include "LevelPack.h"
+#include "NetChannel.h"
+#include "RewindBuffer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	enum class VersusOutcome
+	{
+		Running,
+		Player1Won,
+		Player2Won,
+		Draw
+	};
+
+	// State hash of both fields after tick, as the peers compare it
+	uint64_t ComputeVersusHash(uint32_t tick, const ArkanoidSim& player1, const ArkanoidSim& player2);
+
+	// Clearing the field or outlasting the other wins; when both end on the same tick, the higher score does
+	VersusOutcome GetVersusOutcome(const ArkanoidSim& player1, const ArkanoidSim& player2);
+
+	/**
+	 * @brief Datagram exchanged by RollbackSession peers
+	 * 
+	 * Carries every local input the peer has not acknowledged yet, so a lost
+	 * packet is covered by the next one, and the hash of the latest state both
+	 * inputs confirm. Only the header and inputCount inputs are sent.
+	 */
+	struct NetInputPacket
+	{
+		static constexpr uint32_t MAX_INPUTS = 64;
+
+		char magic[4];          // "ARKV"
+		uint32_t seed;          // Match seed, picked by the host
+		int32_t levelIndex;     // Level in the LevelPack, -1 for a layout generated from the seed
+		uint32_t firstTick;     // Tick of inputs[0]
+		uint32_t ackTick;       // The sender has every input of the receiver before this tick
+		uint32_t hashTick;      // Tick of hash, NO_TICK when the sender has no confirmed tick yet
+		uint64_t hash;          // State hash after hashTick
+		uint8_t version;
+		uint8_t senderPlayer;
+		uint8_t inputCount;
+		uint8_t reserved[5];
+		uint8_t inputs[MAX_INPUTS]; // PackInput bits
+	};
+
+	static_assert(sizeof(NetInputPacket) == 40 + NetInputPacket::MAX_INPUTS && sizeof(NetInputPacket) <= MAX_DATAGRAM_SIZE,
+		"Packet layout is part of the protocol");
+
+	/**
+	 * @brief Counters of a RollbackSession
+	 */
+	struct RollbackStats
+	{
+		uint64_t ticks = 0;              // Ticks advanced, not counting resimulation
+		uint64_t rollbacks = 0;          // Mispredictions corrected
+		uint64_t resimulatedTicks = 0;
+		uint32_t maxRollbackTicks = 0;   // Deepest correction
+		uint64_t stalls = 0;             // advance() calls that waited for the peer
+		uint64_t packetsSent = 0;
+		uint64_t packetsReceived = 0;    // Valid packets only
+		uint64_t hashesCompared = 0;
+	};
+
+	/**
+	 * @brief Two-player versus synchronized by rollback over a PacketChannel
+	 * 
+	 * Each player has an identical field of their own: both sims start from the
+	 * host's seed and level, and each is stepped with one player's inputs.
+	 * Both peers run both sims. A peer never waits for the other's inputs:
+	 * it predicts that the remote keys stay as they were last seen and steps on.
+	 * When the real inputs arrive and differ from the prediction, both sims are
+	 * rewound to the first wrong tick with their RewindBuffers and stepped
+	 * forward again, so they stay exactly where the inputs say they should be.
+	 * 
+	 * Local keys are applied ROLLBACK_INPUT_DELAY_TICKS late, which hides that
+	 * much latency without any rollback. A peer more than ROLLBACK_MAX_TICKS
+	 * ahead of the other's inputs waits, so a correction never reaches beyond
+	 * the rewind history.
+	 * 
+	 * After every tick both peers hash their state. Each packet carries the
+	 * hash of the latest tick whose inputs are confirmed on the sending side;
+	 * the receiver compares it with its own for the same tick and reports the
+	 * first tick where they disagree as a desync.
+	 * 
+	 * The host is player 1 (index 0) and picks the match; the joining peer is
+	 * player 2 and learns seed and level from the first packet. Both sides
+	 * must have the same LevelPack.
+	 */
+	class RollbackSession
+	{
+	public:
+		static constexpr uint32_t NO_TICK = UINT32_MAX;
+		static constexpr uint32_t HASH_HISTORY = 256;    // Ticks whose hashes are kept for comparison
+		static constexpr float TIME_STEP = 1.0f / PHYSICS_TICKS_PER_SECOND; // Fixed on both peers, whatever the local physics rate
+
+	private:
+		struct Player
+		{
+			ArkanoidSim sim;
+			RewindBuffer history;      // Rollback reach
+
+			explicit Player(size_t historyTicks) : sim(0), history(historyTicks) {}
+		};
+
+		struct TickHash
+		{
+			uint32_t tick = NO_TICK;
+			uint64_t hash = 0;
+		};
+
+		PacketChannel& channel;
+		const LevelPack* levels;
+		int localPlayer = 0;
+		int remotePlayer = 1;
+		uint32_t inputDelay;
+		uint32_t maxRollbackTicks;
+		Player players[2];
+
+		// PackInput bits per tick: local ones run inputDelay ticks ahead, remote ones are the confirmed ones
+		std::vector<uint8_t> inputs[2];
+		std::vector<uint8_t> usedRemoteInputs;      // Remote input each simulated tick was stepped with, predicted or not
+		uint32_t tick = 0;                          // Ticks simulated
+		uint32_t remoteAckTick = 0;                 // The peer has our inputs before this tick
+		uint32_t rollbackTick = NO_TICK;            // Earliest simulated tick whose remote input was predicted wrong
+
+		std::array<TickHash, HASH_HISTORY> hashes;  // State hash after each recent tick
+		TickHash peerHash;                          // Latest confirmed hash from the peer, not compared yet
+		uint32_t desyncTick = NO_TICK;
+
+		unsigned int seed = 0;
+		int levelIndex = -1;
+		bool isConnected = false;
+		uint32_t silentTicks = 0;                   // advance()/poll() calls since the last valid packet
+		uint32_t lastRollbackTicks = 0;
+		RollbackStats stats;
+		NetInputPacket packet;
+
+	public:
+		/**
+		 * @param levelPack Pack that level indices refer to; may be null when only generated layouts are played
+		 */
+		RollbackSession(PacketChannel& packetChannel, const LevelPack* levelPack,
+			uint32_t inputDelayTicks = ROLLBACK_INPUT_DELAY_TICKS, uint32_t maxRollback = ROLLBACK_MAX_TICKS);
+
+		RollbackSession(const RollbackSession&) = delete;
+		RollbackSession& operator=(const RollbackSession&) = delete;
+
+		// Play the given match as player 1; it starts once the peer has been heard from
+		void host(unsigned int matchSeed, int matchLevelIndex);
+
+		// Play as player 2 whatever match the host picked; it starts with the host's first packet
+		void join();
+
+		// Receive, correct mispredictions and step both fields one tick with localInput; false if it had to wait
+		bool advance(const SimInput& localInput);
+
+		// Receive, correct and send without stepping, e.g. while the result is being confirmed
+		void poll();
+
+		// Getters
+		const ArkanoidSim& getSim(int player) const { return players[player].sim; }
+		int getLocalPlayer() const { return localPlayer; }
+		bool isRunning() const { return isConnected; }
+		bool isPeerLost() const { return silentTicks > static_cast<uint32_t>(NET_TIMEOUT_SECONDS) * PHYSICS_TICKS_PER_SECOND; }
+		uint32_t getTick() const { return tick; }
+		uint32_t getConfirmedTick() const; // Ticks whose inputs are all known
+		unsigned int getSeed() const { return seed; }
+		int getLevelIndex() const { return levelIndex; }
+		const RollbackStats& getStats() const { return stats; }
+		uint32_t getLastRollbackTicks() const { return lastRollbackTicks; } // Ticks resimulated by the last call
+
+		// Result on the current, possibly predicted state
+		VersusOutcome getOutcome() const { return GetVersusOutcome(players[0].sim, players[1].sim); }
+
+		// The match ended on inputs both sides have confirmed, so the outcome can no longer change
+		bool isFinished() const { return getOutcome() != VersusOutcome::Running && getConfirmedTick() == tick; }
+
+		bool isDesynced() const { return desyncTick != NO_TICK; }
+		uint32_t getDesyncTick() const { return desyncTick; }
+
+		// Hash of the state after hashTick; false if that tick is no longer kept
+		bool getTickHash(uint32_t hashTick, uint64_t& hash) const;
+
+		// Input a player stepped with on tick, for checking a session against an offline run
+		uint8_t getInputBits(int player, uint32_t inputTick) const;
+
+	private:
+		void reset(unsigned int matchSeed, int matchLevelIndex);
+		void receivePackets();
+		void readPacket(size_t size);
+		void rollBack();
+		void simulateTick();
+		void comparePeerHash();
+		void sendPacket();
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Things that happened during one simulation step
+	 */
+	enum class SimEventType : uint8_t
+	{
+		BrickHit,       // index: brick
+		BrickDestroyed, // index: brick, value: points awarded
+		BonusDropped,   // index: BonusEffectType of a bonus that started falling from a destroyed brick
+		BonusCollected, // index: BonusEffectType, value: effect magnitude (points, balls per ball)
+		EffectEnded,    // index: BonusEffectType of a timed or recently shown effect that is no longer active
+		ScoreChanged,   // value: new score
+		LifeLost,       // value: lives left
+		LifeGained,     // value: lives now
+		BallsSplit,     // value: balls in play afterwards
+		GameWon,
+		GameLost
+	};
+
+	struct SimEvent
+	{
+		SimEventType type;
+		int32_t index;
+		int32_t value;
+	};
+
+	/**
+	 * @brief Events of the current step, in the order they happened
+	 *
+	 * ArkanoidSim clears the queue at the start of every step and appends while
+	 * it runs. Subscribers (audio, HUD, stats) read it once after the step, so
+	 * side effects are batched per tick and a headless run simply has no
+	 * subscribers. Storage is reserved up front; only a step with more than
+	 * SIM_EVENT_QUEUE_CAPACITY events grows it, since the simulation applies
+	 * bonus events itself and must never lose one.
+	 */
+	class SimEventQueue
+	{
+	public:
+		static const size_t SIM_EVENT_QUEUE_CAPACITY = 1024;
+
+	private:
+		std::vector<SimEvent> events;
+
+	public:
+		SimEventQueue() { events.reserve(SIM_EVENT_QUEUE_CAPACITY); }
+
+		void push(SimEventType type, int32_t index = 0, int32_t value = 0) { events.push_back({ type, index, value }); }
+		void clear() { events.clear(); }
+
+		size_t size() const { return events.size(); }
+		bool empty() const { return events.empty(); }
+		const SimEvent& operator[](size_t position) const { return events[position]; }
+		std::vector<SimEvent>::const_iterator begin() const { return events.begin(); }
+		std::vector<SimEvent>::const_iterator end() const { return events.end(); }
+	};
+}
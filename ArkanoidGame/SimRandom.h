@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Small seeded random generator for one game session (xoshiro128**)
+	 * 
+	 * Every random decision of a session draws from one SimRandom, so a seed plus
+	 * the player's inputs reproduce the session exactly. Range mapping is done
+	 * here rather than with <random> distributions, whose output differs between
+	 * standard library implementations.
+	 */
+	class SimRandom
+	{
+	private:
+		uint32_t state[4];
+
+	public:
+		explicit SimRandom(uint32_t seed = 0) { setSeed(seed); }
+
+		void setSeed(uint32_t seed)
+		{
+			// SplitMix64 spreads the seed over the whole state, which must not be all zero
+			uint64_t mix = seed;
+			for (int i = 0; i < 4; i += 2)
+			{
+				mix += 0x9E3779B97F4A7C15ull;
+				uint64_t z = mix;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				z ^= z >> 31;
+				state[i] = static_cast<uint32_t>(z);
+				state[i + 1] = static_cast<uint32_t>(z >> 32);
+			}
+		}
+
+		uint32_t next()
+		{
+			const uint32_t result = rotateLeft(state[1] * 5, 7) * 9;
+			const uint32_t shifted = state[1] << 9;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= shifted;
+			state[3] = rotateLeft(state[3], 11);
+
+			return result;
+		}
+
+		// Uniform in [0, 1), 24 bits of precision
+		float nextFloat()
+		{
+			return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+		}
+
+		// Uniform in [min, max)
+		float uniformFloat(float min, float max)
+		{
+			return min + (max - min) * nextFloat();
+		}
+
+		// Uniform in [min, max], without modulo bias
+		int uniformInt(int min, int max)
+		{
+			const uint32_t range = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1u;
+			if (range == 0)
+			{
+				return static_cast<int>(next()); // Full 32-bit range
+			}
+
+			// Lemire's multiply-shift, rejecting the few values that would skew the result
+			uint64_t product = static_cast<uint64_t>(next()) * range;
+			uint32_t low = static_cast<uint32_t>(product);
+			if (low < range)
+			{
+				const uint32_t threshold = (0u - range) % range;
+				while (low < threshold)
+				{
+					product = static_cast<uint64_t>(next()) * range;
+					low = static_cast<uint32_t>(product);
+				}
+			}
+			return static_cast<int>(static_cast<uint32_t>(min) + static_cast<uint32_t>(product >> 32));
+		}
+
+		const uint32_t* getState() const { return state; }
+		void setState(const uint32_t* newState)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				state[i] = newState[i];
+			}
+		}
+
+	private:
+		static uint32_t rotateLeft(uint32_t value, int shift)
+		{
+			return (value << shift) | (value >> (32 - shift));
+		}
+	};
+}
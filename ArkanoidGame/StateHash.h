@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief FNV-1a hash over the raw bytes of simulation state
+	 * 
+	 * Floats are hashed by bit pattern, so two states hash equal only when
+	 * they are bit-identical. Used to verify replays and compare builds.
+	 */
+	class StateHasher
+	{
+	private:
+		uint64_t value = 0xCBF29CE484222325ull;
+
+	public:
+		void addBytes(const void* data, size_t size)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; ++i)
+			{
+				value ^= bytes[i];
+				value *= 0x100000001B3ull;
+			}
+		}
+
+		template<typename T>
+		void add(const T& field)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be hashed");
+			addBytes(&field, sizeof(T));
+		}
+
+		uint64_t getValue() const { return value; }
+	};
+}
@@ -0,0 +1,114 @@
+#include "SweptCollision.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		// Keeps the earliest candidate impact
+		void Consider(float candidateTime, const sf::Vector2f& candidateNormal, float& bestTime, sf::Vector2f& bestNormal)
+		{
+			if (candidateTime < bestTime)
+			{
+				bestTime = candidateTime;
+				bestNormal = candidateNormal;
+			}
+		}
+
+		// Earliest time the moving point comes within radius of corner, or a negative value
+		float SweepPointCorner(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, const sf::Vector2f& corner)
+		{
+			const sf::Vector2f offset(center.x - corner.x, center.y - corner.y);
+			const float a = displacement.x * displacement.x + displacement.y * displacement.y;
+			const float b = offset.x * displacement.x + offset.y * displacement.y;
+			const float c = offset.x * offset.x + offset.y * offset.y - radius * radius;
+
+			if (c <= 0.0f)
+			{
+				// Already touching the corner: impact now if still moving towards it
+				return b < 0.0f ? 0.0f : -1.0f;
+			}
+			if (b >= 0.0f || a <= 0.0f)
+			{
+				return -1.0f; // Moving away
+			}
+
+			const float discriminant = b * b - a * c;
+			if (discriminant < 0.0f)
+			{
+				return -1.0f;
+			}
+			return (-b - std::sqrt(discriminant)) / a;
+		}
+	}
+
+	bool SweepCircleRect(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, const sf::FloatRect& box, float& time, sf::Vector2f& normal)
+	{
+		const float left = box.left;
+		const float right = box.left + box.width;
+		const float top = box.top;
+		const float bottom = box.top + box.height;
+
+		float bestTime = 2.0f;
+		sf::Vector2f bestNormal;
+
+		// A face counts from up to one radius behind it, so a ball that drifted
+		// slightly into a box while moving inwards still gets pushed back out
+		auto sweepFace = [&](float start, float delta, float plane, float otherStart, float otherDelta, float otherMin, float otherMax, bool isVertical, float sign) {
+			if (delta * sign <= 0.0f)
+				return; // Not moving towards this face
+
+			float faceTime = (plane - start) / delta;
+			if (faceTime < -radius / std::abs(delta) || faceTime > 1.0f)
+				return;
+			faceTime = std::max(0.0f, faceTime);
+
+			const float other = otherStart + otherDelta * faceTime;
+			if (other < otherMin || other > otherMax)
+				return;
+
+			Consider(faceTime, isVertical ? sf::Vector2f(-sign, 0.0f) : sf::Vector2f(0.0f, -sign), bestTime, bestNormal);
+		};
+
+		sweepFace(center.x, displacement.x, left - radius, center.y, displacement.y, top, bottom, true, 1.0f);
+		sweepFace(center.x, displacement.x, right + radius, center.y, displacement.y, top, bottom, true, -1.0f);
+		sweepFace(center.y, displacement.y, top - radius, center.x, displacement.x, left, right, false, 1.0f);
+		sweepFace(center.y, displacement.y, bottom + radius, center.x, displacement.x, left, right, false, -1.0f);
+
+		// Corner circles cover the rounded parts of the expanded box
+		const sf::Vector2f corners[] = { { left, top }, { right, top }, { left, bottom }, { right, bottom } };
+		for (const sf::Vector2f& corner : corners)
+		{
+			const float cornerTime = SweepPointCorner(center, radius, displacement, corner);
+			if (cornerTime < 0.0f || cornerTime > 1.0f || cornerTime >= bestTime)
+				continue;
+
+			const sf::Vector2f contact(center.x + displacement.x * cornerTime, center.y + displacement.y * cornerTime);
+
+			// Only the diagonal region belongs to the corner; faces handle the rest
+			const bool isOutsideX = contact.x < left || contact.x > right;
+			const bool isOutsideY = contact.y < top || contact.y > bottom;
+			if (!isOutsideX || !isOutsideY)
+				continue;
+
+			sf::Vector2f cornerNormal(contact.x - corner.x, contact.y - corner.y);
+			const float length = std::sqrt(cornerNormal.x * cornerNormal.x + cornerNormal.y * cornerNormal.y);
+			if (length <= 0.0f)
+				continue;
+			cornerNormal.x /= length;
+			cornerNormal.y /= length;
+
+			Consider(cornerTime, cornerNormal, bestTime, bestNormal);
+		}
+
+		if (bestTime > 1.0f)
+		{
+			return false;
+		}
+
+		time = bestTime;
+		normal = bestNormal;
+		return true;
+	}
+}
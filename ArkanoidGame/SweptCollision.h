@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Time of impact of a moving circle against an axis-aligned box
+	 * 
+	 * The circle starts at center and moves by displacement during the step. The
+	 * test is exact against the rounded box (faces plus corner circles), so
+	 * glancing corner hits bounce at the right angle.
+	 * 
+	 * @param time Receives the impact time as a fraction of the step, in [0, 1]
+	 * @param normal Receives the unit surface normal at the contact point
+	 * @return True if the circle hits the box while moving into it
+	 */
+	bool SweepCircleRect(const sf::Vector2f& center, float radius, const sf::Vector2f& displacement, const sf::FloatRect& box, float& time, sf::Vector2f& normal);
+
+	// Reflects velocity about a unit normal
+	inline sf::Vector2f Reflect(const sf::Vector2f& velocity, const sf::Vector2f& normal)
+	{
+		const float dot = velocity.x * normal.x + velocity.y * normal.y;
+		return sf::Vector2f(velocity.x - 2.0f * dot * normal.x, velocity.y - 2.0f * dot * normal.y);
+	}
+}
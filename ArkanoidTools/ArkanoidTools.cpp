@@ -0,0 +1,1036 @@
+// Command line tools built on the headless Arkanoid simulation
+
+#include "ArkanoidEnv.h"
+#include "Autopilot.h"
+#include "BrickField.h"
+#include "DifficultyReport.h"
+#include "GameSettings.h"
+#include "InputLog.h"
+#include "LevelCompiler.h"
+#include "LevelPack.h"
+#include "NetChannel.h"
+#include "RecordsStore.h"
+#include "RewindBuffer.h"
+#include "RollbackSession.h"
+#include "SimBatchRunner.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ArkanoidGame;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "Usage: ArkanoidTools <command> [arguments]" << std::endl;
+		std::cout << "Commands:" << std::endl;
+		std::cout << "  batch [sessions] [maxTicks] [threads] [ticksPerSecond] [follow|autopilot]" << std::endl;
+		std::cout << "                                         - run independent bot sessions on all cores and report throughput" << std::endl;
+		std::cout << "  broadphase [queries]                   - compare grid and linear ball-brick queries at 24, 1k, 10k and 100k bricks" << std::endl;
+		std::cout << "  multiball [balls] [ticks]              - time simulation steps with at least the given number of balls in play" << std::endl;
+		std::cout << "  compile <pack> <level.txt>...          - compile level sources into a pack the game maps at startup" << std::endl;
+		std::cout << "  levels <pack>                          - list the levels of a pack and time loading each into a brick field" << std::endl;
+		std::cout << "  records <file> [count]                 - write, load and damage a records log of count players and time each step" << std::endl;
+		std::cout << "  record <file> [seed] [ticks] [ticksPerSecond] [pack level]" << std::endl;
+		std::cout << "                                         - play one bot session and save its input log" << std::endl;
+		std::cout << "  replay <file> [pack]                   - replay an input log headless and verify its state hashes" << std::endl;
+		std::cout << "  snapshot [ticks] [pack level | bricks count]" << std::endl;
+		std::cout << "                                         - time snapshots and the rewind buffer on a bot session and verify restores" << std::endl;
+		std::cout << "  versus [ticks] [latencyMs] [loss%] [jitterMs]" << std::endl;
+		std::cout << "                                         - play a bot versus match between two rollback peers over loopback UDP" << std::endl;
+		std::cout << "  autopilot [sessions] [maxTicks]        - play sessions with the landing-prediction bot on one core and report its accuracy" << std::endl;
+		std::cout << "  env [envs] [steps] [threads]           - step the reinforcement-learning environment through its C interface and report env steps/sec" << std::endl;
+		std::cout << "  difficulty <json|csv> [sessions] [maxTicks] [threads] [seed | pack level]" << std::endl;
+		std::cout << "                                         - estimate how hard a generated or designed level is from autopilot playthroughs on all cores" << std::endl;
+	}
+
+	// Returns argv[index] as a number or defaultValue when the argument is missing
+	long long GetArgument(int argc, char** argv, int index, long long defaultValue)
+	{
+		return index < argc ? std::atoll(argv[index]) : defaultValue;
+	}
+
+	void PrintBatchStats(const char* title, const SimBatchStats& stats)
+	{
+		std::cout << title << std::endl;
+		std::cout << "  sessions:      " << stats.sessions << " (won " << stats.sessionsWon << ", lost " << stats.sessionsLost << ")" << std::endl;
+		std::cout << "  ticks:         " << stats.ticks << std::endl;
+		std::cout << "  bricks:        " << stats.bricksDestroyed << " destroyed, " << stats.bricksLeft << " left" << std::endl;
+		std::cout << "  bonuses:       " << stats.bonusesDropped << " dropped, " << stats.bonusesCollected << " collected" << std::endl;
+		std::cout << "  lives lost:    " << stats.livesLost << std::endl;
+		std::cout << "  time:          " << stats.seconds << " s" << std::endl;
+		std::cout << "  sessions/sec:  " << stats.sessionsPerSecond << std::endl;
+		std::cout << "  ticks/sec:     " << stats.ticksPerSecond << std::endl;
+	}
+
+	int RunBatch(int argc, char** argv)
+	{
+		const size_t sessionCount = static_cast<size_t>(GetArgument(argc, argv, 0, 10000));
+		const long long ticksPerSecond = std::max(1LL, GetArgument(argc, argv, 3, 60)); // Coarse rates such as 15 stress the swept collision
+		const uint32_t maxTicks = static_cast<uint32_t>(GetArgument(argc, argv, 1, ticksPerSecond * 60 * 5)); // 5 minutes of game time
+		const size_t threadCount = static_cast<size_t>(GetArgument(argc, argv, 2, 0));
+		const float timeDelta = 1.0f / static_cast<float>(ticksPerSecond);
+
+		const std::string bot = argc > 4 ? argv[4] : "follow";
+		if (bot != "follow" && bot != "autopilot")
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		ThreadPool pool(threadCount);
+		std::cout << "Threads: " << pool.getThreadCount() << ", bot: " << bot << std::endl;
+
+		SimBatchRunner runner(pool, sessionCount, 1, bot == "autopilot" ? AutopilotController : FollowBallController);
+
+		// Lockstep: every session advances one tick, then all threads sync
+		const uint32_t lockstepTicks = 600;
+		const auto startTime = std::chrono::steady_clock::now();
+		for (uint32_t tick = 0; tick < lockstepTicks; ++tick)
+		{
+			runner.tick(timeDelta);
+		}
+		const double lockstepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		uint64_t lockstepTotal = 0;
+		for (size_t i = 0; i < runner.getSessionCount(); ++i)
+		{
+			lockstepTotal += runner.getSessionTicks(i);
+		}
+		std::cout << "Lockstep (" << lockstepTicks << " ticks): " << static_cast<double>(lockstepTotal) / lockstepSeconds << " ticks/sec" << std::endl;
+
+		// Run to completion: sessions are chunked and balanced by work stealing
+		runner.reset(1);
+		PrintBatchStats("Run to completion:", runner.run(maxTicks, timeDelta));
+		return 0;
+	}
+
+	// Fill a field with brickCount regular bricks in a roughly square block grid
+	void BuildBenchmarkField(BrickField& bricks, int brickCount)
+	{
+		const int bricksPerRow = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(brickCount) * 2.0f)));
+		bricks.clear();
+		bricks.reserve(brickCount);
+		for (int i = 0; i < brickCount; ++i)
+		{
+			const float x = (i % bricksPerRow) * (BLOCK_WIDTH + BLOCK_SPACING);
+			const float y = (i / bricksPerRow) * (BLOCK_HEIGHT + BLOCK_SPACING);
+			bricks.add(x, y, BLOCK_WIDTH, BLOCK_HEIGHT, BlockType::Regular, 10, 0);
+		}
+	}
+
+	// Columns of a generated layout, kept so every session of a batch plays the same bricks
+	struct CapturedLayout
+	{
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> width;
+		std::vector<float> height;
+		std::vector<int32_t> points;
+		std::vector<uint8_t> maxHits;
+		std::vector<uint8_t> types;
+		std::vector<uint8_t> colorIndices;
+		LevelView view;
+	};
+
+	void CaptureLayout(const BrickField& bricks, CapturedLayout& layout)
+	{
+		for (size_t i = 0; i < bricks.size(); ++i)
+		{
+			layout.x.push_back(bricks.getX(i));
+			layout.y.push_back(bricks.getY(i));
+			layout.width.push_back(bricks.getWidth(i));
+			layout.height.push_back(bricks.getHeight(i));
+			layout.points.push_back(bricks.getPoints(i));
+			layout.maxHits.push_back(static_cast<uint8_t>(bricks.getMaxHits(i)));
+			layout.types.push_back(static_cast<uint8_t>(bricks.getType(i)));
+			layout.colorIndices.push_back(static_cast<uint8_t>(bricks.getColorIndex(i)));
+		}
+
+		layout.view.name = "generated";
+		layout.view.cellWidth = BLOCK_WIDTH;
+		layout.view.cellHeight = BLOCK_HEIGHT;
+		layout.view.bricks.count = bricks.size();
+		layout.view.bricks.x = layout.x.data();
+		layout.view.bricks.y = layout.y.data();
+		layout.view.bricks.width = layout.width.data();
+		layout.view.bricks.height = layout.height.data();
+		layout.view.bricks.points = layout.points.data();
+		layout.view.bricks.maxHits = layout.maxHits.data();
+		layout.view.bricks.types = layout.types.data();
+		layout.view.bricks.colorIndices = layout.colorIndices.data();
+	}
+
+	// Fill a field with brickCount regular bricks shrunk to fit the top half of the screen, so a session can play them
+	void BuildScreenField(BrickField& bricks, int brickCount, float& cellWidth, float& cellHeight)
+	{
+		const float fieldHeight = SCREEN_HEIGHT * 0.5f;
+		const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(brickCount * SCREEN_WIDTH / fieldHeight))));
+		const int rows = std::max(1, (brickCount + columns - 1) / columns);
+		cellWidth = SCREEN_WIDTH / columns;
+		cellHeight = fieldHeight / rows;
+		bricks.clear();
+		bricks.reserve(brickCount);
+		for (int i = 0; i < brickCount; ++i)
+		{
+			const float x = (i % columns) * cellWidth;
+			const float y = (i / columns) * cellHeight;
+			bricks.add(x, y, cellWidth * 0.9f, cellHeight * 0.9f, BlockType::Regular, 10, 0);
+		}
+	}
+
+	/**
+	 * @brief Runs the same ball-sized queries against a field; every hit destroys the brick
+	 * @return Seconds spent, with checksum receiving the sum of hit indices
+	 */
+	double RunBroadphaseQueries(BrickField& bricks, const std::vector<sf::FloatRect>& queries, bool useGrid, long long& checksum)
+	{
+		checksum = 0;
+		const auto startTime = std::chrono::steady_clock::now();
+		for (const sf::FloatRect& query : queries)
+		{
+			const int index = useGrid ? bricks.findFirstOverlap(query) : bricks.findFirstOverlapLinear(query);
+			if (index >= 0)
+			{
+				checksum += index;
+				bricks.hit(index);
+			}
+		}
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	int RunBroadphase(int argc, char** argv)
+	{
+		const size_t queryCount = static_cast<size_t>(GetArgument(argc, argv, 0, 200000));
+		const int brickCounts[] = { 24, 1000, 10000, 100000 };
+
+		std::cout << "bricks\tlinear ns/query\tgrid ns/query\tspeedup" << std::endl;
+		for (int brickCount : brickCounts)
+		{
+			BrickField linearField;
+			BrickField gridField;
+			BuildBenchmarkField(linearField, brickCount);
+			BuildBenchmarkField(gridField, brickCount);
+			gridField.buildIndex(BLOCK_WIDTH, BLOCK_HEIGHT);
+
+			// Ball-sized boxes spread over the whole field
+			float fieldWidth = BLOCK_WIDTH;
+			float fieldHeight = BLOCK_HEIGHT;
+			for (int i = 0; i < brickCount; ++i)
+			{
+				fieldWidth = std::max(fieldWidth, linearField.getX(i) + BLOCK_WIDTH);
+				fieldHeight = std::max(fieldHeight, linearField.getY(i) + BLOCK_HEIGHT);
+			}
+			std::mt19937 gen(42);
+			std::uniform_real_distribution<float> xDist(-BALL_RADIUS, fieldWidth + BALL_RADIUS);
+			std::uniform_real_distribution<float> yDist(-BALL_RADIUS, fieldHeight + BALL_RADIUS);
+			std::vector<sf::FloatRect> queries(queryCount);
+			for (sf::FloatRect& query : queries)
+			{
+				query = sf::FloatRect(xDist(gen), yDist(gen), BALL_RADIUS * 2, BALL_RADIUS * 2);
+			}
+
+			// Linear queries get fewer iterations on large fields so the run stays short
+			const size_t linearQueryCount = std::min(queryCount, static_cast<size_t>(2000000000 / (static_cast<long long>(brickCount) * 100)) + 1);
+			std::vector<sf::FloatRect> linearQueries(queries.begin(), queries.begin() + linearQueryCount);
+
+			long long linearChecksum = 0;
+			long long gridChecksum = 0;
+			const double linearSeconds = RunBroadphaseQueries(linearField, linearQueries, false, linearChecksum);
+			std::vector<sf::FloatRect> gridQueries(queries.begin(), queries.begin() + linearQueryCount);
+			RunBroadphaseQueries(gridField, gridQueries, true, gridChecksum);
+			if (linearChecksum != gridChecksum)
+			{
+				std::cout << "Mismatch between grid and linear results at " << brickCount << " bricks" << std::endl;
+				return 1;
+			}
+
+			// Time the grid on the full query set from a fresh field
+			BuildBenchmarkField(gridField, brickCount);
+			gridField.buildIndex(BLOCK_WIDTH, BLOCK_HEIGHT);
+			const double gridSeconds = RunBroadphaseQueries(gridField, queries, true, gridChecksum);
+
+			const double linearNs = linearSeconds * 1e9 / static_cast<double>(linearQueryCount);
+			const double gridNs = gridSeconds * 1e9 / static_cast<double>(queryCount);
+			std::cout << brickCount << "\t" << linearNs << "\t" << gridNs << "\t" << linearNs / gridNs << "x" << std::endl;
+		}
+		return 0;
+	}
+
+	int RunMultiball(int argc, char** argv)
+	{
+		const size_t ballCount = static_cast<size_t>(std::max(1LL, GetArgument(argc, argv, 0, 1000)));
+		const uint32_t tickCount = static_cast<uint32_t>(GetArgument(argc, argv, 1, PHYSICS_TICKS_PER_SECOND * 10));
+		const float timeDelta = 1.0f / static_cast<float>(PHYSICS_TICKS_PER_SECOND);
+
+		ArkanoidSim sim(1);
+		SimInput launch;
+		launch.launch = true;
+		sim.step(launch, timeDelta);
+		while (sim.getBallCount() < ballCount && sim.getBallCount() < MAX_EXTRA_BALLS)
+		{
+			sim.splitBalls(2);
+		}
+		std::cout << "Balls at start: " << sim.getBallCount() << std::endl;
+
+		// Balls drain away as the bot only follows the main ball, so report the average
+		double ballTicks = 0.0;
+		uint32_t tick = 0;
+		const auto startTime = std::chrono::steady_clock::now();
+		for (; tick < tickCount && sim.getStatus() == SimStatus::Running; ++tick)
+		{
+			sim.step(FollowBallController(sim), timeDelta);
+			ballTicks += static_cast<double>(sim.getBallCount());
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		const double tickMicroseconds = seconds * 1e6 / std::max(1u, tick);
+		std::cout << "Ticks:          " << tick << std::endl;
+		std::cout << "Average balls:  " << ballTicks / std::max(1u, tick) << std::endl;
+		std::cout << "Time per tick:  " << tickMicroseconds << " us" << std::endl;
+		std::cout << "Physics per 60 FPS frame: " << tickMicroseconds * PHYSICS_TICKS_PER_SECOND / 60.0 / 1000.0 << " ms" << std::endl;
+		return 0;
+	}
+
+	int RunCompile(int argc, char** argv)
+	{
+		if (argc < 2)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		std::vector<LevelSource> levels(argc - 1);
+		std::string error;
+		size_t brickCount = 0;
+		for (int i = 1; i < argc; ++i)
+		{
+			if (!LoadLevelSource(argv[i], levels[i - 1], error))
+			{
+				std::cout << error << std::endl;
+				return 1;
+			}
+			brickCount += levels[i - 1].bricks.size();
+		}
+
+		if (!WriteLevelPack(argv[0], levels, error))
+		{
+			std::cout << error << std::endl;
+			return 1;
+		}
+		std::cout << "Compiled " << levels.size() << " levels, " << brickCount << " bricks into " << argv[0] << std::endl;
+		return 0;
+	}
+
+	int RunLevels(int argc, char** argv)
+	{
+		LevelPack pack;
+		auto startTime = std::chrono::steady_clock::now();
+		if (argc < 1 || !pack.open(argv[0]))
+		{
+			std::cout << "Cannot open level pack " << (argc < 1 ? "" : argv[0]) << std::endl;
+			return 1;
+		}
+		std::cout << "Open:  " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() * 1000.0 << " ms, "
+			<< pack.getLevelCount() << " levels" << std::endl;
+
+		// Load through the sim, as the game does: columns into the brick field, then the broadphase grid
+		ArkanoidSim sim(1);
+		for (size_t i = 0; i < pack.getLevelCount(); ++i)
+		{
+			const LevelView level = pack.getLevel(i);
+			startTime = std::chrono::steady_clock::now();
+			sim.reset(1, level);
+			const double milliseconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() * 1000.0;
+			std::cout << "  " << i << ": " << level.name << ", " << level.bricks.count << " bricks, loaded in " << milliseconds << " ms" << std::endl;
+		}
+		return 0;
+	}
+
+	bool AreRankingsEqual(const Leaderboard& a, const Leaderboard& b)
+	{
+		const std::vector<LeaderboardEntry>& rankingA = a.getRanking();
+		const std::vector<LeaderboardEntry>& rankingB = b.getRanking();
+		return rankingA.size() == rankingB.size() && std::equal(rankingA.begin(), rankingA.end(), rankingB.begin(),
+			[](const LeaderboardEntry& x, const LeaderboardEntry& y) { return x.name == y.name && x.score == y.score; });
+	}
+
+	int RunRecords(int argc, char** argv)
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		const std::string path = argv[0];
+		const size_t recordCount = static_cast<size_t>(std::max(1LL, GetArgument(argc, argv, 1, 1000000)));
+
+		// A board big enough for every player, so the log holds recordCount entries
+		Leaderboard board(recordCount + 1);
+		std::mt19937 random(1);
+		auto startTime = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < recordCount; ++i)
+		{
+			board.set("Player" + std::to_string(i), static_cast<int>(random() % 100000));
+		}
+		std::cout << "Insert:   " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << " s" << std::endl;
+
+		RecordsStore store(path);
+		startTime = std::chrono::steady_clock::now();
+		if (!store.compact(board))
+		{
+			std::cout << "Cannot write " << path << std::endl;
+			return 1;
+		}
+		std::cout << "Compact:  " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << " s, "
+			<< std::filesystem::file_size(path) << " bytes" << std::endl;
+
+		Leaderboard expected(recordCount + 1);
+		store.load(expected);
+
+		startTime = std::chrono::steady_clock::now();
+		store.append("Latecomer", 123);
+		std::cout << "Append:   " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() * 1000.0 << " ms" << std::endl;
+		board.set("Latecomer", 123);
+
+		Leaderboard loaded(recordCount + 1);
+		startTime = std::chrono::steady_clock::now();
+		const bool isLoaded = store.load(loaded);
+		std::cout << "Load:     " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << " s, "
+			<< store.getLogEntryCount() << " entries" << std::endl;
+		if (!isLoaded || !AreRankingsEqual(loaded, board))
+		{
+			std::cout << "MISMATCH after load" << std::endl;
+			return 2;
+		}
+
+		// The game keeps only the best MAX_RECORDS of the same log
+		Leaderboard top(MAX_RECORDS);
+		startTime = std::chrono::steady_clock::now();
+		store.load(top);
+		std::cout << "Load top: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << " s, best "
+			<< top.getRanking().front().score << ", lowest " << top.getLowestScore() << std::endl;
+
+		// Simulate a crash in the middle of an append: the torn entry must be dropped, the rest kept
+		std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+		loaded.clear();
+		store.load(loaded);
+		if (!store.getHasDamagedTail() || !AreRankingsEqual(loaded, expected))
+		{
+			std::cout << "MISMATCH after torn append" << std::endl;
+			return 2;
+		}
+		std::cout << "Torn append dropped, " << store.getLogEntryCount() << " entries kept" << std::endl;
+
+		std::filesystem::remove(path);
+		return 0;
+	}
+
+	int RunRecord(int argc, char** argv)
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		const unsigned int seed = static_cast<unsigned int>(GetArgument(argc, argv, 1, 1));
+		const long long ticksPerSecond = std::max(1LL, GetArgument(argc, argv, 3, PHYSICS_TICKS_PER_SECOND));
+		const uint32_t maxTicks = static_cast<uint32_t>(GetArgument(argc, argv, 2, ticksPerSecond * 60 * 5));
+		const float timeDelta = 1.0f / static_cast<float>(ticksPerSecond);
+
+		LevelPack pack;
+		const int levelIndex = static_cast<int>(GetArgument(argc, argv, 5, argc > 4 ? 0 : -1));
+		if (argc > 4 && (!pack.open(argv[4]) || levelIndex < 0 || static_cast<size_t>(levelIndex) >= pack.getLevelCount()))
+		{
+			std::cout << "Cannot open level " << levelIndex << " of " << argv[4] << std::endl;
+			return 1;
+		}
+
+		ArkanoidSim sim(seed);
+		if (levelIndex >= 0)
+		{
+			sim.reset(seed, pack.getLevel(levelIndex));
+		}
+		InputLog log;
+		log.begin(seed, levelIndex);
+		for (uint32_t tick = 0; tick < maxTicks && sim.getStatus() == SimStatus::Running; ++tick)
+		{
+			const SimInput input = FollowBallController(sim);
+			sim.step(input, timeDelta);
+			log.record(input, timeDelta, sim);
+		}
+		log.finish(sim);
+
+		if (!log.saveToFile(argv[0]))
+		{
+			std::cout << "Cannot write " << argv[0] << std::endl;
+			return 1;
+		}
+		std::cout << "Recorded " << log.getTickCount() << " ticks, score " << sim.getScore() << ", hash " << std::hex << log.getFinalHash() << std::dec << std::endl;
+		return 0;
+	}
+
+	int RunReplay(int argc, char** argv)
+	{
+		InputLog log;
+		if (argc < 1 || !log.loadFromFile(argv[0]))
+		{
+			std::cout << "Cannot read input log " << (argc < 1 ? "" : argv[0]) << std::endl;
+			return 1;
+		}
+
+		LevelPack pack;
+		if (argc > 1 && !pack.open(argv[1]))
+		{
+			std::cout << "Cannot open level pack " << argv[1] << std::endl;
+			return 1;
+		}
+		if (log.getLevelIndex() >= 0 && static_cast<size_t>(log.getLevelIndex()) >= pack.getLevelCount())
+		{
+			std::cout << "The log was played on level " << log.getLevelIndex() << "; pass the level pack it came from" << std::endl;
+			return 1;
+		}
+
+		ArkanoidSim sim(log.getSeed());
+		const auto startTime = std::chrono::steady_clock::now();
+		const ReplayResult result = ReplayInputLog(log, sim, argc > 1 ? &pack : nullptr);
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << "Seed:        " << log.getSeed() << std::endl;
+		std::cout << "Level:       " << log.getLevelIndex() << (log.getLevelIndex() < 0 ? " (generated)" : "") << std::endl;
+		std::cout << "Ticks:       " << result.ticks << " (" << static_cast<double>(result.ticks) / seconds << " ticks/sec)" << std::endl;
+		std::cout << "Score:       " << sim.getScore() << ", lives " << sim.getLives() << std::endl;
+		std::cout << "Final hash:  " << std::hex << result.finalHash << " (recorded " << log.getFinalHash() << ")" << std::dec << std::endl;
+		if (!result.isMatching)
+		{
+			std::cout << "DIVERGED by tick " << result.firstMismatchTick << std::endl;
+			return 2;
+		}
+		std::cout << "Replay matches" << std::endl;
+		return 0;
+	}
+
+	int RunSnapshot(int argc, char** argv)
+	{
+		const uint32_t tickCount = static_cast<uint32_t>(std::max(2LL, GetArgument(argc, argv, 0, PHYSICS_TICKS_PER_SECOND * 20)));
+		const float timeDelta = 1.0f / static_cast<float>(PHYSICS_TICKS_PER_SECOND);
+		const double frameMicroseconds = 1e6 / 60.0;
+		const double ticksPerFrame = PHYSICS_TICKS_PER_SECOND / 60.0;
+
+		// "bricks count" plays a generated layout of that size instead of a pack level
+		const bool isGenerated = argc > 1 && std::string(argv[1]) == "bricks";
+		LevelPack pack;
+		const int levelIndex = static_cast<int>(GetArgument(argc, argv, 2, argc > 1 ? 0 : -1));
+		if (argc > 1 && !isGenerated && (!pack.open(argv[1]) || levelIndex < 0 || static_cast<size_t>(levelIndex) >= pack.getLevelCount()))
+		{
+			std::cout << "Cannot open level " << levelIndex << " of " << argv[1] << std::endl;
+			return 1;
+		}
+
+		ArkanoidSim sim(1);
+		if (isGenerated)
+		{
+			BrickField field;
+			float cellWidth = 0.0f;
+			float cellHeight = 0.0f;
+			BuildScreenField(field, static_cast<int>(std::max(1LL, GetArgument(argc, argv, 2, 10000))), cellWidth, cellHeight);
+			CapturedLayout layout;
+			CaptureLayout(field, layout);
+			layout.view.cellWidth = cellWidth;
+			layout.view.cellHeight = cellHeight;
+			sim.reset(1, layout.view);
+		}
+		else if (levelIndex >= 0)
+		{
+			sim.reset(1, pack.getLevel(levelIndex));
+		}
+		std::cout << "Bricks:         " << sim.getBricks().size() << std::endl;
+
+		// Full snapshots: what instant retry saves once and restores
+		SimSnapshot start;
+		const int repeats = 1000;
+		auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; ++i)
+		{
+			sim.saveSnapshot(start);
+		}
+		const double saveMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count() / repeats;
+		const uint64_t startHash = sim.computeStateHash();
+
+		// Play the session, recording every tick into the rewind buffer
+		RewindBuffer rewind(static_cast<size_t>(REWIND_SECONDS) * PHYSICS_TICKS_PER_SECOND);
+		rewind.reset(sim);
+		std::vector<SimInput> inputs;
+		std::vector<uint64_t> hashes;
+		double recordSeconds = 0.0;
+		for (uint32_t tick = 0; tick < tickCount && sim.getStatus() == SimStatus::Running; ++tick)
+		{
+			inputs.push_back(FollowBallController(sim));
+			sim.step(inputs.back(), timeDelta);
+			const auto recordStart = std::chrono::steady_clock::now();
+			rewind.record(sim);
+			recordSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - recordStart).count();
+			hashes.push_back(sim.computeStateHash());
+		}
+		const size_t ticks = inputs.size();
+		const double recordMicroseconds = recordSeconds * 1e6 / static_cast<double>(ticks);
+
+		// Step back as far as the buffer reaches, then play the same inputs forward again
+		startTime = std::chrono::steady_clock::now();
+		const size_t undone = rewind.rewind(sim, ticks);
+		const double rewindMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+		const size_t rewoundTick = ticks - undone;
+		bool isMatching = sim.computeStateHash() == (rewoundTick == 0 ? startHash : hashes[rewoundTick - 1]);
+		for (size_t tick = rewoundTick; tick < ticks; ++tick)
+		{
+			sim.step(inputs[tick], timeDelta);
+		}
+		isMatching = isMatching && sim.computeStateHash() == hashes.back();
+
+		// Instant retry: back to the start in one restore, then the whole session again
+		startTime = std::chrono::steady_clock::now();
+		sim.restoreSnapshot(start);
+		const double restoreMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+		isMatching = isMatching && sim.computeStateHash() == startHash;
+		for (const SimInput& input : inputs)
+		{
+			sim.step(input, timeDelta);
+		}
+		isMatching = isMatching && sim.computeStateHash() == hashes.back();
+
+		std::cout << "Ticks:          " << ticks << ", score " << sim.getScore() << std::endl;
+		std::cout << "Full snapshot:  " << saveMicroseconds << " us to save, " << restoreMicroseconds << " us to restore" << std::endl;
+		std::cout << "Rewind record:  " << recordMicroseconds << " us per tick, "
+			<< recordMicroseconds * ticksPerFrame * 100.0 / frameMicroseconds << "% of a 60 FPS frame" << std::endl;
+		std::cout << "Rewind:         " << undone << " ticks in " << rewindMicroseconds << " us" << std::endl;
+		if (!isMatching)
+		{
+			std::cout << "Restored state DIVERGED from the recorded session" << std::endl;
+			return 2;
+		}
+		std::cout << "Restores match" << std::endl;
+		return 0;
+	}
+
+	void PrintRollbackStats(const char* title, const RollbackSession& session, const LossyChannel& shim)
+	{
+		const RollbackStats& stats = session.getStats();
+		std::cout << title << std::endl;
+		std::cout << "  ticks:         " << session.getTick() << " (" << stats.stalls << " waits for the peer)" << std::endl;
+		std::cout << "  rollbacks:     " << stats.rollbacks << ", " << stats.resimulatedTicks << " ticks resimulated, deepest "
+			<< stats.maxRollbackTicks << std::endl;
+		std::cout << "  packets:       " << stats.packetsSent << " sent, " << shim.getDroppedCount() << " dropped by the shim, "
+			<< stats.packetsReceived << " received" << std::endl;
+		std::cout << "  hashes:        " << stats.hashesCompared << " compared, "
+			<< (session.isDesynced() ? "DESYNC at tick " + std::to_string(session.getDesyncTick()) : std::string("in sync")) << std::endl;
+	}
+
+	int RunVersus(int argc, char** argv)
+	{
+		const uint32_t tickCount = static_cast<uint32_t>(std::max(1LL, GetArgument(argc, argv, 0, PHYSICS_TICKS_PER_SECOND * 30)));
+		NetConditions conditions;
+		conditions.latency = static_cast<float>(GetArgument(argc, argv, 1, 40)) / 1000.0f;
+		conditions.lossRate = static_cast<float>(GetArgument(argc, argv, 2, 5)) / 100.0f;
+		conditions.jitter = static_cast<float>(GetArgument(argc, argv, 3, 10)) / 1000.0f;
+		const unsigned int seed = 7;
+
+		// Two real sockets on loopback, each behind its own shim
+		UdpChannel hostSocket;
+		UdpChannel joinSocket;
+		if (!hostSocket.open() || !joinSocket.open())
+		{
+			std::cout << "Cannot open loopback sockets" << std::endl;
+			return 1;
+		}
+		hostSocket.setPeer(sf::IpAddress::LocalHost, joinSocket.getLocalPort());
+		joinSocket.setPeer(sf::IpAddress::LocalHost, hostSocket.getLocalPort());
+		LossyChannel hostLink(hostSocket, conditions, 1);
+		LossyChannel joinLink(joinSocket, conditions, 2);
+
+		RollbackSession host(hostLink, nullptr);
+		RollbackSession join(joinLink, nullptr);
+		host.host(seed, -1);
+		join.join();
+
+		// Virtual time moves one tick per round, so the shims delay by ticks whatever the machine speed;
+		// after the last tick the peers only exchange packets until every tick is confirmed, or give up after NET_TIMEOUT_SECONDS without progress
+		const auto startTime = std::chrono::steady_clock::now();
+		const auto isSettled = [&](const RollbackSession& session) {
+			return session.getConfirmedTick() == session.getTick() && (session.isFinished() || session.getTick() >= tickCount);
+		};
+		const int maxIdleRounds = NET_TIMEOUT_SECONDS * PHYSICS_TICKS_PER_SECOND;
+		int idleRounds = 0;
+		while (!(isSettled(host) && isSettled(join)) && idleRounds < maxIdleRounds)
+		{
+			hostLink.advance(RollbackSession::TIME_STEP);
+			joinLink.advance(RollbackSession::TIME_STEP);
+			bool isStepped = false;
+			if (host.getTick() < tickCount)
+			{
+				isStepped = host.advance(FollowBallController(host.getSim(0))) || isStepped;
+			}
+			else
+			{
+				host.poll();
+			}
+			if (join.getTick() < tickCount)
+			{
+				isStepped = join.advance(FollowBallController(join.getSim(1))) || isStepped;
+			}
+			else
+			{
+				join.poll();
+			}
+
+			// With nothing held back by the shims, only the loopback itself can still deliver, so give it time
+			idleRounds = isStepped ? 0 : idleRounds + 1;
+			if (!isStepped && hostLink.getDelayedCount() == 0 && joinLink.getDelayedCount() == 0)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		PrintRollbackStats("Host:", host, hostLink);
+		PrintRollbackStats("Joined peer:", join, joinLink);
+
+		// Both peers, and a plain offline run on the inputs they agreed on, must end in the same state
+		const uint32_t ticks = host.getTick();
+		ArkanoidSim player1(seed);
+		ArkanoidSim player2(seed);
+		bool isMatching = join.getTick() == ticks && host.getConfirmedTick() == ticks && join.getConfirmedTick() == ticks;
+		for (uint32_t tick = 0; tick < ticks && isMatching; ++tick)
+		{
+			isMatching = host.getInputBits(0, tick) == join.getInputBits(0, tick) && host.getInputBits(1, tick) == join.getInputBits(1, tick);
+			player1.step(UnpackInput(host.getInputBits(0, tick)), RollbackSession::TIME_STEP);
+			player2.step(UnpackInput(host.getInputBits(1, tick)), RollbackSession::TIME_STEP);
+		}
+
+		uint64_t hostHash = 0;
+		uint64_t joinHash = 1;
+		if (ticks > 0 && isMatching)
+		{
+			isMatching = host.getTickHash(ticks - 1, hostHash) && join.getTickHash(ticks - 1, joinHash) &&
+				hostHash == joinHash && hostHash == ComputeVersusHash(ticks - 1, player1, player2);
+		}
+
+		const char* const OUTCOME_NAMES[] = { "running", "player 1 won", "player 2 won", "draw" };
+		std::cout << "Match:          " << ticks << " ticks, " << OUTCOME_NAMES[static_cast<int>(host.getOutcome())]
+			<< ", scores " << host.getSim(0).getScore() << " : " << host.getSim(1).getScore() << ", " << seconds << " s" << std::endl;
+		if (!isMatching || host.isDesynced() || join.isDesynced())
+		{
+			std::cout << "Peers DIVERGED" << std::endl;
+			return 2;
+		}
+
+		// Peers that agree on a match cut short, or on nothing at all, prove nothing
+		if (ticks == 0 || !(isSettled(host) && isSettled(join)))
+		{
+			std::cout << "Match INCOMPLETE: the peers stopped hearing from each other" << std::endl;
+			return 3;
+		}
+		std::cout << "Peers match the offline run" << std::endl;
+		return 0;
+	}
+
+	/**
+	 * @brief Plays sessions with the caching Autopilot and with FollowBallController on one thread
+	 * 
+	 * Landing error is measured on every platform bounce of a lone ball: the
+	 * contact point, interpolated along the last step, against the prediction the
+	 * bot steered by.
+	 */
+	int RunAutopilot(int argc, char** argv)
+	{
+		const size_t sessionCount = static_cast<size_t>(std::max(1LL, GetArgument(argc, argv, 0, 200)));
+		const uint32_t maxTicks = static_cast<uint32_t>(GetArgument(argc, argv, 1, PHYSICS_TICKS_PER_SECOND * 60 * 5));
+		const float timeDelta = 1.0f / PHYSICS_TICKS_PER_SECOND;
+
+		uint64_t ticks = 0;
+		uint64_t catches = 0;
+		uint64_t sessionsWon = 0;
+		double totalError = 0.0;
+		double maxError = 0.0;
+		SimSessionCounters counters;
+		ArkanoidSim sim(1);
+		Autopilot autopilot;
+		const auto startTime = std::chrono::steady_clock::now();
+		for (size_t session = 0; session < sessionCount; ++session)
+		{
+			sim.reset(static_cast<unsigned int>(session + 1));
+			autopilot.reset();
+			for (uint32_t tick = 0; tick < maxTicks && sim.getStatus() == SimStatus::Running; ++tick)
+			{
+				const SimInput input = autopilot.poll(sim);
+				const sf::Vector2f position = sim.getBall().getPosition();
+				const sf::Vector2f velocity = sim.getBall().getVelocity();
+				const bool isTracked = sim.getBallCount() == 1 && sim.getBall().getIsLaunched() && velocity.y > 0.0f && autopilot.getLanding().isValid;
+				const float predictedX = autopilot.getLanding().x;
+
+				sim.step(input, timeDelta);
+				counters.countEvents(sim.getEvents());
+				++ticks;
+
+				const float lineY = sim.getPlatform().getBounds().top - sim.getBall().getRadius();
+				if (isTracked && sim.getBall().getVelocity().y < 0.0f && position.y <= lineY && sim.getBall().getPosition().y >= lineY - velocity.y * timeDelta)
+				{
+					const float contactX = position.x + velocity.x * (lineY - position.y) / velocity.y;
+					const double error = std::abs(contactX - predictedX);
+					totalError += error;
+					maxError = std::max(maxError, error);
+					++catches;
+				}
+			}
+			sessionsWon += sim.getStatus() == SimStatus::Won ? 1 : 0;
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		const uint64_t predictions = autopilot.getPredictionCount();
+
+		std::cout << "Autopilot, " << sessionCount << " sessions on one thread:" << std::endl;
+		std::cout << "  ticks:         " << ticks << " (" << static_cast<double>(ticks) / seconds << " ticks/sec)" << std::endl;
+		std::cout << "  predictions:   " << predictions << " (" << static_cast<double>(predictions) / seconds << "/sec, one per " << static_cast<double>(ticks) / std::max<uint64_t>(1, predictions) << " ticks)" << std::endl;
+		std::cout << "  catches:       " << catches << ", landing error " << (catches ? totalError / catches : 0.0) << " px average, " << maxError << " px max" << std::endl;
+		std::cout << "  sessions won:  " << sessionsWon << ", lives lost " << counters.livesLost << ", bricks destroyed " << counters.bricksDestroyed << std::endl;
+
+		// Same sessions with the simple bot, for comparison
+		SimSessionCounters followCounters;
+		uint64_t followWon = 0;
+		for (size_t session = 0; session < sessionCount; ++session)
+		{
+			sim.reset(static_cast<unsigned int>(session + 1));
+			for (uint32_t tick = 0; tick < maxTicks && sim.getStatus() == SimStatus::Running; ++tick)
+			{
+				sim.step(FollowBallController(sim), timeDelta);
+				followCounters.countEvents(sim.getEvents());
+			}
+			followWon += sim.getStatus() == SimStatus::Won ? 1 : 0;
+		}
+		std::cout << "Follow-ball bot: sessions won " << followWon << ", lives lost " << followCounters.livesLost << ", bricks destroyed " << followCounters.bricksDestroyed << std::endl;
+		return 0;
+	}
+
+	/**
+	 * @brief Steps an ArkanoidEnv the way a training loop would, on one thread and then on threadCount
+	 * 
+	 * The policy is a follow-the-ball rule on the observations, so the timing
+	 * covers the C interface, the simulation and the observation writes.
+	 * @return Env steps per second
+	 */
+	double BenchmarkEnv(uint32_t envCount, uint32_t steps, uint32_t threadCount)
+	{
+		ArkanoidEnvConfig config;
+		ArkanoidEnvGetDefaultConfig(&config);
+		config.envCount = envCount;
+		config.threadCount = threadCount;
+		ArkanoidEnv* env = ArkanoidEnvCreate(&config);
+		if (!env)
+			return 0.0;
+
+		// Buffers are allocated once, as a trainer would keep its arrays
+		const uint32_t brickWords = ArkanoidEnvGetBrickWordCount(env);
+		std::vector<float> observations(static_cast<size_t>(envCount) * ARKANOID_ENV_OBSERVATION_SIZE);
+		std::vector<uint64_t> brickBits(static_cast<size_t>(envCount) * brickWords);
+		std::vector<float> rewards(envCount);
+		std::vector<uint8_t> dones(envCount);
+		std::vector<uint8_t> actions(envCount);
+
+		double totalReward = 0.0;
+		uint64_t episodes = 0;
+		const auto startTime = std::chrono::steady_clock::now();
+		ArkanoidEnvReset(env, observations.data(), brickBits.data());
+		for (uint32_t step = 0; step < steps; ++step)
+		{
+			for (uint32_t i = 0; i < envCount; ++i)
+			{
+				const float* observation = observations.data() + static_cast<size_t>(i) * ARKANOID_ENV_OBSERVATION_SIZE;
+				const float offset = observation[ARKANOID_OBS_BALL_X] - observation[ARKANOID_OBS_PLATFORM_X];
+				if (observation[ARKANOID_OBS_BALL_LAUNCHED] == 0.0f)
+					actions[i] = ARKANOID_ACTION_LAUNCH;
+				else
+					actions[i] = offset < -0.01f ? ARKANOID_ACTION_LEFT : (offset > 0.01f ? ARKANOID_ACTION_RIGHT : ARKANOID_ACTION_STAY);
+			}
+			ArkanoidEnvStep(env, actions.data(), observations.data(), brickBits.data(), rewards.data(), dones.data());
+			for (uint32_t i = 0; i < envCount; ++i)
+			{
+				totalReward += rewards[i];
+				episodes += dones[i] != ARKANOID_ENV_RUNNING ? 1 : 0;
+			}
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		ArkanoidEnvDestroy(env);
+
+		const double envSteps = static_cast<double>(envCount) * steps;
+		std::cout << "  " << (threadCount ? std::to_string(threadCount) : std::string("all")) << " thread(s): "
+			<< envSteps / seconds << " env steps/sec, " << envSteps * config.ticksPerStep / seconds << " ticks/sec, "
+			<< episodes << " episodes ended, reward " << totalReward / envCount << " per env" << std::endl;
+		return envSteps / seconds;
+	}
+
+	int RunEnv(int argc, char** argv)
+	{
+		const uint32_t envCount = static_cast<uint32_t>(std::max(1LL, GetArgument(argc, argv, 0, 1024)));
+		const uint32_t steps = static_cast<uint32_t>(GetArgument(argc, argv, 1, 1000));
+		const uint32_t threadCount = static_cast<uint32_t>(GetArgument(argc, argv, 2, 0));
+
+		std::cout << envCount << " envs, " << steps << " steps:" << std::endl;
+		const double singleThread = BenchmarkEnv(envCount, steps, 1);
+		const double pooled = BenchmarkEnv(envCount, steps, threadCount);
+		if (singleThread > 0.0 && pooled > 0.0)
+		{
+			std::cout << "  scaling: " << pooled / singleThread << "x" << std::endl;
+		}
+		return singleThread > 0.0 && pooled > 0.0 ? 0 : 1;
+	}
+
+	/**
+	 * @brief Plays one level many times with the autopilot and prints its difficulty report
+	 * 
+	 * The level is either the layout generated from a seed or a level of a pack,
+	 * by index or name. Every session plays the same bricks; the session seeds
+	 * vary the bonus drops, so the runs spread like real games do. Only the
+	 * report goes to stdout, so it can be redirected to a file.
+	 */
+	int RunDifficulty(int argc, char** argv)
+	{
+		const std::string format = argc > 0 ? argv[0] : "";
+		if (format != "json" && format != "csv")
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		const size_t sessionCount = static_cast<size_t>(std::max(1LL, GetArgument(argc, argv, 1, 2000)));
+		const uint32_t maxTicks = static_cast<uint32_t>(GetArgument(argc, argv, 2, PHYSICS_TICKS_PER_SECOND * 60 * 10)); // 10 minutes of game time
+		const size_t threadCount = static_cast<size_t>(GetArgument(argc, argv, 3, 0));
+		const float timeDelta = 1.0f / PHYSICS_TICKS_PER_SECOND;
+
+		LevelPack pack;
+		CapturedLayout generated;
+		LevelView level;
+		std::string levelName;
+		if (argc > 5)
+		{
+			int levelIndex = -1;
+			if (pack.open(argv[4]))
+			{
+				levelIndex = pack.findLevel(argv[5]);
+				if (levelIndex < 0 && std::isdigit(static_cast<unsigned char>(argv[5][0])))
+				{
+					levelIndex = std::atoi(argv[5]);
+				}
+			}
+			if (levelIndex < 0 || static_cast<size_t>(levelIndex) >= pack.getLevelCount())
+			{
+				std::cout << "Cannot open level " << argv[5] << " of " << argv[4] << std::endl;
+				return 1;
+			}
+			level = pack.getLevel(levelIndex);
+			levelName = level.name;
+		}
+		else
+		{
+			const unsigned int layoutSeed = static_cast<unsigned int>(GetArgument(argc, argv, 4, 1));
+			const ArkanoidSim layoutSim(layoutSeed);
+			CaptureLayout(layoutSim.getBricks(), generated);
+			level = generated.view;
+			levelName = "generated seed " + std::to_string(layoutSeed);
+		}
+
+		ThreadPool pool(threadCount);
+		SimBatchRunner runner(pool, sessionCount, 1, AutopilotController);
+		runner.reset(1, level);
+		const SimBatchStats stats = runner.run(maxTicks, timeDelta);
+
+		DifficultyReport report = BuildDifficultyReport(runner, stats, timeDelta);
+		report.level = levelName;
+		report.bot = "autopilot";
+		if (format == "json")
+		{
+			WriteDifficultyJson(std::cout, report);
+		}
+		else
+		{
+			WriteDifficultyCsv(std::cout, report);
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	const std::string command = argv[1];
+	if (command == "batch")
+	{
+		return RunBatch(argc - 2, argv + 2);
+	}
+	if (command == "broadphase")
+	{
+		return RunBroadphase(argc - 2, argv + 2);
+	}
+
+	if (command == "multiball")
+	{
+		return RunMultiball(argc - 2, argv + 2);
+	}
+	if (command == "compile")
+	{
+		return RunCompile(argc - 2, argv + 2);
+	}
+	if (command == "levels")
+	{
+		return RunLevels(argc - 2, argv + 2);
+	}
+	if (command == "records")
+	{
+		return RunRecords(argc - 2, argv + 2);
+	}
+	if (command == "record")
+	{
+		return RunRecord(argc - 2, argv + 2);
+	}
+	if (command == "replay")
+	{
+		return RunReplay(argc - 2, argv + 2);
+	}
+	if (command == "snapshot")
+	{
+		return RunSnapshot(argc - 2, argv + 2);
+	}
+
+	if (command == "versus")
+	{
+		return RunVersus(argc - 2, argv + 2);
+	}
+	if (command == "autopilot")
+	{
+		return RunAutopilot(argc - 2, argv + 2);
+	}
+	if (command == "env")
+	{
+		return RunEnv(argc - 2, argv + 2);
+	}
+	if (command == "difficulty")
+	{
+		return RunDifficulty(argc - 2, argv + 2);
+	}
+
+	PrintUsage();
+	return 1;
+}
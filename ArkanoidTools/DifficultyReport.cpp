@@ -0,0 +1,217 @@
+#include "DifficultyReport.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		DistributionSummary Summarize(std::vector<double>& values)
+		{
+			DistributionSummary summary;
+			summary.count = values.size();
+			if (values.empty())
+				return summary;
+
+			std::sort(values.begin(), values.end());
+			double sum = 0.0;
+			for (double value : values)
+			{
+				sum += value;
+			}
+			summary.mean = sum / values.size();
+
+			double squares = 0.0;
+			for (double value : values)
+			{
+				squares += (value - summary.mean) * (value - summary.mean);
+			}
+			summary.standardDeviation = std::sqrt(squares / values.size());
+
+			// Nearest-rank percentiles
+			auto percentile = [&values](double fraction) {
+				const size_t rank = static_cast<size_t>(std::ceil(fraction * values.size()));
+				return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+			};
+			summary.min = values.front();
+			summary.p10 = percentile(0.1);
+			summary.median = percentile(0.5);
+			summary.p90 = percentile(0.9);
+			summary.max = values.back();
+			return summary;
+		}
+
+		// Wilson score interval, which stays inside [0, 1] even for rates near 0 or 1
+		void GetWilsonInterval(size_t successes, size_t trials, double& low, double& high)
+		{
+			low = high = 0.0;
+			if (trials == 0)
+				return;
+
+			const double z = 1.96;
+			const double n = static_cast<double>(trials);
+			const double p = successes / n;
+			const double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+			const double margin = z * std::sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+			low = std::max(0.0, center - margin);
+			high = std::min(1.0, center + margin);
+		}
+
+		void WriteSummaryJson(std::ostream& stream, const char* name, const DistributionSummary& summary)
+		{
+			stream << "  \"" << name << "\": { \"count\": " << summary.count << ", \"mean\": " << summary.mean
+				<< ", \"stddev\": " << summary.standardDeviation << ", \"min\": " << summary.min << ", \"p10\": " << summary.p10
+				<< ", \"median\": " << summary.median << ", \"p90\": " << summary.p90 << ", \"max\": " << summary.max << " },\n";
+		}
+
+		void WriteSummaryCsv(std::ostream& stream, const char* name, const DistributionSummary& summary)
+		{
+			stream << name << ".count," << summary.count << "\n";
+			stream << name << ".mean," << summary.mean << "\n";
+			stream << name << ".stddev," << summary.standardDeviation << "\n";
+			stream << name << ".min," << summary.min << "\n";
+			stream << name << ".p10," << summary.p10 << "\n";
+			stream << name << ".median," << summary.median << "\n";
+			stream << name << ".p90," << summary.p90 << "\n";
+			stream << name << ".max," << summary.max << "\n";
+		}
+
+		template<size_t Size>
+		void WriteHistogramJson(std::ostream& stream, const char* name, const std::array<size_t, Size>& histogram)
+		{
+			stream << "  \"" << name << "\": [";
+			for (size_t bin = 0; bin < Size; ++bin)
+			{
+				stream << (bin ? ", " : "") << histogram[bin];
+			}
+			stream << "],\n";
+		}
+	}
+
+	DifficultyReport BuildDifficultyReport(const SimBatchRunner& runner, const SimBatchStats& stats, float timeDelta)
+	{
+		DifficultyReport report;
+		report.sessions = runner.getSessionCount();
+		report.cleared = stats.sessionsWon;
+		report.lost = stats.sessionsLost;
+		report.timedOut = report.sessions - report.cleared - report.lost;
+		report.clearRate = report.sessions ? static_cast<double>(report.cleared) / report.sessions : 0.0;
+		GetWilsonInterval(report.cleared, report.sessions, report.clearRateLow, report.clearRateHigh);
+		report.seconds = stats.seconds;
+		report.ticksPerSecond = stats.ticksPerSecond;
+
+		std::vector<double> clearedFractions;
+		std::vector<double> clearTimes;
+		std::vector<double> livesLost;
+		std::vector<double> dropped;
+		std::vector<double> collected;
+		clearedFractions.reserve(report.sessions);
+		livesLost.reserve(report.sessions);
+		dropped.reserve(report.sessions);
+		collected.reserve(report.sessions);
+		for (size_t i = 0; i < report.sessions; ++i)
+		{
+			const ArkanoidSim& sim = runner.getSession(i);
+			const SimSessionCounters& counters = runner.getSessionCounters(i);
+			const size_t bricks = sim.getBricks().size();
+			report.bricks = std::max(report.bricks, bricks);
+
+			const double fraction = bricks ? static_cast<double>(bricks - sim.getBricks().getAliveCount()) / bricks : 1.0;
+			clearedFractions.push_back(fraction);
+			++report.clearedHistogram[std::min(DifficultyReport::CLEARED_BINS - 1, static_cast<size_t>(fraction * DifficultyReport::CLEARED_BINS))];
+
+			if (sim.getStatus() == SimStatus::Won)
+			{
+				clearTimes.push_back(runner.getSessionTicks(i) * static_cast<double>(timeDelta));
+			}
+
+			livesLost.push_back(counters.livesLost);
+			++report.livesLostHistogram[std::min<size_t>(DifficultyReport::LIVES_BINS - 1, counters.livesLost)];
+
+			dropped.push_back(counters.bonusesDropped);
+			collected.push_back(counters.bonusesCollected);
+			for (size_t type = 0; type < BONUS_EFFECT_TYPE_COUNT; ++type)
+			{
+				report.droppedByType[type] += counters.droppedByType[type];
+				report.collectedByType[type] += counters.collectedByType[type];
+			}
+		}
+
+		report.clearedFraction = Summarize(clearedFractions);
+		report.timeToClear = Summarize(clearTimes);
+		report.livesLost = Summarize(livesLost);
+		report.bonusesDropped = Summarize(dropped);
+		report.bonusesCollected = Summarize(collected);
+		return report;
+	}
+
+	void WriteDifficultyJson(std::ostream& stream, const DifficultyReport& report)
+	{
+		stream << "{\n";
+		stream << "  \"level\": \"" << report.level << "\",\n";
+		stream << "  \"bot\": \"" << report.bot << "\",\n";
+		stream << "  \"bricks\": " << report.bricks << ",\n";
+		stream << "  \"sessions\": " << report.sessions << ",\n";
+		stream << "  \"cleared\": " << report.cleared << ",\n";
+		stream << "  \"lost\": " << report.lost << ",\n";
+		stream << "  \"timedOut\": " << report.timedOut << ",\n";
+		stream << "  \"clearRate\": " << report.clearRate << ",\n";
+		stream << "  \"clearRate95\": [" << report.clearRateLow << ", " << report.clearRateHigh << "],\n";
+		WriteSummaryJson(stream, "clearedFraction", report.clearedFraction);
+		WriteHistogramJson(stream, "clearedFractionHistogram", report.clearedHistogram);
+		WriteSummaryJson(stream, "timeToClearSeconds", report.timeToClear);
+		WriteSummaryJson(stream, "livesLost", report.livesLost);
+		WriteHistogramJson(stream, "livesLostHistogram", report.livesLostHistogram);
+		WriteSummaryJson(stream, "bonusesDropped", report.bonusesDropped);
+		WriteSummaryJson(stream, "bonusesCollected", report.bonusesCollected);
+
+		stream << "  \"bonusTypes\": [\n";
+		for (size_t type = 0; type < BONUS_EFFECT_TYPE_COUNT; ++type)
+		{
+			stream << "    { \"name\": \"" << GetBonusEffectName(static_cast<BonusEffectType>(type)) << "\", \"dropped\": " << report.droppedByType[type]
+				<< ", \"collected\": " << report.collectedByType[type] << " }" << (type + 1 < BONUS_EFFECT_TYPE_COUNT ? "," : "") << "\n";
+		}
+		stream << "  ],\n";
+
+		stream << "  \"runSeconds\": " << report.seconds << ",\n";
+		stream << "  \"ticksPerSecond\": " << report.ticksPerSecond << "\n";
+		stream << "}\n";
+	}
+
+	void WriteDifficultyCsv(std::ostream& stream, const DifficultyReport& report)
+	{
+		stream << "metric,value\n";
+		stream << "level," << report.level << "\n";
+		stream << "bot," << report.bot << "\n";
+		stream << "bricks," << report.bricks << "\n";
+		stream << "sessions," << report.sessions << "\n";
+		stream << "cleared," << report.cleared << "\n";
+		stream << "lost," << report.lost << "\n";
+		stream << "timedOut," << report.timedOut << "\n";
+		stream << "clearRate," << report.clearRate << "\n";
+		stream << "clearRate95.low," << report.clearRateLow << "\n";
+		stream << "clearRate95.high," << report.clearRateHigh << "\n";
+		WriteSummaryCsv(stream, "clearedFraction", report.clearedFraction);
+		for (size_t bin = 0; bin < DifficultyReport::CLEARED_BINS; ++bin)
+		{
+			stream << "clearedFractionHistogram." << bin << "," << report.clearedHistogram[bin] << "\n";
+		}
+		WriteSummaryCsv(stream, "timeToClearSeconds", report.timeToClear);
+		WriteSummaryCsv(stream, "livesLost", report.livesLost);
+		for (size_t bin = 0; bin < DifficultyReport::LIVES_BINS; ++bin)
+		{
+			stream << "livesLostHistogram." << bin << "," << report.livesLostHistogram[bin] << "\n";
+		}
+		WriteSummaryCsv(stream, "bonusesDropped", report.bonusesDropped);
+		WriteSummaryCsv(stream, "bonusesCollected", report.bonusesCollected);
+		for (size_t type = 0; type < BONUS_EFFECT_TYPE_COUNT; ++type)
+		{
+			const char* name = GetBonusEffectName(static_cast<BonusEffectType>(type));
+			stream << "bonusTypes." << name << ".dropped," << report.droppedByType[type] << "\n";
+			stream << "bonusTypes." << name << ".collected," << report.collectedByType[type] << "\n";
+		}
+		stream << "runSeconds," << report.seconds << "\n";
+		stream << "ticksPerSecond," << report.ticksPerSecond << "\n";
+	}
+}
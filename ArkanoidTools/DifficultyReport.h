@@ -0,0 +1,68 @@
+#pragma once
+#include "BonusEffectTypes.h"
+#include "SimBatchRunner.h"
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ArkanoidGame
+{
+	// Mean, spread and percentiles of one per-session value
+	struct DistributionSummary
+	{
+		size_t count = 0;
+		double mean = 0.0;
+		double standardDeviation = 0.0;
+		double min = 0.0;
+		double p10 = 0.0;
+		double median = 0.0;
+		double p90 = 0.0;
+		double max = 0.0;
+	};
+
+	/**
+	 * @brief Difficulty of one level, estimated from a batch of bot playthroughs
+	 * 
+	 * Built from the final state of every SimBatchRunner session. Sessions that
+	 * reach the tick limit count as neither cleared nor lost.
+	 */
+	struct DifficultyReport
+	{
+		static const size_t CLEARED_BINS = 10;
+		static const size_t LIVES_BINS = 8; // The last bin also holds sessions that lost more lives
+
+		std::string level;
+		std::string bot;
+		size_t sessions = 0;
+		size_t cleared = 0;
+		size_t lost = 0;
+		size_t timedOut = 0;
+		double clearRate = 0.0;
+		double clearRateLow = 0.0;  // 95% Wilson interval
+		double clearRateHigh = 0.0;
+		size_t bricks = 0;          // Bricks of the layout
+
+		DistributionSummary clearedFraction; // Share of bricks destroyed, every session
+		std::array<size_t, CLEARED_BINS> clearedHistogram = {};
+		DistributionSummary timeToClear;     // Game seconds, cleared sessions only
+		DistributionSummary livesLost;
+		std::array<size_t, LIVES_BINS> livesLostHistogram = {};
+		DistributionSummary bonusesDropped;
+		DistributionSummary bonusesCollected;
+		std::array<uint64_t, BONUS_EFFECT_TYPE_COUNT> droppedByType = {};
+		std::array<uint64_t, BONUS_EFFECT_TYPE_COUNT> collectedByType = {};
+
+		double seconds = 0.0;       // Wall-clock time of the batch
+		double ticksPerSecond = 0.0;
+	};
+
+	// Summarize the sessions of a finished run; timeDelta converts ticks to game seconds
+	DifficultyReport BuildDifficultyReport(const SimBatchRunner& runner, const SimBatchStats& stats, float timeDelta);
+
+	// One JSON object with the summary and histograms
+	void WriteDifficultyJson(std::ostream& stream, const DifficultyReport& report);
+
+	// "metric,value" rows with the same content, for spreadsheets and diffing two runs
+	void WriteDifficultyCsv(std::ostream& stream, const DifficultyReport& report);
+}
@@ -0,0 +1,144 @@
+#include "SimBatchRunner.h"
+#include <algorithm>
+#include <chrono>
+
+namespace ArkanoidGame
+{
+	SimInput FollowBallController(const ArkanoidSim& sim)
+	{
+		SimInput input;
+		const float ballX = sim.getBall().getPosition().x;
+		const float platformX = sim.getPlatform().getPosition().x;
+		const float deadZone = sim.getPlatform().getWidth() * 0.1f;
+
+		input.moveLeft = ballX < platformX - deadZone;
+		input.moveRight = ballX > platformX + deadZone;
+		input.launch = true;
+		return input;
+	}
+
+	void SimSessionCounters::countEvents(const SimEventQueue& events)
+	{
+		for (const SimEvent& event : events)
+		{
+			switch (event.type)
+			{
+			case SimEventType::BrickDestroyed:
+				++bricksDestroyed;
+				break;
+			case SimEventType::BonusDropped:
+				++bonusesDropped;
+				++droppedByType[event.index];
+				break;
+			case SimEventType::BonusCollected:
+				++bonusesCollected;
+				++collectedByType[event.index];
+				break;
+			case SimEventType::LifeLost:
+				++livesLost;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	SimBatchRunner::SimBatchRunner(ThreadPool& threadPool, size_t sessionCount, unsigned int baseSeed, SimController sessionController)
+		: pool(threadPool), controller(std::move(sessionController))
+	{
+		sessions.reserve(sessionCount);
+		for (size_t i = 0; i < sessionCount; ++i)
+		{
+			sessions.push_back(std::make_unique<ArkanoidSim>(baseSeed + static_cast<unsigned int>(i)));
+		}
+		sessionTicks.assign(sessionCount, 0);
+		sessionCounters.assign(sessionCount, SimSessionCounters());
+	}
+
+	void SimBatchRunner::reset(unsigned int baseSeed, const LevelView& level)
+	{
+		pool.parallelFor(sessions.size(), 64, [this, baseSeed, &level](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				sessions[i]->reset(baseSeed + static_cast<unsigned int>(i), level);
+				sessionTicks[i] = 0;
+				sessionCounters[i] = SimSessionCounters();
+			}
+		});
+	}
+
+	void SimBatchRunner::tick(float timeDelta)
+	{
+		// Enough chunks for stealing to even out the load, few enough to keep overhead low
+		const size_t grainSize = std::max<size_t>(16, sessions.size() / (pool.getThreadCount() * 8));
+		pool.parallelFor(sessions.size(), grainSize, [this, timeDelta](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				ArkanoidSim& sim = *sessions[i];
+				if (sim.getStatus() == SimStatus::Running)
+				{
+					sim.step(controller(sim), timeDelta);
+					sessionCounters[i].countEvents(sim.getEvents());
+					++sessionTicks[i];
+				}
+			}
+		});
+	}
+
+	SimBatchStats SimBatchRunner::run(uint32_t maxTicks, float timeDelta)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		const size_t grainSize = std::max<size_t>(1, sessions.size() / (pool.getThreadCount() * 8));
+		pool.parallelFor(sessions.size(), grainSize, [this, maxTicks, timeDelta](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				ArkanoidSim& sim = *sessions[i];
+				uint32_t ticks = sessionTicks[i];
+				SimSessionCounters counters = sessionCounters[i];
+				while (sim.getStatus() == SimStatus::Running && ticks < maxTicks)
+				{
+					sim.step(controller(sim), timeDelta);
+					counters.countEvents(sim.getEvents());
+					++ticks;
+				}
+				sessionTicks[i] = ticks;
+				sessionCounters[i] = counters;
+			}
+		});
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		return collectStats(seconds);
+	}
+
+	SimBatchStats SimBatchRunner::collectStats(double seconds) const
+	{
+		SimBatchStats stats;
+		stats.sessions = sessions.size();
+		stats.seconds = seconds;
+		for (size_t i = 0; i < sessions.size(); ++i)
+		{
+			stats.ticks += sessionTicks[i];
+			stats.bricksDestroyed += sessionCounters[i].bricksDestroyed;
+			stats.bricksLeft += sessions[i]->getBricks().getAliveCount();
+			stats.bonusesDropped += sessionCounters[i].bonusesDropped;
+			stats.bonusesCollected += sessionCounters[i].bonusesCollected;
+			stats.livesLost += sessionCounters[i].livesLost;
+			if (sessions[i]->getStatus() == SimStatus::Won)
+			{
+				++stats.sessionsWon;
+			}
+			else if (sessions[i]->getStatus() == SimStatus::Lost)
+			{
+				++stats.sessionsLost;
+			}
+		}
+
+		if (seconds > 0.0)
+		{
+			stats.sessionsPerSecond = static_cast<double>(stats.sessions) / seconds;
+			stats.ticksPerSecond = static_cast<double>(stats.ticks) / seconds;
+		}
+		return stats;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "ArkanoidSim.h"
+#include "LevelPack.h"
+#include "ThreadPool.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	// Decides the input of one session for its next tick
+	using SimController = std::function<SimInput(const ArkanoidSim& sim)>;
+
+	// Simple controller that keeps the platform under the ball and launches at once
+	SimInput FollowBallController(const ArkanoidSim& sim);
+
+	/**
+	 * @brief Aggregate results of a batch run
+	 */
+	struct SimBatchStats
+	{
+		size_t sessions = 0;
+		size_t sessionsWon = 0;
+		size_t sessionsLost = 0;
+		uint64_t ticks = 0;           // Sum of ticks over all sessions
+		uint64_t bricksDestroyed = 0;
+		uint64_t bricksLeft = 0;      // Still alive when the sessions stopped
+		uint64_t bonusesDropped = 0;
+		uint64_t bonusesCollected = 0;
+		uint64_t livesLost = 0;
+		double seconds = 0.0;         // Wall-clock time of the run
+		double sessionsPerSecond = 0.0;
+		double ticksPerSecond = 0.0;
+	};
+
+	// Totals of one session, counted from its events after every step
+	struct SimSessionCounters
+	{
+		uint32_t bricksDestroyed = 0;
+		uint32_t bonusesDropped = 0;
+		uint32_t bonusesCollected = 0;
+		uint32_t livesLost = 0;
+		std::array<uint16_t, BONUS_EFFECT_TYPE_COUNT> droppedByType = {};
+		std::array<uint16_t, BONUS_EFFECT_TYPE_COUNT> collectedByType = {};
+
+		void countEvents(const SimEventQueue& events);
+	};
+
+	/**
+	 * @brief Runs many independent ArkanoidSim sessions on a ThreadPool
+	 * 
+	 * Session i is seeded with baseSeed + i, so a batch is reproducible no matter
+	 * how the sessions get scheduled across threads.
+	 */
+	class SimBatchRunner
+	{
+	private:
+		ThreadPool& pool;
+		SimController controller;
+		std::vector<std::unique_ptr<ArkanoidSim>> sessions;
+		std::vector<uint32_t> sessionTicks;
+		std::vector<SimSessionCounters> sessionCounters;
+
+	public:
+		SimBatchRunner(ThreadPool& threadPool, size_t sessionCount, unsigned int baseSeed, SimController sessionController = FollowBallController);
+
+		// Restart every session with seeds baseSeed + i, on level or on the layout generated from each seed
+		void reset(unsigned int baseSeed, const LevelView& level = LevelView());
+
+		// Advance all running sessions by one tick in lockstep
+		void tick(float timeDelta);
+
+		/**
+		 * @brief Runs every session until it ends or reaches maxTicks
+		 * 
+		 * Sessions are handed out in chunks and run to completion without a
+		 * per-tick barrier; idle workers steal the remaining chunks.
+		 */
+		SimBatchStats run(uint32_t maxTicks, float timeDelta);
+
+		size_t getSessionCount() const { return sessions.size(); }
+		const ArkanoidSim& getSession(size_t index) const { return *sessions[index]; }
+		uint32_t getSessionTicks(size_t index) const { return sessionTicks[index]; }
+		const SimSessionCounters& getSessionCounters(size_t index) const { return sessionCounters[index]; }
+
+	private:
+		SimBatchStats collectStats(double seconds) const;
+	};
+}
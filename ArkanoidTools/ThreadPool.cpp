@@ -0,0 +1,154 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace ArkanoidGame
+{
+	namespace
+	{
+		// Index of the pool worker running on this thread, or SIZE_MAX for outside threads
+		thread_local size_t currentWorkerIndex = SIZE_MAX;
+		thread_local const void* currentWorkerPool = nullptr;
+	}
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		queues.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			queues.push_back(std::make_unique<WorkerQueue>());
+		}
+
+		workers.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			workers.emplace_back(&ThreadPool::workerLoop, this, i);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			isStopping = true;
+		}
+		wakeUp.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::submit(Task task)
+	{
+		// Workers push to their own deque so freshly spawned work stays cache-warm
+		size_t index = (currentWorkerPool == this) ? currentWorkerIndex : nextQueue++ % queues.size();
+		{
+			// Count first so the counter never drops below the number of queued tasks
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			++pendingTasks;
+		}
+		{
+			std::lock_guard<std::mutex> lock(queues[index]->mutex);
+			queues[index]->tasks.push_back(std::move(task));
+		}
+		wakeUp.notify_one();
+	}
+
+	void ThreadPool::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+	{
+		if (count == 0)
+			return;
+
+		grainSize = std::max<size_t>(1, grainSize);
+		const size_t chunkCount = (count + grainSize - 1) / grainSize;
+		if (chunkCount == 1)
+		{
+			body(0, count);
+			return;
+		}
+
+		std::atomic<size_t> remainingChunks{ chunkCount };
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			const size_t begin = chunk * grainSize;
+			const size_t end = std::min(count, begin + grainSize);
+			submit([&body, &remainingChunks, begin, end]() {
+				body(begin, end);
+				remainingChunks.fetch_sub(1, std::memory_order_release);
+			});
+		}
+
+		// Help instead of blocking; any task is fine, ours are somewhere in the deques
+		const size_t helperIndex = (currentWorkerPool == this) ? currentWorkerIndex : 0;
+		while (remainingChunks.load(std::memory_order_acquire) > 0)
+		{
+			if (!tryRunOne(helperIndex))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool ThreadPool::popLocal(size_t index, Task& task)
+	{
+		WorkerQueue& queue = *queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty())
+			return false;
+
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+		return true;
+	}
+
+	bool ThreadPool::steal(size_t thiefIndex, Task& task)
+	{
+		const size_t queueCount = queues.size();
+		for (size_t offset = 1; offset <= queueCount; ++offset)
+		{
+			WorkerQueue& victim = *queues[(thiefIndex + offset) % queueCount];
+			std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+			if (!lock.owns_lock() || victim.tasks.empty())
+				continue;
+
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			return true;
+		}
+		return false;
+	}
+
+	bool ThreadPool::tryRunOne(size_t index)
+	{
+		Task task;
+		if (!popLocal(index, task) && !steal(index, task))
+			return false;
+
+		--pendingTasks;
+		task();
+		return true;
+	}
+
+	void ThreadPool::workerLoop(size_t index)
+	{
+		currentWorkerIndex = index;
+		currentWorkerPool = this;
+
+		while (true)
+		{
+			if (tryRunOne(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wakeUp.wait(lock, [this]() { return isStopping || pendingTasks > 0; });
+			if (isStopping && pendingTasks == 0)
+				return;
+		}
+	}
+}
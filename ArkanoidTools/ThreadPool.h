@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	/**
+	 * @brief Work-stealing thread pool
+	 * 
+	 * Every worker owns a task deque. A worker pops its own newest task first
+	 * and, when its deque is empty, steals the oldest task of another worker.
+	 * Uneven tasks (sessions that end early, levels of different size) are
+	 * balanced without a central queue becoming the bottleneck.
+	 */
+	class ThreadPool
+	{
+	public:
+		using Task = std::function<void()>;
+
+		// threadCount == 0 uses one worker per hardware thread
+		explicit ThreadPool(size_t threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		size_t getThreadCount() const { return workers.size(); }
+
+		// Queue a task; it runs on any worker
+		void submit(Task task);
+
+		/**
+		 * @brief Runs body(begin, end) over [0, count) split into chunks of grainSize
+		 * 
+		 * The calling thread helps with the work and returns when every chunk is done.
+		 */
+		void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+	private:
+		struct WorkerQueue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		bool popLocal(size_t index, Task& task);
+		bool steal(size_t thiefIndex, Task& task);
+		bool tryRunOne(size_t index);
+		void workerLoop(size_t index);
+
+		std::vector<std::unique_ptr<WorkerQueue>> queues;
+		std::vector<std::thread> workers;
+		std::atomic<size_t> nextQueue{ 0 };
+		std::atomic<size_t> pendingTasks{ 0 };
+		std::atomic<bool> isStopping{ false };
+		std::mutex sleepMutex;
+		std::condition_variable wakeUp;
+	};
+}